@@ -16,6 +16,7 @@ class ScriptError(Exception):
 class MetaData:
 
     RE_TAGS = re.compile(R"([A-Z_]{4,16})\(([^)]*)\)\s*", re.DOTALL)
+    RE_MEMORY_SIZE = re.compile(R"(\d+)([kKMGT]?)B?")
 
     def __init__(self, name: str, text: str, file: Path):
         self.name: str = name
@@ -23,11 +24,25 @@ class MetaData:
         for match in self.RE_TAGS.finditer(text):
             value_name = match.group(1)
             values = list(match.group(2).split())
-            if value_name not in ["TAGS", "TESTED_TARGETS", "SKIP_BY_DEFAULT"]:
+            if value_name not in ["TAGS", "TESTED_TARGETS", "SKIP_BY_DEFAULT", "SHARED_FIXTURES", "MEMORY_LIMIT", "STACK_SIZE"]:
                 raise ScriptError(f'Unknown meta info marker "{value_name}" in file: {file}')
             if value_name in self.values:
                 raise ScriptError(f'Duplicated meta info marker "{value_name}" in file: {file}')
             self.values[value_name] = values
+        self.memory_limit: int = 0
+        if "MEMORY_LIMIT" in self.values:
+            self.memory_limit = self._parse_memory_size(self.values["MEMORY_LIMIT"], "MEMORY_LIMIT", file)
+        self.stack_size: int = 0
+        if "STACK_SIZE" in self.values:
+            self.stack_size = self._parse_memory_size(self.values["STACK_SIZE"], "STACK_SIZE", file)
+
+    @classmethod
+    def _parse_memory_size(cls, values: list[str], marker: str, file: Path) -> int:
+        match = cls.RE_MEMORY_SIZE.fullmatch("".join(values))
+        if not match or int(match.group(1)) == 0:
+            raise ScriptError(f'Invalid size "{" ".join(values)}" for {marker} in file: {file}')
+        exponent = " KMGT".index(match.group(2).upper() or " ")
+        return int(match.group(1)) * (1000**exponent)
 
     def build_code(self, indent: int) -> str:
         text = f"MetaData{{\n"
@@ -49,10 +64,27 @@ class MetaData:
             flags.append("MetaData::SkipByDefault")
         if self.name.startswith("print"):
             flags.append("MetaData::PrintMethod")
+        if self.name.startswith("fuzz"):
+            flags.append("MetaData::FuzzMethod")
         if flags:
             text += "|".join(flags)
         else:
             text += "0"
+        if "SHARED_FIXTURES" in self.values or self.memory_limit or self.stack_size:
+            text += ",\n"
+            text += " " * (indent + 4)
+            text += "{"
+            if "SHARED_FIXTURES" in self.values:
+                text += ",".join([f'"{v}"' for v in self.values["SHARED_FIXTURES"]])
+            text += "}"
+        if self.memory_limit or self.stack_size:
+            text += ",\n"
+            text += " " * (indent + 4)
+            text += f"{self.memory_limit}ULL"
+        if self.stack_size:
+            text += ",\n"
+            text += " " * (indent + 4)
+            text += f"{self.stack_size}ULL"
         text += "\n"
         text += " " * indent
         text += "}"
@@ -73,10 +105,11 @@ class TestMethod:
 
 class TestClass:
 
-    def __init__(self, file: Path, meta_data: MetaData, methods: list[TestMethod]):
+    def __init__(self, file: Path, meta_data: MetaData, methods: list[TestMethod], fuzz_methods: list[TestMethod]):
         self.file: Path = file
         self.meta_data: MetaData = meta_data
         self.methods: list[TestMethod] = methods
+        self.fuzz_methods: list[TestMethod] = fuzz_methods
 
     def build_code(self) -> str:
         text = f"Registration<{self.meta_data.name}> "
@@ -85,6 +118,11 @@ class TestClass:
         text += "    {\n"
         for method in self.methods:
             text += method.build_code(self.meta_data.name)
+        if self.fuzz_methods:
+            text += "    },\n"
+            text += "    {\n"
+            for method in self.fuzz_methods:
+                text += method.build_code(self.meta_data.name)
         text += "    }\n"
         text += "};\n\n"
         return text
@@ -122,6 +160,25 @@ class WorkingSet:
         """,
         re.DOTALL,
     )
+    RE_FUZZ_METHOD = re.compile(
+        R"""(?x)
+        (   # Capture one or more tags for the fuzz method.
+            (?: [A-Z_]{4,20} \( [^)]* \) \s* )+
+        )?
+        void \s+
+        (   # Accept fuzz methods starting with `fuzz`.
+            fuzz \w+
+        ) \s* \( ( [^)]* ) \)
+        """,
+        re.DOTALL,
+    )
+    RE_FUZZ_PARAMETER = re.compile(
+        R"""(?x)
+        ^ \s* (?: const \s+ )? (?: std \s* :: \s* )? span \s* < \s* const \s+ (?: std \s* :: \s* )? byte \s* >
+        \s* (?: & \s* )? \w* \s* $
+        """,
+        re.DOTALL,
+    )
 
     def __init__(self):
         self.log: Optional[logging.Logger] = None
@@ -221,7 +278,16 @@ class WorkingSet:
             for method_match in self.RE_TEST_METHOD.finditer(text):
                 method_meta_data = MetaData(str(method_match.group(2)), str(method_match.group(1)), file)
                 methods.append(TestMethod(method_meta_data))
-            self.test_classes.append(TestClass(file, test_class_meta_data, methods))
+            fuzz_methods = []
+            for method_match in self.RE_FUZZ_METHOD.finditer(text):
+                if not self.RE_FUZZ_PARAMETER.match(method_match.group(3)):
+                    raise ScriptError(
+                        f'Fuzz method "{method_match.group(2)}" must have a single '
+                        f'"std::span<const std::byte>" parameter in file: {file}'
+                    )
+                method_meta_data = MetaData(str(method_match.group(2)), str(method_match.group(1)), file)
+                fuzz_methods.append(TestMethod(method_meta_data))
+            self.test_classes.append(TestClass(file, test_class_meta_data, methods, fuzz_methods))
 
     def write_metadata(self):
         text = f"// Generated metadata\n"
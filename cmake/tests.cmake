@@ -9,6 +9,41 @@ if(ERBSLAND_UNITTEST_ENABLE_TESTS)
 
     # Enable the example unit tests.
     enable_testing()
+    # Tests that count allocations require the allocation hook.
+    if(ERBSLAND_UNITTEST_ALLOCATION_HOOK)
+        add_test(
+                NAME unittest-allocation-faults
+                COMMAND $<TARGET_FILE:unittest-allocation-faults> --alloc-faults
+        )
+        add_test(
+                NAME unittest-allocation-faults-failures
+                COMMAND $<TARGET_FILE:unittest-allocation-faults> --alloc-faults --no-color name:AllocationFaultFailureTest
+        )
+        set_tests_properties(unittest-allocation-faults-failures PROPERTIES
+                PASS_REGULAR_EXPRESSION "Allocation Faults: Leak FAILED!.*did not release.*Allocation Faults: Crash FAILED!.*terminated by signal.*Allocation Faults: Invariant FAILED!.*An assertion failed.*--alloc-fault 1 name:Invariant"
+        )
+        add_test(
+                NAME unittest-allocation-faults-replay
+                COMMAND $<TARGET_FILE:unittest-allocation-faults> --alloc-fault 2 --no-color name:Invariant
+        )
+        set_tests_properties(unittest-allocation-faults-replay PROPERTIES
+                PASS_REGULAR_EXPRESSION "Test: Invariant FAILED!.*Allocation 2 of the test failed."
+        )
+    endif()
+    add_test(
+            NAME unittest-assert-stats
+            COMMAND $<TARGET_FILE:unittest-assert-stats> --assert-stats --no-color
+    )
+    set_tests_properties(unittest-assert-stats PROPERTIES
+            PASS_REGULAR_EXPRESSION "Assertions with the most time \\(10003 executions of 4 assertions took [0-9.]+ m?s, [0-9.]+% of the run\\):\n  [0-9.]+ m?s in 10000 executions \\([0-9]+ ns each\\): REQUIRE_EQUAL at [^\n]*AssertStatsTest.cpp:16"
+    )
+    add_test(
+            NAME unittest-assert-stats-isolated
+            COMMAND $<TARGET_FILE:unittest-assert-stats> --assert-stats --isolate --no-color
+    )
+    set_tests_properties(unittest-assert-stats-isolated PROPERTIES
+            PASS_REGULAR_EXPRESSION "Assertions with the most time \\(10003 executions of 4 assertions"
+    )
     add_test(
             NAME unittest-basic
             COMMAND $<TARGET_FILE:unittest-basic>
@@ -16,13 +51,244 @@ if(ERBSLAND_UNITTEST_ENABLE_TESTS)
     set_tests_properties(unittest-basic PROPERTIES
             WILL_FAIL TRUE
     )
+    add_test(
+            NAME unittest-basic-approx-comparison
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:ApproxComparisonTest
+    )
+    add_test(
+            NAME unittest-basic-approx-comparison-failures
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:ApproxFailureTest
+    )
+    set_tests_properties(unittest-basic-approx-comparison-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "Approximate comparison failed: 1.5 != 1 \\(error 0.5, 2251799813685248 ULPs\\)\n  Tolerance: relative 1e-06, 4 ULPs\n.*Ranges differ: 3 of 100 compared elements are outside the tolerance.\n  Tolerance: 4 ULPs\n  First at index 20: 1.5 != 1\n  Worst at index 30: nan != 1 \\(NaN or infinite value\\)\n  Error histogram:\n +0 ULPs: 96\n +1 ULP: 1\n +257-65536 ULPs: 1\n +>65536 ULPs: 1\n +NaN/infinite: 1"
+    )
+    add_test(
+            NAME unittest-basic-container-diff
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:ContainerDiffTest
+    )
+    add_test(
+            NAME unittest-basic-container-diff-failures
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:ContainerFailureTest
+    )
+    set_tests_properties(unittest-basic-container-diff-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "Containers differ: 1 element only in A, 1 element only in B.\n  - A\\[500\\]: 500\n  \\+ B\\[700\\]: -1\n.*Maps differ: 1 key only in A, 1 key only in B, 1 key with different values.\n  - A\\[bob\\]: 5\n  \\+ B\\[carol\\]: 5\n  ~ \\[alice\\]: 3 != 4"
+    )
+    add_test(
+            NAME unittest-basic-range-comparison
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:RangeComparisonTest
+    )
+    add_test(
+            NAME unittest-basic-range-comparison-failures
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:RangeFailureTest
+    )
+    set_tests_properties(unittest-basic-range-comparison-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "Ranges differ: 2 of 1000 compared elements differ, the first at index 500.\n  \\[497\\] 497 == 497\n.*> \\[500\\] 500 != -1\n.*Ranges differ in size: A has 2 elements, B has 3 elements.\n.*> \\[2\\] <none> != gamma"
+    )
+    add_test(
+            NAME unittest-basic-skipped-class
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color -name:Basic -name:Context -name:Priority
+    )
+    set_tests_properties(unittest-basic-skipped-class PROPERTIES
+            FAIL_REGULAR_EXPRESSION "SkippedClass"
+    )
+    add_test(
+            NAME unittest-basic-string-diff
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:StringDiffTest
+    )
+    add_test(
+            NAME unittest-basic-string-diff-failures
+            COMMAND $<TARGET_FILE:unittest-basic> --no-color name:StringFailureTest
+    )
+    set_tests_properties(unittest-basic-string-diff-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "Strings differ after 4260 equal characters \\(4260 bytes\\): A has 8605 bytes, B has 8605 bytes.\n  A: actual\n     \\.\\.\\..*\"id\\\\\": 150, .*\n  B: expected\n     \\.\\.\\..*\"id\\\\\": 151, .*\n +\\^"
+    )
+    add_test(
+            NAME unittest-death-tests
+            COMMAND $<TARGET_FILE:unittest-death-tests>
+    )
+    add_test(
+            NAME unittest-death-tests-failures
+            COMMAND $<TARGET_FILE:unittest-death-tests> --no-color name:DeathFailureTest
+    )
+    set_tests_properties(unittest-death-tests-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "returned without terminating.*exit with code 2.*matches the pattern.*threw an exception.*exited with code 0"
+    )
     add_test(
             NAME unittest-file-helper
             COMMAND $<TARGET_FILE:unittest-file-helper>
     )
+    add_test(
+            NAME unittest-file-helper-failures
+            COMMAND $<TARGET_FILE:unittest-file-helper> --no-color name:DataFileFailureTest
+    )
+    set_tests_properties(unittest-file-helper-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "Text differs from the data file at line 4, column 8 \\(byte 48\\): [^\n]*expected-output.txt\n    1;\\\\u\\{00C4\\}rger;42\n  - 2;Euro \\\\u\\{20AC\\};17\n  \\+ 2;Euro \\$;17\n           \\^.*Text ends before the data file at line 3, column 1 \\(byte 29\\)"
+    )
+    add_test(
+            NAME unittest-fuzzing
+            COMMAND $<TARGET_FILE:unittest-fuzzing>
+    )
+    add_test(
+            NAME unittest-fuzzing-run
+            COMMAND $<TARGET_FILE:unittest-fuzzing> --fuzz ParseList --time 2s
+                    --corpus $<TARGET_FILE_DIR:unittest-fuzzing>/fuzz-corpus
+    )
+    add_test(
+            NAME unittest-fuzzing-crash
+            COMMAND $<TARGET_FILE:unittest-fuzzing> --no-color --supervise --fuzz Abort --time 2s
+                    --corpus $<TARGET_FILE_DIR:unittest-fuzzing>/fuzz-crash-corpus
+    )
+    set_tests_properties(unittest-fuzzing-crash PROPERTIES
+            PASS_REGULAR_EXPRESSION "Crash input saved to.*CRASH: Signal [0-9]+ \\(SIGABRT\\).*Suite: FuzzCrash"
+    )
+    add_test(
+            NAME unittest-isolation
+            COMMAND $<TARGET_FILE:unittest-isolation> --isolate
+    )
+    add_test(
+            NAME unittest-isolation-crash
+            COMMAND $<TARGET_FILE:unittest-isolation> --isolate --no-color +name:IsolationCrashTest
+    )
+    set_tests_properties(unittest-isolation-crash PROPERTIES
+            PASS_REGULAR_EXPRESSION "Test: AfterAbort OK!"
+    )
+    add_test(
+            NAME unittest-isolation-supervised
+            COMMAND $<TARGET_FILE:unittest-isolation> --supervise --no-color name:SupervisionCrashTest
+    )
+    set_tests_properties(unittest-isolation-supervised PROPERTIES
+            PASS_REGULAR_EXPRESSION "Test: Crash CRASHED!.*Suite: SupervisionCrash Resumed.*Test: AfterCrash OK!"
+    )
+    add_test(
+            NAME unittest-leak-checks
+            COMMAND $<TARGET_FILE:unittest-leak-checks> --strict-leaks
+    )
+    if(ERBSLAND_UNITTEST_ALLOCATION_HOOK)
+        add_test(
+                NAME unittest-leak-checks-warnings
+                COMMAND $<TARGET_FILE:unittest-leak-checks> --no-color name:LeakCheckFailureTest
+        )
+        set_tests_properties(unittest-leak-checks-warnings PROPERTIES
+                PASS_REGULAR_EXPRESSION "LeakedMemory LEAKED!.*did not release.*LeakedFile LEAKED!.*did not close 1 file descriptor: [0-9]+ \\(.*LeakedThread LEAKED!.*left 1 thread running.*SUCCESS"
+        )
+        add_test(
+                NAME unittest-leak-checks-strict
+                COMMAND $<TARGET_FILE:unittest-leak-checks> --no-color --strict-leaks name:LeakCheckFailureTest
+        )
+        set_tests_properties(unittest-leak-checks-strict PROPERTIES
+                PASS_REGULAR_EXPRESSION "Error 1 - LeakCheckFailure / LeakedMemory LEAKED!.*3 errors"
+        )
+    endif()
+    add_test(
+            NAME unittest-memory-limit
+            COMMAND $<TARGET_FILE:unittest-memory-limit> --memory-limit 200M
+    )
+    if(ERBSLAND_UNITTEST_ALLOCATION_HOOK)
+        add_test(
+                NAME unittest-memory-limit-exceeded
+                COMMAND $<TARGET_FILE:unittest-memory-limit> --no-color name:MemoryLimitExceededTest
+        )
+        set_tests_properties(unittest-memory-limit-exceeded PROPERTIES
+                PASS_REGULAR_EXPRESSION "CatchBadAlloc MEMORY LIMIT EXCEEDED!.*Test: AfterLimit OK!"
+        )
+        add_test(
+                NAME unittest-memory-limit-isolated
+                COMMAND $<TARGET_FILE:unittest-memory-limit> --isolate --no-color name:MemoryLimitExceededTest
+        )
+        set_tests_properties(unittest-memory-limit-isolated PROPERTIES
+                PASS_REGULAR_EXPRESSION "CatchBadAlloc MEMORY LIMIT EXCEEDED!.*Test: AfterLimit OK!"
+        )
+    else()
+        add_test(
+                NAME unittest-memory-limit-not-enforced
+                COMMAND $<TARGET_FILE:unittest-memory-limit> --no-color
+        )
+        set_tests_properties(unittest-memory-limit-not-enforced PROPERTIES
+                PASS_REGULAR_EXPRESSION "Memory Limit: set for [1-9][0-9]* tests? with MEMORY_LIMIT\\(\\) \\(only enforced with --isolate\\)"
+        )
+    endif()
+    add_test(
+            NAME unittest-profiler
+            COMMAND $<TARGET_FILE:unittest-profiler> --no-color --profile ProfilerTest
+                    --profile-dir ${CMAKE_CURRENT_BINARY_DIR}/profiles
+    )
+    set_tests_properties(unittest-profiler PROPERTIES
+            PASS_REGULAR_EXPRESSION "Test: BurnCpu OK!\nProfile: [1-9][0-9]* samples written to [^\n]*Profiler.BurnCpu.folded"
+            FIXTURES_SETUP unittest-profile
+    )
+    add_test(
+            NAME unittest-profiler-folded-stacks
+            COMMAND ${CMAKE_COMMAND} -E cat ${CMAKE_CURRENT_BINARY_DIR}/profiles/Profiler.BurnCpu.folded
+    )
+    set_tests_properties(unittest-profiler-folded-stacks PROPERTIES
+            PASS_REGULAR_EXPRESSION "ProfilerTest::testBurnCpu\\(\\);burnCpu\\([^\n]*\\)[^\n]* [0-9]+\n"
+            FIXTURES_REQUIRED unittest-profile
+    )
+    add_test(
+            NAME unittest-random-generator
+            COMMAND $<TARGET_FILE:unittest-random-generator> --seed 0x2545f4914f6cdd1d
+    )
+    add_test(
+            NAME unittest-resource-usage
+            COMMAND $<TARGET_FILE:unittest-resource-usage> --verbose --no-color
+    )
+    set_tests_properties(unittest-resource-usage PROPERTIES
+            PASS_REGULAR_EXPRESSION "Test: Sleep OK!\nTest usage: [0-9.]+ ms wall, .* minor and [0-9]+ major page faults.*Tests waiting the longest \\(wall minus CPU time\\):\n  [0-9.]+ ms waiting: ResourceUsage / Sleep"
+    )
+    if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+        # Only Linux measures the usage of the test thread, without the threads started by the test.
+        add_test(
+                NAME unittest-resource-usage-thread
+                COMMAND $<TARGET_FILE:unittest-resource-usage> --verbose --no-color name:WorkerThread
+        )
+        set_tests_properties(unittest-resource-usage-thread PROPERTIES
+                PASS_REGULAR_EXPRESSION "Test: WorkerThread OK!\nTest usage: [0-9.]+ ms wall, 0\\.[0-9]+ ms user"
+        )
+    endif()
+    add_test(
+            NAME unittest-shared-fixtures
+            COMMAND $<TARGET_FILE:unittest-shared-fixtures>
+    )
+    add_test(
+            NAME unittest-stack-size
+            COMMAND $<TARGET_FILE:unittest-stack-size>
+    )
+    add_test(
+            NAME unittest-stack-size-verbose
+            COMMAND $<TARGET_FILE:unittest-stack-size> --verbose --no-color name:DeepRecursion
+    )
+    set_tests_properties(unittest-stack-size-verbose PROPERTIES
+            PASS_REGULAR_EXPRESSION "Test stack: used [0-9]+ of [0-9]+ bytes"
+    )
+    add_test(
+            NAME unittest-stack-size-failures
+            COMMAND $<TARGET_FILE:unittest-stack-size> --isolate --no-color name:StackSizeFailureTest
+    )
+    set_tests_properties(unittest-stack-size-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "bytes of its stack, but the maximum is 4000 bytes.*does not run on a dedicated stack.*CRASH: Signal [0-9]+ \\(SIG[A-Z]+\\) \\*\\*\\*\nSuite: StackSizeFailure\nTest: Overflow\n.*Test: Overflow CRASHED!.*stack size of [0-9]+ bytes.*Test: AfterOverflow OK!"
+    )
+    add_test(
+            NAME unittest-stack-size-option
+            COMMAND $<TARGET_FILE:unittest-text-helper> --stack-size 1M
+    )
+    add_test(
+            NAME unittest-suite-fixtures
+            COMMAND $<TARGET_FILE:unittest-suite-fixtures>
+    )
+    add_test(
+            NAME unittest-suite-fixtures-failures
+            COMMAND $<TARGET_FILE:unittest-suite-fixtures> --no-color name:SuiteFixtureFailureTest
+    )
+    set_tests_properties(unittest-suite-fixtures-failures PROPERTIES
+            PASS_REGULAR_EXPRESSION "Suite Fixture Duration: [0-9.e-]+ seconds.*ERROR SUMMARY"
+    )
     add_test(
             NAME unittest-text-helper
             COMMAND $<TARGET_FILE:unittest-text-helper>
     )
+    add_test(
+            NAME unittest-utf8-scan
+            COMMAND $<TARGET_FILE:unittest-utf8-scan>
+    )
 endif()
 
@@ -4,10 +4,22 @@
 cmake_minimum_required(VERSION 3.23)
 include_guard()
 
+# Instrument a target with coverage feedback for the fuzzer.
+# Use this for the tested library, the `FUZZ_COVERAGE` option of `erbsland_unittest` instruments the test code.
+function(erbsland_unittest_fuzz_coverage target)
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        target_compile_options(${target} PRIVATE "-fsanitize-coverage=trace-pc-guard")
+    elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        target_compile_options(${target} PRIVATE "-fsanitize-coverage=trace-pc")
+    else()
+        message(WARNING "Fuzz coverage is not supported by this compiler. Fuzzing runs without coverage feedback.")
+    endif()
+endfunction()
+
 # Add unittest metadata processing to the given target.
 function(erbsland_unittest)
     # Read the arguments.
-    set(options PRECOMPILE_HEADERS NO_LINK_SETTINGS ENABLE_WARNINGS ENABLE_DATA_DEPS)
+    set(options PRECOMPILE_HEADERS NO_LINK_SETTINGS ENABLE_WARNINGS ENABLE_DATA_DEPS FUZZ_COVERAGE ENABLE_PROFILING)
     set(oneValueArgs TARGET COPY_TEST_DATA)
     set(multiValueArgs "")
     cmake_parse_arguments(ARGS "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
@@ -49,6 +61,16 @@ function(erbsland_unittest)
         endif()
     endif()
 
+    if(ARGS_FUZZ_COVERAGE)
+        erbsland_unittest_fuzz_coverage(${ARGS_TARGET})
+    endif()
+
+    if(ARGS_ENABLE_PROFILING AND NOT MSVC)
+        # Export the function names for the profiler, and keep the frame pointers for reliable call stacks.
+        set_target_properties(${ARGS_TARGET} PROPERTIES ENABLE_EXPORTS ON)
+        target_compile_options(${ARGS_TARGET} PRIVATE "-fno-omit-frame-pointer")
+    endif()
+
     # Create a list with all files that are part of the unittest.
     cmake_path(SET _testSourcesPath NORMALIZE "${_targetBinaryDir}/unittest_test_files.toml")
     file(WRITE "${_testSourcesPath}" "# Erbsland UnitTest - Test Files\n")
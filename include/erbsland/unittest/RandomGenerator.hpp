@@ -0,0 +1,4 @@
+#pragma once
+#include "../../../src/erbsland/unittest/RandomGenerator.hpp"
+// !!! THIS IS A GENERATED FILE - DO NOT EDIT MANUALLY !!!
+// This file was generated by the "update_includes.py" script.
@@ -1,12 +1,18 @@
 // Copyright (c) 2025-2026 Tobias Erbsland - https://erbsland.dev
 // SPDX-License-Identifier: Apache-2.0
 #include "FileHelper.hpp"
+#include "UnitTest.hpp"
 
 #include "impl/AssertFailed.hpp"
 #include "impl/Console.hpp"
 #include "impl/ConsoleColor.hpp"
+#include "impl/ConsoleLine.hpp"
 #include "impl/Controller.hpp"
+#include "impl/StringDiff.hpp"
+#include "impl/Utf8Scan.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <format>
 #include <fstream>
 
@@ -21,6 +27,210 @@ namespace {
     throw AssertFailed();
 }
 
+/// The number of bytes that are read from a data file at once.
+constexpr std::size_t cDataChunkSize = 64U * 1024U;
+/// The number of bytes before the compared position, that are kept for the context of a difference.
+constexpr std::size_t cContextBefore = 160;
+/// The maximum number of bytes that are shown from a line after a difference.
+constexpr std::size_t cContextAfter = 60;
+/// The marker for text that is not shown.
+constexpr std::string_view cEllipsis = "...";
+
+/// Test if a byte is a UTF-8 continuation byte.
+auto isContinuation(const char byte) noexcept -> bool {
+    return (static_cast<std::uint8_t>(byte) & 0xC0U) == 0x80U;
+}
+
+/// Get the start of a text until the end of its first line, with at most `cContextAfter` bytes.
+auto lineStart(const std::string_view text) noexcept -> std::string_view {
+    auto length = std::min(text.find('\n'), text.size());
+    if (length > cContextAfter) {
+        length = cContextAfter;
+        while (length > 0 && isContinuation(text[length])) {
+            --length;
+        }
+    }
+    return text.substr(0, length);
+}
+
+/// Reads a data file in chunks, using a buffer with a fixed size.
+class DataFileReader {
+public:
+    explicit DataFileReader(const std::filesystem::path &path) :
+        _path{path}, _file{path, std::ios::in}, _buffer(cContextBefore + cDataChunkSize + cContextAfter, '\0') {
+        if (!_file) {
+            throwError(std::format("Could not open test data file for reading: {}", path.string()));
+        }
+    }
+
+public:
+    /// The bytes that were read, but not consumed.
+    [[nodiscard]] auto available() const noexcept -> std::string_view {
+        return {_buffer.data() + _position, _end - _position};
+    }
+    /// The last consumed bytes, with at least `cContextBefore` bytes if the file has them.
+    [[nodiscard]] auto consumed() const noexcept -> std::string_view { return {_buffer.data(), _position}; }
+    /// Consume bytes from the available bytes.
+    void consume(const std::size_t count) noexcept { _position += count; }
+
+    /// Read the next chunk of the file, until the given number of bytes is available or the file ends.
+    void fill(const std::size_t minimumAvailable) {
+        if (_end - _position >= minimumAvailable || _file.eof()) {
+            return;
+        }
+        const auto keepStart = _position > cContextBefore ? _position - cContextBefore : std::size_t{0};
+        std::memmove(_buffer.data(), _buffer.data() + keepStart, _end - keepStart);
+        _position -= keepStart;
+        _end -= keepStart;
+        _file.read(_buffer.data() + _end, static_cast<std::streamsize>(_buffer.size() - _end));
+        if (_file.bad()) {
+            throwError(std::format("Could not read the test data file: {}", _path.string()));
+        }
+        _end += static_cast<std::size_t>(_file.gcount());
+    }
+
+private:
+    std::filesystem::path _path; ///< The path of the file, for error messages.
+    std::ifstream _file;         ///< The opened file.
+    std::string _buffer;         ///< The buffer with the kept and the read bytes.
+    std::size_t _position{0};    ///< The index of the first available byte in the buffer.
+    std::size_t _end{0};         ///< The index after the last read byte in the buffer.
+};
+
+/// Create the message for a difference.
+/// @param difference The location of the difference, used for the first line of the message.
+/// @param path The path of the data file.
+/// @param before The equal text before the difference, including the previous line if possible.
+/// @param expected The expected text after the difference.
+/// @param actual The actual text after the difference.
+auto differenceMessage(const fh::DataFileDifference &difference,
+    const std::filesystem::path &path,
+    const std::string_view before,
+    const std::string_view expected,
+    const std::string_view actual) -> std::string {
+
+    auto message = std::string{};
+    if (actual.empty()) {
+        message = "Text ends before the data file";
+    } else if (expected.empty()) {
+        message = "Text continues after the end of the data file";
+    } else {
+        message = "Text differs from the data file";
+    }
+    message += std::format(" at line {}, column {} (byte {}): {}",
+        difference.line,
+        difference.column,
+        difference.byteIndex,
+        path.string());
+    // Split the equal text into the previous line and the start of the current line.
+    const auto isAtFileStart = before.size() == difference.byteIndex;
+    auto currentLine = before;
+    if (const auto lineBreak = before.rfind('\n'); lineBreak != std::string_view::npos) {
+        currentLine = before.substr(lineBreak + 1);
+        auto previousLine = before.substr(0, lineBreak);
+        auto isPreviousLineComplete = isAtFileStart;
+        if (const auto previousBreak = previousLine.rfind('\n'); previousBreak != std::string_view::npos) {
+            previousLine.remove_prefix(previousBreak + 1);
+            isPreviousLineComplete = true;
+        }
+        if (!previousLine.empty() && previousLine.back() == '\r') {
+            previousLine.remove_suffix(1);
+        }
+        message += std::format("\n    {}{}",
+            isPreviousLineComplete ? std::string_view{} : cEllipsis,
+            ConsoleLine::utf8EscapedString(previousLine));
+    }
+    const auto isCurrentLineComplete = currentLine.size() < before.size() || isAtFileStart;
+    const auto equalText = std::format(
+        "{}{}", isCurrentLineComplete ? std::string_view{} : cEllipsis, ConsoleLine::utf8EscapedString(currentLine));
+    auto shownLine = [&equalText](const std::string_view text) -> std::string {
+        const auto shown = lineStart(text);
+        return std::format("{}{}{}",
+            equalText,
+            ConsoleLine::utf8EscapedString(shown),
+            shown.size() < text.size() && text[shown.size()] != '\n' ? cEllipsis : std::string_view{});
+    };
+    message += std::format("\n  - {}\n  + {}\n    {}^",
+        shownLine(expected),
+        shownLine(actual),
+        std::string(ConsoleLine::utf8Length(equalText), ' '));
+    return message;
+}
+
+/// Compare a text with a data file.
+auto findDifference(const std::filesystem::path &path, const fh::ChunkProducer &producer)
+    -> std::optional<fh::DataFileDifference> {
+
+    auto reader = DataFileReader{path};
+    auto result = fh::DataFileDifference{};
+    auto actual = producer();
+    while (true) {
+        reader.fill(1);
+        const auto expected = reader.available();
+        if (expected.empty() || actual.empty()) {
+            if (expected.empty() && actual.empty()) {
+                return std::nullopt;
+            }
+            break;
+        }
+        const auto length = std::min(expected.size(), actual.size());
+        const auto equalLength = commonPrefixLength(expected.substr(0, length), actual.substr(0, length));
+        // Track the line and column of the compared position.
+        const auto equalText = actual.substr(0, equalLength);
+        if (const auto lineBreak = equalText.rfind('\n'); lineBreak != std::string_view::npos) {
+            result.line += static_cast<std::uint64_t>(std::ranges::count(equalText, '\n'));
+            result.column = 1 + th::impl::utf8CharacterCount(equalText.substr(lineBreak + 1));
+        } else {
+            result.column += th::impl::utf8CharacterCount(equalText);
+        }
+        result.byteIndex += equalLength;
+        reader.consume(equalLength);
+        actual.remove_prefix(equalLength);
+        if (equalLength < length) {
+            break;
+        }
+        if (actual.empty()) {
+            actual = producer();
+        }
+    }
+    // Collect the start of the actual line after the difference. It is copied, as it can span several chunks.
+    auto actualLine = std::string{};
+    while (!actual.empty() && actualLine.size() <= cContextAfter && actualLine.find('\n') == std::string::npos) {
+        const auto count = std::min(actual.size(), cContextAfter + 1 - actualLine.size());
+        actualLine.append(actual.substr(0, count));
+        actual.remove_prefix(count);
+        if (actual.empty() && actualLine.size() <= cContextAfter) {
+            actual = producer();
+        }
+    }
+    reader.fill(cContextAfter + 1);
+    auto before = reader.consumed();
+    auto expectedLine = reader.available();
+    // Move the difference to the start of the differing character.
+    auto shift = std::size_t{0};
+    auto startsInSequence = [&]() -> bool {
+        if (shift == 0) {
+            return (!expectedLine.empty() && isContinuation(expectedLine.front())) ||
+                (!actualLine.empty() && isContinuation(actualLine.front()));
+        }
+        return isContinuation(before[before.size() - shift]);
+    };
+    while (shift < before.size() && shift < 4 && startsInSequence()) {
+        ++shift;
+    }
+    if (shift > 0) {
+        const auto sequence = before.substr(before.size() - shift);
+        before.remove_suffix(shift);
+        expectedLine = std::string_view{expectedLine.data() - shift, expectedLine.size() + shift};
+        actualLine.insert(0, sequence);
+        result.byteIndex -= shift;
+        result.column -= 1;
+    }
+    const auto contextStart = before.size() > cContextBefore ? before.size() - cContextBefore : std::size_t{0};
+    result.message = differenceMessage(result, path, before.substr(contextStart), expectedLine, actualLine);
+    return result;
+}
+
 }
 
 auto unitTestExecutablePath() -> std::filesystem::path {
@@ -28,6 +238,17 @@ auto unitTestExecutablePath() -> std::filesystem::path {
 }
 
 auto resolveDataPath(std::string_view relativePath) -> std::filesystem::path {
+    if (auto path = findDataPath(relativePath); !path.empty()) {
+        return path;
+    }
+    const auto exeDir = unitTestExecutablePath().parent_path();
+    const auto path1 = exeDir / relativePath;
+    const auto path2 = exeDir.parent_path() / relativePath;
+    throwError(std::format(
+        "Could not resolve test data path: {}\nTried:\n  {}\n  {}\n", relativePath, path1.string(), path2.string()));
+}
+
+auto findDataPath(std::string_view relativePath) -> std::filesystem::path {
     const auto exePath = unitTestExecutablePath();
     const auto exeDir = exePath.parent_path();
 
@@ -41,8 +262,7 @@ auto resolveDataPath(std::string_view relativePath) -> std::filesystem::path {
         return path2;
     }
 
-    throwError(std::format(
-        "Could not resolve test data path: {}\nTried:\n  {}\n  {}\n", relativePath, path1.string(), path2.string()));
+    return {};
 }
 
 auto readDataText(std::string_view relativePath, std::size_t maximumSize) -> std::string {
@@ -99,4 +319,47 @@ auto readDataLines(std::string_view relativePath, std::size_t maximumSize) -> st
     return lines;
 }
 
+auto findDataFileDifference(const std::string_view actual, const std::string_view relativePath)
+    -> std::optional<DataFileDifference> {
+    auto isProduced = false;
+    return findDataFileDifference(
+        [&]() -> std::string_view {
+            if (isProduced) {
+                return {};
+            }
+            isProduced = true;
+            return actual;
+        },
+        relativePath);
+}
+
+auto findDataFileDifference(const ChunkProducer &actual, const std::string_view relativePath)
+    -> std::optional<DataFileDifference> {
+    const auto path = resolveDataPath(relativePath);
+    if (!std::filesystem::is_regular_file(path)) {
+        throwError(std::format("Test data path is not a regular file: {}", path.string()));
+    }
+    return findDifference(path, actual);
+}
+
+void requireMatchesDataFile(UnitTest &test, const std::string_view actual, const std::string_view relativePath) {
+    const auto difference = findDataFileDifference(actual, relativePath);
+    test.runWithContext(
+        SOURCE_LOCATION(),
+        [&]() -> void {
+            ASSERT_CONTEXT_REQUIRE_FOR_TEST(&test, "REQUIRE_MATCHES_DATA_FILE", 0, !difference.has_value())
+        },
+        [&]() -> std::string { return difference->message; });
+}
+
+void requireMatchesDataFile(UnitTest &test, const ChunkProducer &actual, const std::string_view relativePath) {
+    const auto difference = findDataFileDifference(actual, relativePath);
+    test.runWithContext(
+        SOURCE_LOCATION(),
+        [&]() -> void {
+            ASSERT_CONTEXT_REQUIRE_FOR_TEST(&test, "REQUIRE_MATCHES_DATA_FILE", 0, !difference.has_value())
+        },
+        [&]() -> std::string { return difference->message; });
+}
+
 }
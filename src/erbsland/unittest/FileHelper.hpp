@@ -2,7 +2,12 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "fwd.hpp"
+
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -29,6 +34,16 @@ auto unitTestExecutablePath() -> std::filesystem::path;
 ///
 auto resolveDataPath(std::string_view relativePath) -> std::filesystem::path;
 
+/// Searches for a test data file or directory, without failing the test.
+///
+/// This method uses the same search locations as `resolveDataPath()`, but returns an empty path
+/// if the test data does not exist. Use it for optional test data.
+///
+/// @param relativePath The relative path to the test data.
+/// @return The resolved absolute path to the test data, or an empty path if it was not found.
+///
+auto findDataPath(std::string_view relativePath) -> std::filesystem::path;
+
 /// Reads the complete contents of a test data file into a string.
 ///
 /// @param relativePath The relative path to the test data file.
@@ -47,4 +62,59 @@ auto readDataText(std::string_view relativePath, std::size_t maximumSize = 10000
 ///
 auto readDataLines(std::string_view relativePath, std::size_t maximumSize = 10000000U) -> std::vector<std::string>;
 
+/// A function that produces a text in chunks.
+///
+/// Each call returns the next chunk of the text, and an empty view at the end of the text. The returned view
+/// must stay valid until the next call.
+///
+using ChunkProducer = std::function<std::string_view()>;
+
+/// The location and context of the first difference between a text and a data file.
+///
+struct DataFileDifference {
+    std::uint64_t byteIndex{0}; ///< The byte index of the first differing character.
+    std::uint64_t line{1};      ///< The line of the first differing character, starting with 1.
+    std::uint64_t column{1};    ///< The column of the first differing character in code-points, starting with 1.
+    std::string message;        ///< A message with the location and the lines around the difference.
+};
+
+/// Searches for the first difference between a text and a test data file.
+///
+/// The data file is read in chunks and compared with the text while reading, so texts and files of any size
+/// are compared using a small, constant amount of memory. The comparison stops at the first difference. Like
+/// `readDataText()`, the file is read in text mode, so the line endings of the file are converted on Windows.
+///
+/// @param actual The text to compare.
+/// @param relativePath The relative path to the test data file.
+/// @return The first difference, or no value if the text is equal to the contents of the file.
+/// @throws AssertFailed If the file cannot be found or read.
+///
+[[nodiscard]] auto findDataFileDifference(std::string_view actual, std::string_view relativePath)
+    -> std::optional<DataFileDifference>;
+
+/// @overload
+/// @param actual A function that produces the text to compare in chunks.
+/// @param relativePath The relative path to the test data file.
+///
+[[nodiscard]] auto findDataFileDifference(const ChunkProducer &actual, std::string_view relativePath)
+    -> std::optional<DataFileDifference>;
+
+/// Test if a text is equal to the contents of a test data file.
+///
+/// The file is compared in chunks, as described for `findDataFileDifference()`. If the text differs, the test
+/// fails with the line and column of the first difference, and the expected and actual lines around it.
+///
+/// @param test The active test instance.
+/// @param actual The text to compare.
+/// @param relativePath The relative path to the test data file.
+///
+void requireMatchesDataFile(UnitTest &test, std::string_view actual, std::string_view relativePath);
+
+/// @overload
+/// @param test The active test instance.
+/// @param actual A function that produces the text to compare in chunks.
+/// @param relativePath The relative path to the test data file.
+///
+void requireMatchesDataFile(UnitTest &test, const ChunkProducer &actual, std::string_view relativePath);
+
 }
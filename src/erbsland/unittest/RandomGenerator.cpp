@@ -0,0 +1,148 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "RandomGenerator.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace erbsland::unittest {
+
+static_assert(std::uniform_random_bit_generator<RandomGenerator>);
+
+namespace {
+
+/// The SplitMix64 step, used to expand seeds into the generator state.
+constexpr auto splitMix64(std::uint64_t &state) noexcept -> std::uint64_t {
+    state += 0x9e3779b97f4a7c15ULL;
+    auto z = state;
+    z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31U);
+}
+
+/// The number of interleaved lanes used to fill buffers.
+constexpr std::size_t cFillLanes = 4;
+
+}
+
+RandomGenerator::RandomGenerator(const std::uint64_t seed) noexcept : _seed{seed} {
+    auto state = seed;
+    for (auto &value : _state) {
+        value = splitMix64(state);
+    }
+}
+
+auto RandomGenerator::seed() const noexcept -> std::uint64_t {
+    return _seed;
+}
+
+auto RandomGenerator::derive(const std::uint64_t streamId) const noexcept -> RandomGenerator {
+    return RandomGenerator{mixSeed(_seed, streamId)};
+}
+
+auto RandomGenerator::derive(const std::string_view streamName) const noexcept -> RandomGenerator {
+    return derive(hashText(streamName));
+}
+
+auto RandomGenerator::split() noexcept -> RandomGenerator {
+    return RandomGenerator{mixSeed(_seed, (*this)())};
+}
+
+auto RandomGenerator::nextDouble() noexcept -> double {
+    // Use the upper 53 bits, as the lower bits of xoshiro256** are slightly weaker.
+    return static_cast<double>((*this)() >> 11U) * 0x1.0p-53;
+}
+
+auto RandomGenerator::nextBool() noexcept -> bool {
+    return ((*this)() >> 63U) != 0;
+}
+
+auto RandomGenerator::nextBelowOrEqual(const std::uint64_t limit) noexcept -> std::uint64_t {
+    if (limit == std::numeric_limits<std::uint64_t>::max()) {
+        return (*this)();
+    }
+    // Rejection sampling with a bit mask; on average less than two iterations are required.
+    auto mask = limit;
+    mask |= mask >> 1U;
+    mask |= mask >> 2U;
+    mask |= mask >> 4U;
+    mask |= mask >> 8U;
+    mask |= mask >> 16U;
+    mask |= mask >> 32U;
+    std::uint64_t value = 0;
+    do {
+        value = (*this)() & mask;
+    } while (value > limit);
+    return value;
+}
+
+void RandomGenerator::fill(const std::span<std::byte> buffer) noexcept {
+    // Derive independent lanes, so the compiler can interleave the generator steps.
+    const auto baseSeed = mixSeed(_seed, (*this)());
+    std::array<RandomGenerator, cFillLanes> lanes{
+        RandomGenerator{mixSeed(baseSeed, 0)},
+        RandomGenerator{mixSeed(baseSeed, 1)},
+        RandomGenerator{mixSeed(baseSeed, 2)},
+        RandomGenerator{mixSeed(baseSeed, 3)},
+    };
+    constexpr std::size_t blockSize = cFillLanes * sizeof(std::uint64_t);
+    auto *data = buffer.data();
+    auto remaining = buffer.size();
+    while (remaining >= blockSize) {
+        std::array<std::uint64_t, cFillLanes> block{};
+        for (std::size_t lane = 0; lane < cFillLanes; ++lane) {
+            block[lane] = lanes[lane]();
+        }
+        std::memcpy(data, block.data(), blockSize);
+        data += blockSize;
+        remaining -= blockSize;
+    }
+    if (remaining > 0) {
+        std::array<std::uint64_t, cFillLanes> block{};
+        for (std::size_t lane = 0; lane < cFillLanes; ++lane) {
+            block[lane] = lanes[lane]();
+        }
+        std::memcpy(data, block.data(), remaining);
+    }
+}
+
+void RandomGenerator::fill(void *data, const std::size_t size) noexcept {
+    fill(std::span<std::byte>{static_cast<std::byte *>(data), size});
+}
+
+auto RandomGenerator::randomBytes(const std::size_t size) -> std::string {
+    std::string result(size, '\0');
+    fill(result.data(), result.size());
+    return result;
+}
+
+auto RandomGenerator::randomText(const std::size_t length, const std::string_view alphabet) -> std::string {
+    if (alphabet.empty()) {
+        return {};
+    }
+    std::string result;
+    result.reserve(length);
+    const auto maximum = alphabet.size() - 1;
+    for (std::size_t i = 0; i < length; ++i) {
+        result.push_back(alphabet[nextInRange<std::size_t>(0, maximum)]);
+    }
+    return result;
+}
+
+auto RandomGenerator::hashText(const std::string_view text) noexcept -> std::uint64_t {
+    // FNV-1a, 64-bit.
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto c : text) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+auto RandomGenerator::mixSeed(const std::uint64_t seed, const std::uint64_t value) noexcept -> std::uint64_t {
+    auto state = seed;
+    state = splitMix64(state) ^ value;
+    return splitMix64(state);
+}
+
+}
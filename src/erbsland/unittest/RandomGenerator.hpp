@@ -0,0 +1,192 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace erbsland::unittest {
+
+/// A small, fast and splittable pseudo-random number generator for tests.
+///
+/// The generator implements the *xoshiro256*** algorithm, seeded using *SplitMix64*. Its state is only
+/// 32 bytes, so it is cheap to create, copy and derive new independent streams from it. The class satisfies
+/// the `std::uniform_random_bit_generator` concept and can be used with all distributions of the standard
+/// library.
+///
+/// Every test gets its own generator via `UnitTest::random()`. It is seeded from the global seed of the test
+/// run and the names of the suite and test, so a failing test can be replayed with the `--seed` option.
+///
+/// Usage:
+/// <code>
+/// void testDecoder() {
+///     auto data = random().randomBytes(4096);
+///     auto value = random().nextInRange(1, 6);
+///     // ...
+/// }
+/// </code>
+///
+/// @warning <b>Thread Safety:</b> A generator instance must not be shared between threads. Use `derive()`
+/// to create one independent generator per thread.
+///
+class RandomGenerator final {
+    // fwd-entry: class RandomGenerator
+
+public:
+    using result_type = std::uint64_t; ///< The type of the generated values.
+
+public:
+    /// Create a new generator from a seed.
+    ///
+    /// @param seed The seed for the generator. The same seed always produces the same sequence.
+    ///
+    explicit RandomGenerator(std::uint64_t seed = 0) noexcept;
+
+public: // std::uniform_random_bit_generator
+    /// The smallest value that is returned.
+    [[nodiscard]] static constexpr auto min() noexcept -> result_type { return 0; }
+    /// The largest value that is returned.
+    [[nodiscard]] static constexpr auto max() noexcept -> result_type {
+        return std::numeric_limits<result_type>::max();
+    }
+    /// Generate the next 64-bit value.
+    auto operator()() noexcept -> result_type {
+        const auto result = rotateLeft(_state[1] * 5U, 7) * 9U;
+        const auto t = _state[1] << 17U;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotateLeft(_state[3], 45);
+        return result;
+    }
+
+public:
+    /// Get the seed that was used to create this generator.
+    ///
+    /// @return The seed of this generator.
+    ///
+    [[nodiscard]] auto seed() const noexcept -> std::uint64_t;
+
+    /// Derive a new, independent generator for a given stream.
+    ///
+    /// The derived generator only depends on the seed of this generator and the stream identifier, and not on
+    /// the number of values that were already generated. Use this method to create one generator per thread,
+    /// by passing the thread index as stream identifier.
+    ///
+    /// @param streamId The identifier for the new stream, e.g. a thread index.
+    /// @return A new generator for the stream.
+    ///
+    [[nodiscard]] auto derive(std::uint64_t streamId) const noexcept -> RandomGenerator;
+
+    /// @overload
+    /// @param streamName A name for the new stream.
+    [[nodiscard]] auto derive(std::string_view streamName) const noexcept -> RandomGenerator;
+
+    /// Split a new generator from this one.
+    ///
+    /// In contrast to `derive()`, this consumes a value from this generator, so every call returns a generator
+    /// with a different sequence.
+    ///
+    /// @return A new generator.
+    ///
+    [[nodiscard]] auto split() noexcept -> RandomGenerator;
+
+    /// Generate an integer in the closed range `[minimum, maximum]`, without modulo bias.
+    ///
+    /// @tparam T An integral type.
+    /// @param minimum The smallest value that is returned.
+    /// @param maximum The largest value that is returned. Must not be less than `minimum`.
+    /// @return A uniformly distributed value in the range.
+    ///
+    template <std::integral T>
+    [[nodiscard]] auto nextInRange(T minimum, T maximum) noexcept -> T {
+        const auto range = static_cast<std::uint64_t>(maximum) - static_cast<std::uint64_t>(minimum);
+        return static_cast<T>(static_cast<std::uint64_t>(minimum) + nextBelowOrEqual(range));
+    }
+
+    /// Generate a floating point value in the half-open range `[0, 1)`.
+    ///
+    /// @return A uniformly distributed value.
+    ///
+    [[nodiscard]] auto nextDouble() noexcept -> double;
+
+    /// Generate a boolean value.
+    ///
+    /// @return `true` or `false`, with equal probability.
+    ///
+    [[nodiscard]] auto nextBool() noexcept -> bool;
+
+    /// Fill a buffer with random bytes.
+    ///
+    /// This method uses four interleaved generator lanes, so large buffers are filled close to memory bandwidth.
+    /// Filling a buffer consumes exactly one value from this generator, regardless of the buffer size. The
+    /// first bytes of a larger buffer are identical to the bytes of a smaller buffer filled from the same state.
+    ///
+    /// @param buffer The buffer to fill.
+    ///
+    void fill(std::span<std::byte> buffer) noexcept;
+
+    /// @overload
+    /// @param data Pointer to the buffer.
+    /// @param size The size of the buffer in bytes.
+    void fill(void *data, std::size_t size) noexcept;
+
+    /// Create a string with random bytes.
+    ///
+    /// @param size The number of bytes.
+    /// @return A string with `size` random bytes. The result is usually not valid UTF-8.
+    ///
+    [[nodiscard]] auto randomBytes(std::size_t size) -> std::string;
+
+    /// Create a random text using the characters from an alphabet.
+    ///
+    /// @param length The number of characters.
+    /// @param alphabet The characters to choose from. Each byte is one character.
+    /// @return The random text.
+    ///
+    [[nodiscard]] auto randomText(
+        std::size_t length, std::string_view alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789")
+        -> std::string;
+
+public:
+    /// Create a stable 64-bit hash for a text.
+    ///
+    /// This hash is used to derive seeds from names. In contrast to `std::hash`, the result is identical on
+    /// all platforms and compilers.
+    ///
+    /// @param text The text to hash.
+    /// @return The hash value.
+    ///
+    [[nodiscard]] static auto hashText(std::string_view text) noexcept -> std::uint64_t;
+
+    /// Mix two values into a new seed.
+    ///
+    /// @param seed The base seed.
+    /// @param value The value to mix into the seed.
+    /// @return The new seed.
+    ///
+    [[nodiscard]] static auto mixSeed(std::uint64_t seed, std::uint64_t value) noexcept -> std::uint64_t;
+
+private:
+    /// Generate a value in the range `[0, limit]`.
+    [[nodiscard]] auto nextBelowOrEqual(std::uint64_t limit) noexcept -> std::uint64_t;
+    /// Rotate a value to the left.
+    [[nodiscard]] static constexpr auto rotateLeft(const std::uint64_t value, const int count) noexcept
+        -> std::uint64_t {
+        return (value << static_cast<unsigned>(count)) | (value >> static_cast<unsigned>(64 - count));
+    }
+
+private:
+    std::uint64_t _seed;                   ///< The seed used to create this generator.
+    std::array<std::uint64_t, 4> _state{}; ///< The xoshiro256** state.
+};
+
+}
@@ -188,6 +188,26 @@ auto invalidUtf8(
     return result;
 }
 
+auto lineRange(const std::string_view text) noexcept -> LineRange<char> {
+    return LineRange<char>{text};
+}
+
+auto lineRange(const std::u8string_view text) noexcept -> LineRange<char8_t> {
+    return LineRange<char8_t>{text};
+}
+
+auto lineRange(const std::u16string_view text) noexcept -> LineRange<char16_t> {
+    return LineRange<char16_t>{text};
+}
+
+auto lineRange(const std::u32string_view text) noexcept -> LineRange<char32_t> {
+    return LineRange<char32_t>{text};
+}
+
+auto lineRange(const std::wstring_view text) noexcept -> LineRange<wchar_t> {
+    return LineRange<wchar_t>{text};
+}
+
 auto splitLineViews(const std::string_view text) -> std::vector<std::string_view> {
     return impl::splitLineViews(text);
 }
@@ -228,6 +248,26 @@ auto splitLines(const std::wstring_view text) -> std::vector<std::wstring> {
     return impl::splitLines<std::wstring_view, std::wstring>(text);
 }
 
+auto matchesWildcardPattern(const std::string_view pattern, const std::string_view text) -> bool {
+    return impl::matchesWildcardPattern(pattern, text);
+}
+
+auto matchesWildcardPattern(const std::u8string_view pattern, const std::u8string_view text) -> bool {
+    return impl::matchesWildcardPattern(pattern, text);
+}
+
+auto matchesWildcardPattern(const std::u16string_view pattern, const std::u16string_view text) -> bool {
+    return impl::matchesWildcardPattern(pattern, text);
+}
+
+auto matchesWildcardPattern(const std::u32string_view pattern, const std::u32string_view text) -> bool {
+    return impl::matchesWildcardPattern(pattern, text);
+}
+
+auto matchesWildcardPattern(const std::wstring_view pattern, const std::wstring_view text) -> bool {
+    return impl::matchesWildcardPattern(pattern, text);
+}
+
 void requireValidUtf8(UnitTest &test, const std::string_view text) {
     const auto validation = impl::validateUtf8(text);
     test.runWithContext(
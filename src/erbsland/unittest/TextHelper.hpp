@@ -6,6 +6,7 @@
 
 #include "impl/Macros.hpp"
 #include "impl/TextHelperImpl.hpp"
+#include "impl/Utf8Scan.hpp"
 
 #include <array>
 #include <cstdint>
@@ -168,8 +169,9 @@ constexpr auto allUtf8Errors = std::array<Utf8Error, static_cast<std::size_t>(Ut
 ///
 /// This function returns string views into the original input and therefore does not allocate storage for the
 /// individual line contents. The original text must stay alive and unchanged while the returned views are used.
-/// Lines are split at newline characters (`\n`), and the resulting views do not include the newline characters.
-/// A trailing newline does not produce an additional empty line at the end.
+/// Lines are split like in `lineRange()`: at newline characters (`\n`), and the resulting views include neither the
+/// newline characters nor a carriage return in front of them. A trailing newline does not produce an additional
+/// empty line at the end.
 ///
 /// @param text The text to split into lines.
 /// @return A vector of string views, each representing a line from the input text.
@@ -183,10 +185,32 @@ constexpr auto allUtf8Errors = std::array<Utf8Error, static_cast<std::size_t>(Ut
 /// @overload
 [[nodiscard]] auto splitLineViews(std::wstring_view text) -> std::vector<std::wstring_view>;
 
+/// Get a lazy range over the lines of a text.
+///
+/// The range does not allocate any memory and can be used directly in a range-based for loop or with
+/// `requireEqualLines()`, which makes it the best choice to compare large texts line by line. It returns string
+/// views into the original input, so the text must stay alive and unchanged while the range is used.
+///
+/// Lines are split at newline characters (`\n`), and a carriage return in front of a newline (`\r\n`) is removed
+/// as well. A trailing newline does not produce an additional empty line at the end.
+///
+/// @param text The text to iterate over.
+/// @return A forward range with a string view for each line.
+[[nodiscard]] auto lineRange(std::string_view text) noexcept -> LineRange<char>;
+/// @overload
+[[nodiscard]] auto lineRange(std::u8string_view text) noexcept -> LineRange<char8_t>;
+/// @overload
+[[nodiscard]] auto lineRange(std::u16string_view text) noexcept -> LineRange<char16_t>;
+/// @overload
+[[nodiscard]] auto lineRange(std::u32string_view text) noexcept -> LineRange<char32_t>;
+/// @overload
+[[nodiscard]] auto lineRange(std::wstring_view text) noexcept -> LineRange<wchar_t>;
+
 /// Split a string into individual lines and return owned strings for each line.
 ///
-/// Lines are split at newline characters (`\n`), and the resulting strings do not include the newline
-/// characters. A trailing newline does not produce an additional empty line at the end.
+/// Lines are split like in `lineRange()`: at newline characters (`\n`), and the resulting strings include neither
+/// the newline characters nor a carriage return in front of them. A trailing newline does not produce an additional
+/// empty line at the end.
 ///
 /// @param text The text to split into lines.
 /// @return A vector containing one string per line from the input text.
@@ -200,6 +224,29 @@ constexpr auto allUtf8Errors = std::array<Utf8Error, static_cast<std::size_t>(Ut
 /// @overload
 [[nodiscard]] auto splitLines(std::wstring_view text) -> std::vector<std::wstring>;
 
+/// Test if a text matches a pattern with wildcards.
+///
+/// In the pattern, an asterisk (`*`) matches any number of characters, and a question mark (`?`) matches exactly
+/// one character (one code unit of the string type). Use `\*` and `\?` to match these characters literally;
+/// any other backslash is matched as it is. The pattern must match the whole text.
+///
+/// The time to match grows linearly with the length of the text, unless a part between two `*` wildcards has
+/// literal characters on both sides of a `?`. It is a fast replacement for a regular expression like
+/// `.*id=.*, ts=.*`.
+///
+/// @param pattern The pattern with wildcards.
+/// @param text The text to match.
+/// @return `true` if the pattern matches the text.
+[[nodiscard]] auto matchesWildcardPattern(std::string_view pattern, std::string_view text) -> bool;
+/// @overload
+[[nodiscard]] auto matchesWildcardPattern(std::u8string_view pattern, std::u8string_view text) -> bool;
+/// @overload
+[[nodiscard]] auto matchesWildcardPattern(std::u16string_view pattern, std::u16string_view text) -> bool;
+/// @overload
+[[nodiscard]] auto matchesWildcardPattern(std::u32string_view pattern, std::u32string_view text) -> bool;
+/// @overload
+[[nodiscard]] auto matchesWildcardPattern(std::wstring_view pattern, std::wstring_view text) -> bool;
+
 /// Compare a container with lines, against a container with line patterns.
 ///
 /// Common usage:
@@ -214,39 +261,51 @@ constexpr auto allUtf8Errors = std::array<Utf8Error, static_cast<std::size_t>(Ut
 /// }
 /// </code>
 ///
-/// Each line on the expected side can contain *one* optional asterisk (*) character, that matches any number
-/// of characters at this location. The expected line can also contain any number of question mark (?) characters
-/// that match exactly one character at this location.
+/// Each line on the expected side is a pattern for `matchesWildcardPattern()`. It can contain any number of
+/// asterisk (*) characters, that match any number of characters at this location, and question mark (?)
+/// characters, that match exactly one character at this location.
 ///
 /// If the number of lines differs, or if at least one line does not match, the test fails and reports a
-/// side-by-side comparison of the actual and expected lines.
+/// unified diff of the expected and actual lines. The diff finds the shortest list of removed and added lines,
+/// so a single missing line only shows up once, with three lines of context around it.
 ///
-/// @tparam tActual A range type that provides `size()`, `begin()`, `end()`, and string-like line values.
-/// @tparam tExpected A range type that provides `size()`, `begin()`, `end()`, and pattern line values.
+/// The lines are compared while iterating over both ranges, without allocating any memory. Therefore, a lazy
+/// range from `lineRange()` can be used to compare large texts. Only if the test fails, the line diff is created.
+///
+/// @tparam tActual A forward range with string-like line values.
+/// @tparam tExpected A forward range with pattern line values.
 /// @param test The active test instance.
 /// @param actual The produced lines from the test.
 /// @param expected The expected lines or line patterns.
 template <typename tActual, typename tExpected>
-    requires std::ranges::range<tActual> && std::ranges::range<tExpected>
+    requires std::ranges::forward_range<const tActual> && std::ranges::forward_range<const tExpected>
 void requireEqualLines(UnitTest &test, const tActual &actual, const tExpected &expected) {
 
     test.runWithContext(
         SOURCE_LOCATION(),
         [&]() -> void {
-            ASSERT_CONTEXT_COMPARISON_FOR_TEST(&test, "REQUIRE_EQUAL", 0, ==, actual.size(), expected.size());
-            auto itActual = actual.begin();
-            auto itExpected = expected.begin();
-            for (; itActual != actual.end(); ++itActual, ++itExpected) {
+            if constexpr (std::ranges::sized_range<const tActual> && std::ranges::sized_range<const tExpected>) {
+                ASSERT_CONTEXT_COMPARISON_FOR_TEST(
+                    &test, "REQUIRE_EQUAL", 0, ==, std::ranges::size(actual), std::ranges::size(expected));
+            }
+            auto itActual = std::ranges::begin(actual);
+            auto itExpected = std::ranges::begin(expected);
+            for (; itActual != std::ranges::end(actual) && itExpected != std::ranges::end(expected);
+                 ++itActual, ++itExpected) {
                 ASSERT_CONTEXT_REQUIRE_FOR_TEST(
                     &test, "REQUIRE", 0, impl::compareWithStarAndQuestionMark(*itExpected, *itActual))
             }
+            ASSERT_CONTEXT_REQUIRE_FOR_TEST(&test,
+                "REQUIRE",
+                0,
+                itActual == std::ranges::end(actual) && itExpected == std::ranges::end(expected))
         },
-        [&]() -> std::string { return impl::createSideBySideComparison(actual, expected); });
+        [&]() -> std::string { return impl::createLineDiff(actual, expected); });
 }
 
 /// Convenience macro to call `requireEqualLines()` for the current test instance.
 ///
-/// The macro wraps the check in `WITH_CONTEXT(...)` so the generated side-by-side comparison becomes part of
+/// The macro wraps the check in `WITH_CONTEXT(...)` so the generated line diff becomes part of
 /// the failure context automatically.
 #define REQUIRE_EQUAL_LINES(actual, expected)                                                                          \
     WITH_CONTEXT(erbsland::unittest::th::requireEqualLines(*this, actual, expected));
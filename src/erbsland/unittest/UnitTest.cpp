@@ -16,10 +16,28 @@ void UnitTest::tearDown() {
     // empty
 }
 
+void UnitTest::setUpSuite() {
+    // empty
+}
+
+void UnitTest::tearDownSuite() {
+    // empty
+}
+
 auto UnitTest::unitTestExecutablePath() -> std::filesystem::path {
     return fh::unitTestExecutablePath();
 }
 
+auto UnitTest::random() noexcept -> RandomGenerator & {
+    return Controller::instance()->random();
+}
+
+auto UnitTest::sharedFixtureObject(const std::string &name,
+    const std::type_info &type,
+    const std::function<std::shared_ptr<void>()> &factory) -> void * {
+    return Controller::instance()->sharedFixture(name, type, factory);
+}
+
 void UnitTest::runWithContext(const SourceLocation &sourceLocation,
     const std::function<void()> &testFn,
     const std::function<std::string()> &diagnoseFn) {
@@ -3,13 +3,23 @@
 #pragma once
 
 #include "FileHelper.hpp"
+#include "RandomGenerator.hpp"
 
+#include "impl/ApproxComparison.hpp"
 #include "impl/AssertContext.hpp"
+#include "impl/DeathTest.hpp"
 #include "impl/Definitions.hpp"
 #include "impl/Macros.hpp"
 #include "impl/Private.hpp"
+#include "impl/RangeComparison.hpp"
+#include "impl/TestStack.hpp"
 
 #include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
 
 namespace erbsland::unittest {
 
@@ -18,7 +28,7 @@ namespace erbsland::unittest {
 /// Please read the documentation on how to write your unit tests.
 ///
 /// @warning <b>Thread Safety:</b> The unit tests are meant to run in a single thread. If tests use
-/// multithreaded testing, macros like `REQUIRE()` must only be called from the main thread.
+/// multithreaded testing, macros like `REQUIRE()` must only be called from the thread that runs the test.
 ///
 class UnitTest {
     // fwd-entry: class UnitTest
@@ -67,6 +77,21 @@ public:
     ///
     virtual void tearDown();
 
+    /// Execute code once, before the first test in this class.
+    ///
+    /// All tests in a class share a single instance of the class. It is created before `setUpSuite()` is called
+    /// and kept until all tests in the class have run, so fixtures created here are visible to all tests.
+    /// The method is not called if no test in this class is enabled. If it fails, all tests in this class are
+    /// skipped and `tearDownSuite()` is not called.
+    ///
+    virtual void setUpSuite();
+
+    /// Execute code once, after the last test in this class.
+    ///
+    /// This method is also called if a test in this class failed.
+    ///
+    virtual void tearDownSuite();
+
 public: // helper methods.
     /// Run a code in a separate context and optionally collect additional information if tests are failing.
     ///
@@ -103,6 +128,56 @@ public: // helper methods.
     ///
     auto unitTestExecutablePath() -> std::filesystem::path;
 
+    /// Access the random generator for the current test.
+    ///
+    /// The generator is reset before each test, using a seed derived from the global random seed and the
+    /// names of the suite and test. If a test that used the generator fails, the seed is reported, and the
+    /// test can be replayed using the `--seed` command line option.
+    ///
+    /// Use `random().derive(threadIndex)` to create independent generators for threads.
+    ///
+    /// @return The random generator for the current test.
+    ///
+    auto random() noexcept -> RandomGenerator &;
+
+    /// Access a shared fixture, that is created on first use and shared by all test suites.
+    ///
+    /// Use shared fixtures for expensive, read-only data that is required by several suites. The factory is
+    /// only called if the fixture does not exist yet. Declare the used fixtures with `SHARED_FIXTURES(name)`
+    /// for the class, to keep the fixture until the last suite that uses it has finished. Without the
+    /// declaration, the fixture is destroyed after the suite finished, and created again for the next suite.
+    ///
+    /// Usage:
+    /// <code>
+    /// SHARED_FIXTURES(corpus)
+    /// class DecoderTest final : public el::UnitTest {
+    /// public:
+    ///     void testDecode() {
+    ///         const auto &corpus = sharedFixture("corpus", []() { return loadCorpus(); });
+    ///         // ...
+    ///     }
+    /// };
+    /// </code>
+    ///
+    /// @param name The name of the fixture.
+    /// @param factory A function that creates the fixture and returns it by value.
+    /// @return A reference to the fixture. It is valid until the current suite finished.
+    ///
+    template <typename Factory>
+    auto sharedFixture(const std::string &name, Factory factory) -> std::invoke_result_t<Factory> & {
+        using FixtureType = std::invoke_result_t<Factory>;
+        auto object = sharedFixtureObject(name, typeid(FixtureType), [&factory]() -> std::shared_ptr<void> {
+            return std::make_shared<FixtureType>(factory());
+        });
+        return *static_cast<FixtureType *>(object);
+    }
+
+private:
+    /// Get or create a shared fixture, in a type erased form.
+    auto sharedFixtureObject(const std::string &name,
+        const std::type_info &type,
+        const std::function<std::shared_ptr<void>()> &factory) -> void *;
+
 public:
     friend class Private;
     friend class AssertContext;
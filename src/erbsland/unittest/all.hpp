@@ -6,6 +6,7 @@
 // This file was generated by the "update_includes.py" script.
 
 #include "FileHelper.hpp"
+#include "RandomGenerator.hpp"
 #include "TextHelper.hpp"
 #include "UnitTest.hpp"
 
@@ -7,6 +7,7 @@
 
 namespace erbsland::unittest {
 
+class RandomGenerator;
 class UnitTest;
 
 }
@@ -0,0 +1,302 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "AllocationHook.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if ERBSLAND_UNITTEST_ALLOCATION_HOOK
+#if defined(ERBSLAND_OS_WINDOWS)
+#include <malloc.h>
+#elif defined(ERBSLAND_OS_MACOS)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#endif
+
+namespace erbsland::unittest {
+
+namespace {
+
+std::atomic<bool> gCounting{false};             ///< If allocations are counted.
+std::atomic<std::int64_t> gCurrentBytes{0};     ///< The number of bytes currently allocated by the test.
+std::atomic<std::int64_t> gPeakBytes{0};        ///< The highest number of allocated bytes.
+std::atomic<std::int64_t> gLimitBytes{0};       ///< The memory limit, or zero if there is no limit.
+std::atomic<bool> gLimitExceeded{false};        ///< If an allocation exceeded the limit.
+std::atomic<std::size_t> gAllocations{0};       ///< The number of counted allocations.
+std::atomic<std::size_t> gFailingAllocation{0}; ///< The number of the allocation that fails, or zero.
+std::atomic<bool> gFailureInjected{false};      ///< If the failing allocation was reached.
+thread_local std::size_t gPauseDepth{0};        ///< The number of `Pause` instances in this thread.
+
+}
+
+#if ERBSLAND_UNITTEST_ALLOCATION_HOOK
+
+namespace {
+
+/// Update the peak with a new value.
+void updatePeak(const std::int64_t value) noexcept {
+    auto peak = gPeakBytes.load(std::memory_order_relaxed);
+    while (value > peak && !gPeakBytes.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {
+    }
+}
+
+/// Test if allocations of the calling thread are counted.
+auto isCounting() noexcept -> bool {
+    return gCounting.load(std::memory_order_relaxed) && gPauseDepth == 0;
+}
+
+/// Count an allocation.
+/// @return `false` if the allocation exceeds the memory limit.
+auto reserve(const std::size_t size) noexcept -> bool {
+    const auto bytes = static_cast<std::int64_t>(size);
+    const auto current = gCurrentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    updatePeak(current);
+    const auto limit = gLimitBytes.load(std::memory_order_relaxed);
+    if (limit > 0 && current > limit) {
+        gCurrentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        gLimitExceeded.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+/// Allocate memory from the system.
+auto rawAllocate(const std::size_t size, const std::size_t alignment) noexcept -> void * {
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size);
+    }
+#if defined(ERBSLAND_OS_WINDOWS)
+    return _aligned_malloc(size, alignment);
+#else
+    void *result = nullptr;
+    if (posix_memalign(&result, alignment, size) != 0) {
+        return nullptr;
+    }
+    return result;
+#endif
+}
+
+/// Free memory allocated with `rawAllocate`.
+void rawFree(void *ptr, [[maybe_unused]] const std::size_t alignment) noexcept {
+#if defined(ERBSLAND_OS_WINDOWS)
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(ptr);
+        return;
+    }
+#endif
+    std::free(ptr);
+}
+
+/// Get the real size of a memory block.
+auto usableSize(void *ptr, [[maybe_unused]] const std::size_t alignment) noexcept -> std::size_t {
+#if defined(ERBSLAND_OS_WINDOWS)
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return _aligned_msize(ptr, alignment, 0);
+    }
+    return _msize(ptr);
+#elif defined(ERBSLAND_OS_MACOS)
+    return malloc_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+/// Allocate memory for `operator new`.
+auto allocate(std::size_t size, const std::size_t alignment, const bool noThrow) -> void * {
+    if (size == 0) {
+        size = 1;
+    }
+    const auto counting = isCounting();
+    if (counting) {
+        const auto number = gAllocations.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (number == gFailingAllocation.load(std::memory_order_relaxed)) {
+            // An injected failure behaves like an exhausted system, without calling the new-handler.
+            gFailureInjected.store(true, std::memory_order_relaxed);
+            if (noThrow) {
+                return nullptr;
+            }
+            throw std::bad_alloc();
+        }
+    }
+    while (true) {
+        auto *ptr = rawAllocate(size, alignment);
+        if (ptr != nullptr) {
+            if (!counting || reserve(usableSize(ptr, alignment))) {
+                return ptr;
+            }
+            // Exceeding the limit is final, so the new-handler is not called.
+            rawFree(ptr, alignment);
+            updatePeak(gCurrentBytes.load(std::memory_order_relaxed) + static_cast<std::int64_t>(size));
+            if (noThrow) {
+                return nullptr;
+            }
+            throw std::bad_alloc();
+        }
+        auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            if (noThrow) {
+                return nullptr;
+            }
+            throw std::bad_alloc();
+        }
+        if (noThrow) {
+            try {
+                handler();
+            } catch (...) {
+                return nullptr;
+            }
+        } else {
+            handler();
+        }
+    }
+}
+
+/// Free memory for `operator delete`.
+void deallocate(void *ptr, const std::size_t alignment) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (isCounting()) {
+        gCurrentBytes.fetch_sub(static_cast<std::int64_t>(usableSize(ptr, alignment)), std::memory_order_relaxed);
+    }
+    rawFree(ptr, alignment);
+}
+
+}
+
+#endif
+
+AllocationHook::Pause::Pause() noexcept {
+    ++gPauseDepth;
+}
+
+AllocationHook::Pause::~Pause() {
+    --gPauseDepth;
+}
+
+auto AllocationHook::isAvailable() noexcept -> bool {
+#if ERBSLAND_UNITTEST_ALLOCATION_HOOK
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocationHook::startTest(const std::size_t memoryLimit, const std::size_t failingAllocation) noexcept {
+    gCounting.store(false, std::memory_order_relaxed);
+    gCurrentBytes.store(0, std::memory_order_relaxed);
+    gPeakBytes.store(0, std::memory_order_relaxed);
+    gLimitBytes.store(static_cast<std::int64_t>(memoryLimit), std::memory_order_relaxed);
+    gLimitExceeded.store(false, std::memory_order_relaxed);
+    gAllocations.store(0, std::memory_order_relaxed);
+    gFailingAllocation.store(failingAllocation, std::memory_order_relaxed);
+    gFailureInjected.store(false, std::memory_order_relaxed);
+    gCounting.store(isAvailable(), std::memory_order_seq_cst);
+}
+
+void AllocationHook::stopTest() noexcept {
+    gCounting.store(false, std::memory_order_seq_cst);
+    gLimitBytes.store(0, std::memory_order_relaxed);
+    gFailingAllocation.store(0, std::memory_order_relaxed);
+}
+
+auto AllocationHook::peakBytes() noexcept -> std::size_t {
+    return static_cast<std::size_t>(gPeakBytes.load(std::memory_order_relaxed));
+}
+
+auto AllocationHook::isLimitExceeded() noexcept -> bool {
+    return gLimitExceeded.load(std::memory_order_relaxed);
+}
+
+auto AllocationHook::allocationCount() noexcept -> std::size_t {
+    return gAllocations.load(std::memory_order_relaxed);
+}
+
+auto AllocationHook::currentBytes() noexcept -> std::int64_t {
+    return gCurrentBytes.load(std::memory_order_relaxed);
+}
+
+auto AllocationHook::isFailureInjected() noexcept -> bool {
+    return gFailureInjected.load(std::memory_order_relaxed);
+}
+
+}
+
+#if ERBSLAND_UNITTEST_ALLOCATION_HOOK
+
+// The replaced global allocation functions.
+// NOLINTBEGIN(*-new-delete-overloads)
+
+using erbsland::unittest::allocate;
+using erbsland::unittest::deallocate;
+
+constexpr auto cDefaultAlignment = static_cast<std::size_t>(__STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+auto operator new(std::size_t size) -> void * {
+    return allocate(size, cDefaultAlignment, false);
+}
+auto operator new[](std::size_t size) -> void * {
+    return allocate(size, cDefaultAlignment, false);
+}
+auto operator new(std::size_t size, const std::nothrow_t &) noexcept -> void * {
+    return allocate(size, cDefaultAlignment, true);
+}
+auto operator new[](std::size_t size, const std::nothrow_t &) noexcept -> void * {
+    return allocate(size, cDefaultAlignment, true);
+}
+auto operator new(std::size_t size, std::align_val_t alignment) -> void * {
+    return allocate(size, static_cast<std::size_t>(alignment), false);
+}
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void * {
+    return allocate(size, static_cast<std::size_t>(alignment), false);
+}
+auto operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept -> void * {
+    return allocate(size, static_cast<std::size_t>(alignment), true);
+}
+auto operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept -> void * {
+    return allocate(size, static_cast<std::size_t>(alignment), true);
+}
+void operator delete(void *ptr) noexcept {
+    deallocate(ptr, cDefaultAlignment);
+}
+void operator delete[](void *ptr) noexcept {
+    deallocate(ptr, cDefaultAlignment);
+}
+void operator delete(void *ptr, std::size_t) noexcept {
+    deallocate(ptr, cDefaultAlignment);
+}
+void operator delete[](void *ptr, std::size_t) noexcept {
+    deallocate(ptr, cDefaultAlignment);
+}
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr, cDefaultAlignment);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr, cDefaultAlignment);
+}
+void operator delete(void *ptr, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *ptr, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *ptr, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *ptr, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *ptr, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *ptr, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+// NOLINTEND(*-new-delete-overloads)
+
+#endif
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Only replace the global allocation functions, if enabled by the build.
+#ifndef ERBSLAND_UNITTEST_ALLOCATION_HOOK
+#define ERBSLAND_UNITTEST_ALLOCATION_HOOK 0
+#endif
+
+namespace erbsland::unittest {
+
+/// @internal
+/// Counts the memory allocated using `operator new` while a test runs, enforces a memory limit and injects
+/// allocation failures.
+///
+/// If the CMake option `ERBSLAND_UNITTEST_ALLOCATION_HOOK` is enabled, this library replaces the global
+/// `operator new` and `operator delete` functions. Outside of tests, they only check one flag and call `malloc()`
+/// and `free()`. Without the option, no allocation is counted and `isAvailable()` returns `false`.
+///
+class AllocationHook {
+public:
+    /// Excludes the allocations of this library from the counting, while an instance exists in this thread.
+    /// Memory that is allocated during a pause must also be freed during a pause.
+    class Pause final {
+    public:
+        /// ctor
+        Pause() noexcept;
+        /// dtor
+        ~Pause();
+        Pause(const Pause &) = delete;
+        auto operator=(const Pause &) -> Pause & = delete;
+    };
+
+public:
+    /// Test if the allocation hook is compiled into this library.
+    [[nodiscard]] static auto isAvailable() noexcept -> bool;
+    /// Start counting the allocations of a test.
+    /// @param memoryLimit The maximum number of bytes the test may allocate, or zero for no limit.
+    /// @param failingAllocation The number of the allocation that fails, starting with 1, or zero.
+    static void startTest(std::size_t memoryLimit, std::size_t failingAllocation = 0) noexcept;
+    /// Stop counting the allocations.
+    static void stopTest() noexcept;
+    /// The highest number of bytes, allocated by the test at the same time.
+    /// If an allocation exceeded the limit, this is the size that was requested at this point.
+    [[nodiscard]] static auto peakBytes() noexcept -> std::size_t;
+    /// Test if an allocation failed, because it exceeded the memory limit.
+    [[nodiscard]] static auto isLimitExceeded() noexcept -> bool;
+    /// The number of allocations made by the test, including a failed one.
+    [[nodiscard]] static auto allocationCount() noexcept -> std::size_t;
+    /// The number of bytes allocated by the test, that are not freed.
+    /// This is negative if the test freed more memory than it allocated.
+    [[nodiscard]] static auto currentBytes() noexcept -> std::int64_t;
+    /// Test if the failing allocation was reached and failed.
+    [[nodiscard]] static auto isFailureInjected() noexcept -> bool;
+};
+
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "ApproxComparison.hpp"
+
+#include <vector>
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// The highest ULP distance for each bucket of the error histogram, without the last bucket for NaN and infinities.
+constexpr std::array<std::uint64_t, cApproxHistogramSize - 1> cHistogramLimits{
+    0, 1, 4, 16, 256, 65'536, std::numeric_limits<std::uint64_t>::max()};
+/// The labels for the buckets of the error histogram.
+constexpr std::array<std::string_view, cApproxHistogramSize> cHistogramLabels{
+    "0 ULPs", "1 ULP", "2-4 ULPs", "5-16 ULPs", "17-256 ULPs", "257-65536 ULPs", ">65536 ULPs", "NaN/infinite"};
+
+/// The vectorized kernel, that counts the elements outside the tolerance.
+/// The loop has no early exit and no branches that depend on the values, so compilers can vectorize it.
+template <typename T>
+auto countFailures(const std::span<const T> a, const std::span<const T> b, const Tolerance &tolerance) noexcept
+    -> std::size_t {
+    const auto size = std::min(a.size(), b.size());
+    const auto *valuesA = a.data();
+    const auto *valuesB = b.data();
+    const auto localTolerance = tolerance;
+    std::size_t failures = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        failures += approxEqual(valuesA[i], valuesB[i], localTolerance) ? 0U : 1U;
+    }
+    return failures;
+}
+
+}
+
+auto Tolerance::toText() const -> std::string {
+    std::vector<std::string> parts;
+    if (absolute > 0.0) {
+        parts.push_back(std::format("absolute {}", absolute));
+    }
+    if (relative > 0.0) {
+        parts.push_back(std::format("relative {}", relative));
+    }
+    if (ulps > 0) {
+        parts.push_back(std::format("{} ULPs", ulps));
+    }
+    if (parts.empty()) {
+        parts.emplace_back("exact");
+    }
+    if (matchNaN) {
+        parts.emplace_back("NaN matches NaN");
+    }
+    if (!matchInfinity) {
+        parts.emplace_back("infinities never match");
+    }
+    std::string result;
+    for (const auto &part : parts) {
+        if (!result.empty()) {
+            result += ", ";
+        }
+        result += part;
+    }
+    return result;
+}
+
+auto approxFailureCount(const std::span<const float> a, const std::span<const float> b, const Tolerance &tolerance)
+    -> std::size_t {
+    return countFailures(a, b, tolerance);
+}
+
+auto approxFailureCount(const std::span<const double> a, const std::span<const double> b, const Tolerance &tolerance)
+    -> std::size_t {
+    return countFailures(a, b, tolerance);
+}
+
+auto approxHistogramBucket(const std::uint64_t ulps, const bool isSpecial) noexcept -> std::size_t {
+    if (isSpecial) {
+        return cApproxHistogramSize - 1;
+    }
+    const auto it = std::ranges::lower_bound(cHistogramLimits, ulps);
+    return static_cast<std::size_t>(it - cHistogramLimits.begin());
+}
+
+auto approxMismatchMessage(const ApproxMismatch &mismatch,
+    const Tolerance &tolerance,
+    const std::string_view aExpr,
+    const std::string_view bExpr) -> std::string {
+
+    const auto comparedCount = std::min(mismatch.sizeA, mismatch.sizeB);
+    std::string result;
+    if (mismatch.failureCount > 0) {
+        result = std::format("Ranges differ: {} of {} compared elements are outside the tolerance.",
+            mismatch.failureCount,
+            comparedCount);
+        if (mismatch.sizeA != mismatch.sizeB) {
+            result += std::format("\n  Sizes: A has {} elements, B has {} elements.", mismatch.sizeA, mismatch.sizeB);
+        }
+    } else {
+        result = std::format("Ranges differ in size: A has {} elements, B has {} elements.",
+            mismatch.sizeA,
+            mismatch.sizeB);
+    }
+    result += std::format("\n  Tolerance: {}", tolerance.toText());
+    if (mismatch.failureCount > 0) {
+        result += std::format(
+            "\n  First at index {}: {} != {}", mismatch.firstIndex, mismatch.firstA, mismatch.firstB);
+        result += std::format("\n  Worst at index {}: {} != {}", mismatch.worstIndex, mismatch.worstA, mismatch.worstB);
+        if (std::isnan(mismatch.worstError)) {
+            result += " (NaN or infinite value)";
+        } else {
+            result += std::format(" (error {}, {} ULPs)", mismatch.worstError, mismatch.worstUlps);
+        }
+    }
+    if (comparedCount > 0) {
+        result += "\n  Error histogram:";
+        for (std::size_t i = 0; i < cApproxHistogramSize; ++i) {
+            if (mismatch.histogram[i] > 0) {
+                result += std::format("\n    {:>14}: {}", cHistogramLabels[i], mismatch.histogram[i]);
+            }
+        }
+    }
+    result += std::format("\n  A: {}\n  B: {}", aExpr, bExpr);
+    return result;
+}
+
+}
@@ -0,0 +1,366 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "AssertContext.hpp"
+#include "SourceLocation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace erbsland::unittest {
+
+class UnitTest;
+
+/// The tolerance for approximate comparisons of floating-point values.
+///
+/// Two finite values match, if their difference is within *any* of the given tolerances. A tolerance of zero is
+/// not used, so the default tolerance only accepts equal values.
+///
+struct Tolerance {
+    double absolute{0.0};     ///< The maximum absolute difference.
+    double relative{0.0};     ///< The maximum difference, relative to the larger magnitude of both values.
+    std::uint64_t ulps{0};    ///< The maximum distance in units in the last place.
+    bool matchNaN{false};     ///< If a NaN matches a NaN. Otherwise, a NaN never matches.
+    bool matchInfinity{true}; ///< If an infinity matches one with the same sign. Otherwise, it never matches.
+
+    /// Get a description of this tolerance for error messages.
+    [[nodiscard]] auto toText() const -> std::string;
+};
+
+/// The number of buckets in the error histogram.
+constexpr std::size_t cApproxHistogramSize = 8;
+
+/// @internal
+/// The details of two ranges that do not match within the tolerance.
+struct ApproxMismatch {
+    std::size_t sizeA{0};                                       ///< The number of elements in the first range.
+    std::size_t sizeB{0};                                       ///< The number of elements in the second range.
+    std::size_t failureCount{0};                                ///< The number of elements outside the tolerance.
+    std::size_t firstIndex{0};                                  ///< The index of the first element outside.
+    std::string firstA;                                         ///< The first value in the first range.
+    std::string firstB;                                         ///< The first value in the second range.
+    std::size_t worstIndex{0};                                  ///< The index of the element with the most ULPs.
+    std::string worstA;                                         ///< The worst value in the first range.
+    std::string worstB;                                         ///< The worst value in the second range.
+    double worstError{0.0};                                     ///< The absolute error of the worst element.
+    std::uint64_t worstUlps{0};                                 ///< The ULP distance of the worst element.
+    std::array<std::size_t, cApproxHistogramSize> histogram{}; ///< The number of elements for each error bucket.
+};
+
+/// @internal
+/// Test if a value is NaN, in a way that allows vectorized loops.
+template <typename T>
+[[nodiscard]] constexpr auto isApproxNaN(const T value) noexcept -> bool {
+    return value != value; // NOLINT(misc-redundant-expression)
+}
+
+/// @internal
+/// Test if a value is infinite, in a way that allows vectorized loops.
+template <typename T>
+[[nodiscard]] constexpr auto isApproxInfinity(const T value) noexcept -> bool {
+    return std::fabs(value) == std::numeric_limits<T>::infinity();
+}
+
+/// @internal
+/// The unsigned integer type with the same size as a floating-point type.
+template <typename T>
+using ApproxBits = std::conditional_t<std::is_same_v<T, float>, std::uint32_t, std::uint64_t>;
+
+/// @internal
+/// Get the distance of two finite values in units in the last place, as integer with the size of the values.
+/// The bits of each value are mapped to an integer, that has the same order as the values. Positive and negative
+/// zero have the same integer.
+template <typename T>
+[[nodiscard]] constexpr auto orderedDistance(const T a, const T b) noexcept -> ApproxBits<T> {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Only `float` and `double` are supported.");
+    using UInt = ApproxBits<T>;
+    using Int = std::make_signed_t<UInt>;
+    auto ordered = [](const T value) -> UInt {
+        const auto bits = std::bit_cast<Int>(value);
+        const auto mask = static_cast<Int>(bits >> (sizeof(Int) * 8 - 1));
+        return static_cast<UInt>((bits ^ (mask & std::numeric_limits<Int>::max())) - mask);
+    };
+    const auto orderedA = ordered(a);
+    const auto orderedB = ordered(b);
+    // The distance of two signed integers, calculated with unsigned integers to avoid an overflow.
+    const auto isALess = static_cast<Int>(orderedA) < static_cast<Int>(orderedB);
+    return isALess ? orderedB - orderedA : orderedA - orderedB;
+}
+
+/// Get the distance of two finite values in units in the last place.
+template <typename T>
+[[nodiscard]] constexpr auto ulpDistance(const T a, const T b) noexcept -> std::uint64_t {
+    return static_cast<std::uint64_t>(orderedDistance(a, b));
+}
+
+/// Test if two values match within the tolerance.
+/// The function has no branches that depend on the values, so loops using it can be vectorized.
+/// @param a The first value.
+/// @param b The second value.
+/// @param tolerance The tolerance.
+template <typename T>
+[[nodiscard]] constexpr auto approxEqual(const T a, const T b, const Tolerance &tolerance) noexcept -> bool {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Only `float` and `double` are supported.");
+    // Compare the ULPs with the size of the values, so the loops for `float` can use more lanes.
+    const auto maximumUlps = static_cast<ApproxBits<T>>(
+        std::min<std::uint64_t>(tolerance.ulps, std::numeric_limits<ApproxBits<T>>::max()));
+    const bool isNaN = isApproxNaN(a) | isApproxNaN(b);
+    const bool isInfinity = isApproxInfinity(a) | isApproxInfinity(b);
+    const auto difference = std::fabs(a - b);
+    const auto magnitude = std::max(std::fabs(a), std::fabs(b));
+    const bool isWithin = (difference <= static_cast<T>(tolerance.absolute)) |
+        (difference <= static_cast<T>(tolerance.relative) * magnitude) | (orderedDistance(a, b) <= maximumUlps);
+    const bool nanMatches = tolerance.matchNaN & isApproxNaN(a) & isApproxNaN(b);
+    const bool infinityMatches = tolerance.matchInfinity & (a == b);
+    // Combine the cases with bit operations, as conditional expressions prevent the vectorization.
+    return (!(isNaN | isInfinity) & isWithin) | (isNaN & nanMatches) | (!isNaN & isInfinity & infinityMatches);
+}
+
+/// @internal
+/// Count the elements of two arrays, that do not match within the tolerance.
+/// This is the vectorized kernel for contiguous ranges of `float` values.
+[[nodiscard]] auto approxFailureCount(std::span<const float> a, std::span<const float> b, const Tolerance &tolerance)
+    -> std::size_t;
+
+/// @internal
+/// Count the elements of two arrays, that do not match within the tolerance.
+/// This is the vectorized kernel for contiguous ranges of `double` values.
+[[nodiscard]] auto approxFailureCount(std::span<const double> a, std::span<const double> b, const Tolerance &tolerance)
+    -> std::size_t;
+
+/// @internal
+/// Get the bucket of the error histogram for an error.
+/// @param ulps The distance in ULPs.
+/// @param isSpecial If one of the values is NaN or infinite.
+[[nodiscard]] auto approxHistogramBucket(std::uint64_t ulps, bool isSpecial) noexcept -> std::size_t;
+
+/// @internal
+/// The floating-point type, that is used to compare two values of the given types.
+template <typename A, typename B>
+using ApproxValue = std::conditional_t<std::is_same_v<std::common_type_t<A, B>, float>, float, double>;
+
+/// Generates the error message for two values that do not match within the tolerance.
+/// @param a The first value.
+/// @param b The second value.
+/// @param tolerance The tolerance.
+/// @param aExpr The textual representation of the first value.
+/// @param bExpr The textual representation of the second value.
+template <typename T>
+[[nodiscard]] auto approxErrorMessage(
+    const T a, const T b, const Tolerance &tolerance, const std::string_view aExpr, const std::string_view bExpr)
+    -> std::string {
+
+    std::string result = std::format("Approximate comparison failed: {} != {}", a, b);
+    if (isApproxNaN(a) || isApproxNaN(b) || isApproxInfinity(a) || isApproxInfinity(b)) {
+        result += " (NaN or infinite value)";
+    } else {
+        result += std::format(" (error {}, {} ULPs)", std::fabs(a - b), ulpDistance(a, b));
+    }
+    result += std::format("\n  Tolerance: {}", tolerance.toText());
+    result += std::format("\n  A: {} => {}", aExpr, a);
+    result += std::format("\n  B: {} => {}", bExpr, b);
+    return result;
+}
+
+/// Generates the error message for two ranges that do not match within the tolerance.
+/// @param mismatch The details of the difference.
+/// @param tolerance The tolerance.
+/// @param aExpr The textual representation of the first range.
+/// @param bExpr The textual representation of the second range.
+[[nodiscard]] auto approxMismatchMessage(
+    const ApproxMismatch &mismatch, const Tolerance &tolerance, std::string_view aExpr, std::string_view bExpr)
+    -> std::string;
+
+/// @internal
+/// Test if two ranges can be compared with the vectorized kernel.
+template <typename A, typename B>
+constexpr bool can_use_approx_kernel = [] {
+    if constexpr (std::ranges::contiguous_range<A> && std::ranges::contiguous_range<B> &&
+                  std::ranges::sized_range<A> && std::ranges::sized_range<B>) {
+        using ElementA = std::remove_cv_t<std::ranges::range_value_t<A>>;
+        using ElementB = std::remove_cv_t<std::ranges::range_value_t<B>>;
+        return std::is_same_v<ElementA, ElementB> &&
+            (std::is_same_v<ElementA, float> || std::is_same_v<ElementA, double>);
+    } else {
+        return false;
+    }
+}();
+
+/// Test if two ranges have the same size, and all elements match within the tolerance.
+/// Contiguous ranges of `float` or `double` values are compared with a vectorized kernel.
+template <typename A, typename B>
+[[nodiscard]] auto rangesApproxEqual(const A &a, const B &b, const Tolerance &tolerance) -> bool {
+    if constexpr (can_use_approx_kernel<A, B>) {
+        if (std::ranges::size(a) != std::ranges::size(b)) {
+            return false;
+        }
+        return approxFailureCount(std::span{std::ranges::data(a), std::ranges::size(a)},
+                   std::span{std::ranges::data(b), std::ranges::size(b)},
+                   tolerance) == 0;
+    } else {
+        using Value = ApproxValue<std::ranges::range_value_t<A>, std::ranges::range_value_t<B>>;
+        auto itA = std::ranges::begin(a);
+        auto itB = std::ranges::begin(b);
+        for (; itA != std::ranges::end(a) && itB != std::ranges::end(b); ++itA, ++itB) {
+            if (!approxEqual(static_cast<Value>(*itA), static_cast<Value>(*itB), tolerance)) {
+                return false;
+            }
+        }
+        return itA == std::ranges::end(a) && itB == std::ranges::end(b);
+    }
+}
+
+/// Collect the details of two ranges that do not match within the tolerance.
+template <typename A, typename B>
+[[nodiscard]] auto rangesApproxMismatch(const A &a, const B &b, const Tolerance &tolerance) -> ApproxMismatch {
+    using Value = ApproxValue<std::ranges::range_value_t<A>, std::ranges::range_value_t<B>>;
+    ApproxMismatch result;
+    result.sizeA = static_cast<std::size_t>(std::ranges::distance(a));
+    result.sizeB = static_cast<std::size_t>(std::ranges::distance(b));
+    bool hasWorst = false;
+    std::size_t index = 0;
+    auto itA = std::ranges::begin(a);
+    auto itB = std::ranges::begin(b);
+    for (; itA != std::ranges::end(a) && itB != std::ranges::end(b); ++itA, ++itB, ++index) {
+        const auto valueA = static_cast<Value>(*itA);
+        const auto valueB = static_cast<Value>(*itB);
+        const bool isSpecial = isApproxNaN(valueA) || isApproxNaN(valueB) || isApproxInfinity(valueA) ||
+            isApproxInfinity(valueB);
+        const auto ulps = isSpecial ? std::numeric_limits<std::uint64_t>::max() : ulpDistance(valueA, valueB);
+        result.histogram[approxHistogramBucket(ulps, isSpecial)] += 1;
+        if (approxEqual(valueA, valueB, tolerance)) {
+            continue;
+        }
+        if (result.failureCount == 0) {
+            result.firstIndex = index;
+            result.firstA = std::format("{}", valueA);
+            result.firstB = std::format("{}", valueB);
+        }
+        ++result.failureCount;
+        if (!hasWorst || ulps > result.worstUlps) {
+            hasWorst = true;
+            result.worstIndex = index;
+            result.worstA = std::format("{}", valueA);
+            result.worstB = std::format("{}", valueB);
+            result.worstError =
+                isSpecial ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(std::fabs(valueA - valueB));
+            result.worstUlps = ulps;
+        }
+    }
+    return result;
+}
+
+/// Verifies that two floating-point values match within the tolerance.
+/// @tparam FuncA A callable returning the first value.
+/// @tparam FuncB A callable returning the second value.
+/// @tparam FuncTolerance A callable returning the tolerance.
+/// @param test The UnitTest instance in which this check is running.
+/// @param flags Flags that modify assertion behavior.
+/// @param macroName The name of the macro that invoked this check (e.g. "REQUIRE_APPROX").
+/// @param expr The textual representation of both values and the tolerance.
+/// @param loc The source location where the check was invoked.
+/// @param aExpr The textual representation of the first value.
+/// @param bExpr The textual representation of the second value.
+/// @param funcA Callable that returns the first value.
+/// @param funcB Callable that returns the second value.
+/// @param funcTolerance Callable that returns the tolerance.
+template <typename FuncA, typename FuncB, typename FuncTolerance>
+void requireApprox(UnitTest *test,
+    const int flags,
+    const char *macroName,
+    const char *expr,
+    const SourceLocation loc,
+    const char *aExpr,
+    const char *bExpr,
+    FuncA &&funcA,
+    FuncB &&funcB,
+    FuncTolerance &&funcTolerance) {
+    AssertContext ctx{test, flags, macroName, expr, loc};
+    try {
+        const auto a = funcA();
+        const auto b = funcB();
+        const Tolerance tolerance = funcTolerance();
+        using Value = ApproxValue<decltype(a), decltype(b)>;
+        if (approxEqual(static_cast<Value>(a), static_cast<Value>(b), tolerance)) {
+            ctx.expectedResult();
+        } else {
+            ctx.exceptionType = "requireComparison";
+            ctx.exceptionMessage =
+                approxErrorMessage(static_cast<Value>(a), static_cast<Value>(b), tolerance, aExpr, bExpr);
+            ctx.unexpectedResult();
+        }
+    } catch (const AssertFailed &) {
+        throw;
+    } catch (const std::exception &ex) {
+        ctx.exceptionType = std::string(typeid(ex).name());
+        ctx.exceptionMessage = std::string(ex.what());
+        ctx.unexpectedException();
+    } catch (...) {
+        ctx.unexpectedException();
+    }
+}
+
+/// Verifies that two ranges have the same size, and all elements match within the tolerance.
+/// On failure, the message shows the number of elements outside the tolerance, the first and the worst of them,
+/// and a histogram of the errors in ULPs.
+/// @tparam FuncA A callable returning the first range.
+/// @tparam FuncB A callable returning the second range.
+/// @tparam FuncTolerance A callable returning the tolerance.
+/// @param test The UnitTest instance in which this check is running.
+/// @param flags Flags that modify assertion behavior.
+/// @param macroName The name of the macro that invoked this check (e.g. "REQUIRE_RANGES_APPROX").
+/// @param expr The textual representation of both ranges and the tolerance.
+/// @param loc The source location where the check was invoked.
+/// @param aExpr The textual representation of the first range.
+/// @param bExpr The textual representation of the second range.
+/// @param funcA Callable that returns the first range.
+/// @param funcB Callable that returns the second range.
+/// @param funcTolerance Callable that returns the tolerance.
+template <typename FuncA, typename FuncB, typename FuncTolerance>
+void requireRangesApprox(UnitTest *test,
+    const int flags,
+    const char *macroName,
+    const char *expr,
+    const SourceLocation loc,
+    const char *aExpr,
+    const char *bExpr,
+    FuncA &&funcA,
+    FuncB &&funcB,
+    FuncTolerance &&funcTolerance) {
+    AssertContext ctx{test, flags, macroName, expr, loc};
+    try {
+        decltype(auto) a = funcA();
+        decltype(auto) b = funcB();
+        const Tolerance tolerance = funcTolerance();
+        if (rangesApproxEqual(a, b, tolerance)) {
+            ctx.expectedResult();
+        } else {
+            ctx.exceptionType = "requireComparison";
+            ctx.exceptionMessage =
+                approxMismatchMessage(rangesApproxMismatch(a, b, tolerance), tolerance, aExpr, bExpr);
+            ctx.unexpectedResult();
+        }
+    } catch (const AssertFailed &) {
+        throw;
+    } catch (const std::exception &ex) {
+        ctx.exceptionType = std::string(typeid(ex).name());
+        ctx.exceptionMessage = std::string(ex.what());
+        ctx.unexpectedException();
+    } catch (...) {
+        ctx.unexpectedException();
+    }
+}
+
+}
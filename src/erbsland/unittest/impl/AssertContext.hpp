@@ -4,8 +4,12 @@
 
 #include "AssertFailed.hpp"
 #include "ConsoleLine.hpp"
+#include "ContainerDiff.hpp"
 #include "SourceLocation.hpp"
+#include "StringDiff.hpp"
+#include "ValueText.hpp"
 
+#include <chrono>
 #include <format>
 #include <functional>
 #include <string>
@@ -37,13 +41,15 @@ public:
     auto toString() -> std::string;
 
 public:
-    UnitTest *unitTest;            ///< Unittest for this context.
-    int flags;                     ///< The flags.
-    const char *macroName;         ///< The current name of the macro evaluating an expression.
-    const char *expression;        ///< The current expression which was evaluated.
-    SourceLocation sourceLocation; ///< The source location.
-    std::string exceptionType;     ///< The type of the exception
-    std::string exceptionMessage;  ///< The `what()` message of the exception.
+    UnitTest *unitTest;                                ///< Unittest for this context.
+    int flags;                                         ///< The flags.
+    const char *macroName;                             ///< The current name of the macro evaluating an expression.
+    const char *expression;                            ///< The current expression which was evaluated.
+    SourceLocation sourceLocation;                     ///< The source location.
+    std::string exceptionType;                         ///< The type of the exception
+    std::string exceptionMessage;                      ///< The `what()` message of the exception.
+    std::chrono::steady_clock::time_point startTime{}; ///< The start time, if assertion statistics are enabled.
+    std::chrono::nanoseconds nestedTime{};             ///< The time spent in nested assertions.
 };
 
 /// Executes a test evaluation and handles the result, including exceptions.
@@ -79,12 +85,9 @@ void require(
     }
 }
 
-/// Test if a type can be formatted using `std::format`.
-/// @tparam T The tested type.
-template <typename T>
-constexpr bool is_formattable = std::is_default_constructible_v<std::formatter<std::remove_cvref_t<T>, char>>;
-
 /// Generates a detailed error message for a failed comparison.
+/// If two containers are compared for equality, the message lists the differences of the containers. For long
+/// strings, the message shows the text around the first difference.
 /// @tparam A The type of the first argument.
 /// @tparam B The type of the second argument.
 /// @param opExpr The textual representation of the comparison operator.
@@ -100,6 +103,20 @@ auto comparisonErrorMessage(const std::string_view opExpr,
     const A &aValue,
     const B &bValue) -> std::string {
 
+    if constexpr (is_diff_string<A> && is_diff_string<B>) {
+        const auto a = diffStringView(aValue);
+        const auto b = diffStringView(bValue);
+        const bool isShownCompletely = is_formattable<A> && is_formattable<B> && a.size() < cStringDiffMinimumSize &&
+            b.size() < cStringDiffMinimumSize;
+        if (opExpr == "==" && !isShownCompletely) {
+            return stringDiffMessage(a, b, aExpr, bExpr);
+        }
+    }
+    if constexpr (can_diff_containers<A, B>) {
+        if (opExpr == "==") {
+            return containerDiffMessage(containerDiff(aValue, bValue), aExpr, bExpr);
+        }
+    }
     constexpr std::size_t maxLen = 80;
     std::string result = "Comparison failed: ";
 
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "AssertStats.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// The key for an assertion, using the addresses of the string literals from the macros.
+struct SiteKey {
+    const char *file{nullptr};      ///< The source file.
+    int lineNo{0};                  ///< The line in the source file.
+    const char *macroName{nullptr}; ///< The name of the macro.
+
+    auto operator==(const SiteKey &other) const noexcept -> bool = default;
+};
+
+/// The hash for an assertion key.
+struct SiteKeyHash {
+    auto operator()(const SiteKey &key) const noexcept -> std::size_t {
+        auto hash = std::hash<const void *>{}(key.file);
+        hash ^= std::hash<int>{}(key.lineNo) + 0x9e37'79b9U + (hash << 6U) + (hash >> 2U);
+        hash ^= std::hash<const void *>{}(key.macroName) + 0x9e37'79b9U + (hash << 6U) + (hash >> 2U);
+        return hash;
+    }
+};
+
+/// The counter for an assertion.
+struct SiteCounter {
+    std::uint64_t count{0};          ///< The number of executions.
+    std::chrono::nanoseconds time{}; ///< The time spent in the executions.
+};
+
+bool gEnabled{false};                                              ///< If the statistics are enabled.
+std::unordered_map<SiteKey, SiteCounter, SiteKeyHash> gCounters{}; ///< The counters of this process.
+std::vector<AssertStats::Site> gReceivedSites{};                   ///< The statistics sent by child processes.
+
+}
+
+void AssertStats::enable() noexcept {
+    gEnabled = true;
+}
+
+auto AssertStats::isEnabled() noexcept -> bool {
+    return gEnabled;
+}
+
+void AssertStats::add(
+    const SourceLocation &sourceLocation, const char *macroName, const std::chrono::nanoseconds time) noexcept {
+    try {
+        const auto key = SiteKey{.file = sourceLocation.file, .lineNo = sourceLocation.lineNo, .macroName = macroName};
+        auto &counter = gCounters[key];
+        counter.count += 1;
+        counter.time += time;
+    } catch (...) {
+        // Missing statistics must not fail the test.
+    }
+}
+
+void AssertStats::serialize(std::string &message) {
+    for (const auto &[key, counter] : gCounters) {
+        message += std::format("{}\t{}\t{}\t{}\t{}\n",
+            key.file != nullptr ? key.file : "",
+            key.lineNo,
+            key.macroName != nullptr ? key.macroName : "",
+            counter.count,
+            counter.time.count());
+    }
+    gCounters.clear();
+}
+
+void AssertStats::deserialize(std::string_view message) {
+    while (!message.empty()) {
+        const auto end = message.find('\n');
+        if (end == std::string_view::npos) {
+            return;
+        }
+        std::stringstream line{std::string{message.substr(0, end)}};
+        message.remove_prefix(end + 1);
+        Site site;
+        std::int64_t time = 0;
+        if (!std::getline(line, site.file, '\t') || !(line >> site.lineNo) || !line.ignore() ||
+            !std::getline(line, site.macroName, '\t') || !(line >> site.count >> time)) {
+            continue;
+        }
+        site.time = std::chrono::nanoseconds{time};
+        gReceivedSites.push_back(std::move(site));
+    }
+}
+
+auto AssertStats::sites() -> std::vector<Site> {
+    // Merge by the text, as the same file can have different addresses in the compilation units.
+    std::map<std::tuple<std::string, int, std::string>, SiteCounter> merged;
+    for (const auto &[key, counter] : gCounters) {
+        auto &entry = merged[{
+            key.file != nullptr ? key.file : "", key.lineNo, key.macroName != nullptr ? key.macroName : ""}];
+        entry.count += counter.count;
+        entry.time += counter.time;
+    }
+    for (const auto &site : gReceivedSites) {
+        auto &entry = merged[{site.file, site.lineNo, site.macroName}];
+        entry.count += site.count;
+        entry.time += site.time;
+    }
+    std::vector<Site> result;
+    result.reserve(merged.size());
+    for (const auto &[key, counter] : merged) {
+        result.push_back(Site{
+            .file = std::get<0>(key),
+            .lineNo = std::get<1>(key),
+            .macroName = std::get<2>(key),
+            .count = counter.count,
+            .time = counter.time});
+    }
+    std::ranges::stable_sort(result, [](const Site &a, const Site &b) -> bool { return a.time > b.time; });
+    return result;
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+#include "SourceLocation.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// Counts how often each assertion in the tests is executed, and how much time it takes.
+///
+/// An assertion is identified by its source location and the name of its macro. The time of nested assertions,
+/// like `REQUIRE` in a `WITH_CONTEXT` block, is only added to the innermost assertion. The statistics are only
+/// collected if they were enabled, otherwise the assertions only check one flag.
+///
+class AssertStats {
+public:
+    /// The statistics for one assertion.
+    struct Site {
+        std::string file;                ///< The source file.
+        int lineNo{0};                   ///< The line in the source file.
+        std::string macroName;           ///< The name of the macro.
+        std::uint64_t count{0};          ///< The number of executions.
+        std::chrono::nanoseconds time{}; ///< The time spent in the executions.
+    };
+
+public:
+    /// Enable the statistics.
+    static void enable() noexcept;
+    /// Test if the statistics are enabled.
+    [[nodiscard]] static auto isEnabled() noexcept -> bool;
+    /// Add one execution of an assertion.
+    /// @param sourceLocation The source location of the assertion.
+    /// @param macroName The name of the macro.
+    /// @param time The time spent in the assertion, without the time of nested assertions.
+    static void add(
+        const SourceLocation &sourceLocation, const char *macroName, std::chrono::nanoseconds time) noexcept;
+    /// Serialize the collected statistics into a message, to send them from a child process, and reset them.
+    static void serialize(std::string &message);
+    /// Add the statistics from a message, that was sent by a child process.
+    static void deserialize(std::string_view message);
+    /// Get the statistics of all assertions, sorted by time, starting with the longest one.
+    [[nodiscard]] static auto sites() -> std::vector<Site>;
+};
+
+}
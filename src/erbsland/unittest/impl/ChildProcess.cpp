@@ -0,0 +1,337 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "ChildProcess.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#ifndef ERBSLAND_OS_WINDOWS
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace erbsland::unittest {
+
+#ifndef ERBSLAND_OS_WINDOWS
+
+namespace {
+
+/// The exit code of a child process, if the child function threw an exception.
+constexpr int cChildFailedExitCode = 121;
+/// The frame type for a message.
+constexpr char cMessageFrame = 'M';
+/// The frame type for the result.
+constexpr char cResultFrame = 'R';
+
+/// The write end of the pipe in a child process, or -1 in the parent process.
+int gChildPipe = -1;
+
+/// Write all data to a file descriptor.
+void writeAll(const int fd, const void *data, std::size_t size) noexcept {
+    auto bytes = static_cast<const char *>(data);
+    while (size > 0) {
+        const auto written = ::write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+/// Read all data from two file descriptors, until both streams end.
+/// @param resultFd The stream with the frames from the child.
+/// @param errorFd The stream with the error output of the child, or -1.
+/// @param result The string that receives the frames.
+/// @param errorOutput The string that receives the error output.
+void readAll(const int resultFd, const int errorFd, std::string &result, std::string &errorOutput) {
+    std::array<pollfd, 2> pollFds{};
+    pollFds[0] = pollfd{.fd = resultFd, .events = POLLIN, .revents = 0};
+    pollFds[1] = pollfd{.fd = errorFd, .events = POLLIN, .revents = 0};
+    std::array<char, 4096> buffer{};
+    while (pollFds[0].fd >= 0 || pollFds[1].fd >= 0) {
+        if (::poll(pollFds.data(), static_cast<nfds_t>(pollFds.size()), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (std::size_t i = 0; i < pollFds.size(); ++i) {
+            if (pollFds[i].fd < 0 || pollFds[i].revents == 0) {
+                continue;
+            }
+            const auto received = ::read(pollFds[i].fd, buffer.data(), buffer.size());
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                pollFds[i].fd = -1; // The stream ended, ignore it from now on.
+                continue;
+            }
+            (i == 0 ? result : errorOutput).append(buffer.data(), static_cast<std::size_t>(received));
+        }
+    }
+}
+
+/// Write a frame with a type, the size and the data.
+void writeFrame(const int fd, const char type, const std::string &data) noexcept {
+    const auto size = static_cast<std::uint64_t>(data.size());
+    writeAll(fd, &type, sizeof(type));
+    writeAll(fd, &size, sizeof(size));
+    writeAll(fd, data.data(), data.size());
+}
+
+/// Flush all output streams, so buffered output is not written twice after the fork.
+void flushAllStreams() {
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+}
+
+/// How the output of a child process is handled.
+enum class OutputMode : std::uint8_t {
+    Keep,    ///< The child writes to the console.
+    Capture, ///< The error output is captured.
+    Discard, ///< All output is discarded.
+};
+
+/// A started child process.
+struct RunningChild {
+    pid_t pid{-1};    ///< The process ID.
+    int resultFd{-1}; ///< The read end of the pipe with the frames.
+    int errorFd{-1};  ///< The read end of the pipe with the error output, or -1.
+};
+
+/// Start a child process, that calls the given function.
+auto startChild(const std::function<std::string()> &childFunction, const OutputMode outputMode) -> RunningChild {
+    std::array<int, 2> fds{};
+    std::array<int, 2> errorFds{-1, -1};
+    if (::pipe(fds.data()) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Could not create a pipe for the child process");
+    }
+    if (outputMode == OutputMode::Capture && ::pipe(errorFds.data()) != 0) {
+        const auto error = errno;
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::system_error(error, std::generic_category(), "Could not create a pipe for the child process");
+    }
+    // Do not leak the pipes into processes that are started by the tests.
+    for (const auto fd : {fds[0], fds[1], errorFds[0], errorFds[1]}) {
+        if (fd >= 0) {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    }
+    flushAllStreams();
+    const auto pid = ::fork();
+    if (pid < 0) {
+        const auto error = errno;
+        for (const auto fd : {fds[0], fds[1], errorFds[0], errorFds[1]}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        throw std::system_error(error, std::generic_category(), "Could not create the child process");
+    }
+    if (pid == 0) {
+        ::close(fds[0]);
+        if (outputMode == OutputMode::Capture) {
+            ::close(errorFds[0]);
+            ::dup2(errorFds[1], STDERR_FILENO);
+            ::close(errorFds[1]);
+        } else if (outputMode == OutputMode::Discard) {
+            if (const auto nullFd = ::open("/dev/null", O_WRONLY); nullFd >= 0) {
+                ::dup2(nullFd, STDOUT_FILENO);
+                ::dup2(nullFd, STDERR_FILENO);
+                ::close(nullFd);
+            }
+        }
+        gChildPipe = fds[1];
+        std::string result;
+        try {
+            result = childFunction();
+        } catch (...) {
+            flushAllStreams();
+            ::_exit(cChildFailedExitCode);
+        }
+        flushAllStreams();
+        writeFrame(fds[1], cResultFrame, result);
+        ::close(fds[1]);
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+    if (outputMode == OutputMode::Capture) {
+        ::close(errorFds[1]);
+    }
+    return RunningChild{.pid = pid, .resultFd = fds[0], .errorFd = errorFds[0]};
+}
+
+/// Wait until a child process terminates, and get its outcome.
+auto finishChild(const RunningChild &child) -> ChildProcess::Outcome {
+    ChildProcess::Outcome outcome;
+    std::string received;
+    readAll(child.resultFd, child.errorFd, received, outcome.errorOutput);
+    ::close(child.resultFd);
+    if (child.errorFd >= 0) {
+        ::close(child.errorFd);
+    }
+    int status = 0;
+    while (::waitpid(child.pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    bool hasResultFrame = false;
+    constexpr auto headerSize = sizeof(char) + sizeof(std::uint64_t);
+    std::size_t position = 0;
+    while (received.size() - position >= headerSize) {
+        const auto type = received[position];
+        std::uint64_t size = 0;
+        std::memcpy(&size, received.data() + position + 1, sizeof(size));
+        position += headerSize;
+        if (received.size() - position < size) {
+            break; // An incomplete frame from a child that crashed while sending it.
+        }
+        auto data = received.substr(position, static_cast<std::size_t>(size));
+        position += static_cast<std::size_t>(size);
+        if (type == cResultFrame) {
+            outcome.result = std::move(data);
+            hasResultFrame = true;
+        } else {
+            outcome.messages.push_back(std::move(data));
+        }
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && hasResultFrame) {
+        outcome.hasResult = true;
+        return outcome;
+    }
+    outcome.result.clear();
+    if (WIFSIGNALED(status)) {
+        const auto signal = WTERMSIG(status);
+        outcome.signal = signal;
+        outcome.termination =
+            std::format("The child process was terminated by signal {} ({}).", signal, ::strsignal(signal));
+    } else if (WIFEXITED(status)) {
+        outcome.exitCode = WEXITSTATUS(status);
+        outcome.termination =
+            std::format("The child process exited with code {} without sending a result.", WEXITSTATUS(status));
+    } else {
+        outcome.termination = "The child process terminated without sending a result.";
+    }
+    return outcome;
+}
+
+}
+
+#endif
+
+auto ChildProcess::isSupported() noexcept -> bool {
+#ifdef ERBSLAND_OS_WINDOWS
+    return false;
+#else
+    return true;
+#endif
+}
+
+auto ChildProcess::run(const std::function<std::string()> &childFunction, const bool captureErrorOutput) -> Outcome {
+#ifdef ERBSLAND_OS_WINDOWS
+    (void)childFunction;
+    (void)captureErrorOutput;
+    throw std::logic_error("Child processes are not supported on this platform.");
+#else
+    return finishChild(startChild(childFunction, captureErrorOutput ? OutputMode::Capture : OutputMode::Keep));
+#endif
+}
+
+auto ChildProcess::runParallel(const std::size_t count, const std::function<std::string(std::size_t)> &childFunction)
+    -> std::vector<Outcome> {
+#ifdef ERBSLAND_OS_WINDOWS
+    (void)count;
+    (void)childFunction;
+    throw std::logic_error("Child processes are not supported on this platform.");
+#else
+    const auto jobCount = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<Outcome> outcomes(count);
+    std::deque<std::pair<std::size_t, RunningChild>> runningChildren;
+    auto finishOldest = [&]() -> void {
+        const auto [index, child] = runningChildren.front();
+        runningChildren.pop_front();
+        outcomes[index] = finishChild(child);
+    };
+    try {
+        for (std::size_t index = 0; index < count; ++index) {
+            if (runningChildren.size() >= jobCount) {
+                finishOldest();
+            }
+            runningChildren.emplace_back(
+                index, startChild([&]() -> std::string { return childFunction(index); }, OutputMode::Discard));
+        }
+    } catch (...) {
+        while (!runningChildren.empty()) {
+            finishOldest();
+        }
+        throw;
+    }
+    while (!runningChildren.empty()) {
+        finishOldest();
+    }
+    return outcomes;
+#endif
+}
+
+void ChildProcess::sendMessage(const std::string &message) noexcept {
+#ifndef ERBSLAND_OS_WINDOWS
+    if (gChildPipe < 0) {
+        return;
+    }
+    writeFrame(gChildPipe, cMessageFrame, message);
+#else
+    (void)message;
+#endif
+}
+
+auto ChildProcess::limitAddressSpace(const std::size_t additionalBytes) noexcept -> bool {
+#if defined(ERBSLAND_OS_WINDOWS) || defined(ERBSLAND_OS_MACOS)
+    // Windows has no child processes, and macOS does not enforce `RLIMIT_AS`.
+    (void)additionalBytes;
+    return false;
+#else
+    // The first value in `statm` is the size of the address space in pages.
+    auto *file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return false;
+    }
+    unsigned long long totalPages = 0;
+    const auto matched = std::fscanf(file, "%llu", &totalPages);
+    std::fclose(file);
+    const auto pageSize = ::sysconf(_SC_PAGESIZE);
+    if (matched != 1 || pageSize <= 0) {
+        return false;
+    }
+    rlimit limit{};
+    if (::getrlimit(RLIMIT_AS, &limit) != 0) {
+        return false;
+    }
+    auto softLimit = static_cast<rlim_t>(totalPages * static_cast<unsigned long long>(pageSize) + additionalBytes);
+    if (limit.rlim_max != RLIM_INFINITY && softLimit > limit.rlim_max) {
+        softLimit = limit.rlim_max;
+    }
+    limit.rlim_cur = softLimit;
+    return ::setrlimit(RLIMIT_AS, &limit) == 0;
+#endif
+}
+
+}
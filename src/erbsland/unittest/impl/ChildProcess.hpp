@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// Run code in a forked child process and receive its result over a pipe.
+///
+/// The child starts with a copy-on-write snapshot of the parent process. If the child crashes or exits
+/// before it sent its result, the parent receives a description of how the child terminated instead.
+/// While it runs, the child can send messages to the parent, that are received even if the child crashes later.
+///
+class ChildProcess {
+public:
+    /// The outcome of running a child process.
+    struct Outcome {
+        bool hasResult{false};             ///< If the child sent its result and exited normally.
+        std::string result;                ///< The result that was sent by the child.
+        std::vector<std::string> messages; ///< The messages the child sent with `sendMessage()`.
+        std::string termination;           ///< A description how the child terminated, if there is no result.
+        std::optional<int> exitCode;       ///< The exit code, if there is no result and the child exited.
+        std::optional<int> signal;         ///< The signal, if there is no result and the child was terminated.
+        std::string errorOutput;           ///< The captured error output, if requested.
+    };
+
+public:
+    /// Test if child processes are supported on this platform.
+    [[nodiscard]] static auto isSupported() noexcept -> bool;
+
+    /// Run a function in a child process.
+    ///
+    /// @param childFunction The function that is called in the child process. It returns the result that is
+    ///     sent to the parent process. After the function returns, the child process exits immediately,
+    ///     without calling any destructors of static objects.
+    /// @param captureErrorOutput If `stderr` of the child is captured, instead of written to the console.
+    /// @return The outcome of the child process.
+    /// @throws std::system_error If the child process cannot be created.
+    ///
+    static auto run(const std::function<std::string()> &childFunction, bool captureErrorOutput = false)
+        -> Outcome;
+
+    /// Run a function in many child processes, using all cores of the system.
+    ///
+    /// The output of the child processes is discarded.
+    ///
+    /// @param count The number of child processes to run.
+    /// @param childFunction The function that is called in each child process, with the index of the child.
+    ///     It returns the result that is sent to the parent process.
+    /// @return The outcomes of all child processes, in the order of their index.
+    /// @throws std::system_error If a child process cannot be created.
+    ///
+    static auto runParallel(std::size_t count, const std::function<std::string(std::size_t)> &childFunction)
+        -> std::vector<Outcome>;
+
+    /// Send a message from the child process to the parent process.
+    /// Calls outside of a child process are ignored.
+    /// @param message The message to send.
+    static void sendMessage(const std::string &message) noexcept;
+
+    /// Limit the address space of the calling child process.
+    ///
+    /// Allocations that bypass `operator new`, like `malloc()` or `mmap()`, fail if they exceed the limit.
+    ///
+    /// @param additionalBytes The number of bytes the process may add to its current address space.
+    /// @return `true` if the limit was set, `false` if this is not supported on this platform.
+    ///
+    static auto limitAddressSpace(std::size_t additionalBytes) noexcept -> bool;
+};
+
+}
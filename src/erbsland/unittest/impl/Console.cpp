@@ -89,6 +89,19 @@ void Console::finishTask(const std::string &result, ConsoleColor textColor) {
     _currentTask = {};
 }
 
+void Console::cancelTask() {
+    if (!_currentTaskLine.empty()) {
+        clearTaskLine();
+    }
+    _currentTaskLine = {};
+    _currentTask = {};
+}
+
+void Console::resetTask() {
+    _currentTaskLine = {};
+    _currentTask = {};
+}
+
 void Console::writeTaskLine() {
     if (!_useColor) {
         return;
@@ -57,6 +57,12 @@ public: // status handling.
     /// Finish a task.
     /// Finishes the task, by replacing the status line with "<task text> <result>".
     void finishTask(const std::string &result, ConsoleColor textColor = {});
+    /// Cancel a task.
+    /// Removes the status line of the current task, without writing a result.
+    void cancelTask();
+    /// Reset the task.
+    /// Forgets the current task without changing the output, after a child process finished it.
+    void resetTask();
     /// Write a task line for error reporting.
     void writeErrorTaskLine(const std::string &task, const std::string &result, ConsoleColor textColor);
 
@@ -2,7 +2,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "ConsoleLine.hpp"
 
+#include "Utf8Scan.hpp"
+
 #include <algorithm>
+#include <array>
 #include <format>
 #include <numeric>
 
@@ -34,10 +37,7 @@ void ConsoleLine::addText(
 }
 
 auto ConsoleLine::utf8Length(const std::string_view &text) noexcept -> std::size_t {
-    const auto count = std::ranges::count_if(text, [](const char character) -> bool {
-        return (static_cast<uint8_t>(character) & uint8_t{0xC0U}) != uint8_t{0x80U};
-    });
-    return static_cast<std::size_t>(count);
+    return th::impl::utf8CharacterCount(text);
 }
 
 auto ConsoleLine::utf8RemoveControlCharacters(const std::string_view &text) noexcept -> std::string {
@@ -53,107 +53,202 @@ auto ConsoleLine::utf8RemoveControlCharacters(const std::string_view &text) noex
     return result;
 }
 
-/// Processes a potentially valid UTF-8 encoded character from the input text, appending a representation of the
-/// character to the result string. This function ensures that the UTF-8 data is safe and properly encoded.
-/// Invalid or incomplete data will be represented by an escaped hexadecimal notation.
-/// @param currentIndex Reference to the current index in the text to be processed.
-///     Will be updated to point to the next character index after processing multibyte sequences.
-/// @param text The string view containing the UTF-8 encoded text to process.
-/// @param result The string to which the processed and validated character representation will be appended.
-void processSafeUtf8Character(std::size_t &currentIndex, const std::string_view &text, std::string &result) {
-    const auto asByte = static_cast<uint8_t>(text.at(currentIndex));
-    std::size_t cSize = 0;
-    char32_t unicodeValue{};
-    if ((asByte & 0b11100000U) == 0b11000000U && asByte >= 0b11000010U) {
-        cSize = 2; // 2-byte sequence
-        unicodeValue = static_cast<char32_t>(asByte & 0b00011111U);
-    } else if ((asByte & 0b11110000U) == 0b11100000U) {
-        cSize = 3; // 3-byte sequence
-        unicodeValue = static_cast<char32_t>(asByte & 0b00001111U);
-    } else if ((asByte & 0b11111000U) == 0b11110000U && asByte < 0b11110101U) {
-        cSize = 4; // 4-byte sequence
-        unicodeValue = static_cast<char32_t>(asByte & 0b00000111U);
+namespace {
+
+/// How a byte is written to console safe text.
+enum class ByteEscape : uint8_t {
+    Copy,    ///< The byte is copied unchanged.
+    Short,   ///< The byte is escaped with a short sequence like `\n`.
+    Hex,     ///< The byte is escaped as `\xHH`.
+    Unicode, ///< The byte starts a UTF-8 sequence, that is escaped as `\u{HHHH}` if it is valid.
+};
+
+/// The escaping for all byte values.
+constexpr auto cByteEscapes = [] {
+    std::array<ByteEscape, 0x100> table{};
+    for (std::size_t i = 0; i < 0x20U; ++i) {
+        table[i] = ByteEscape::Hex;
     }
-    if (cSize < 2) {
-        // invalid size or wrong state.
-        result.append(std::format("\\x{:02X}", asByte));
-    } else if (currentIndex + cSize > text.size()) {
-        // the text is too short.
-        result.append(std::format("\\x{:02X}", asByte));
-    } else {
-        bool valid = true;
-        for (std::size_t di = 1; di < cSize; ++di) {
-            const auto nextByte = static_cast<uint8_t>(text.at(currentIndex + di));
-            if ((nextByte & 0b11000000U) != 0b10000000U) {
-                // invalid UTF-8 encoding.
-                result.append(std::format("\\x{:02X}", asByte));
-                valid = false;
-                break;
-            }
-            unicodeValue <<= 6;
-            unicodeValue |= static_cast<char32_t>(nextByte & 0b00111111U);
+    for (const auto character : {'\n', '\r', '\t', '\\', '\"'}) {
+        table[static_cast<uint8_t>(character)] = ByteEscape::Short;
+    }
+    table[0x7FU] = ByteEscape::Hex;
+    for (std::size_t i = 0x80U; i < 0x100U; ++i) {
+        table[i] = ByteEscape::Unicode;
+    }
+    return table;
+}();
+
+constexpr std::string_view cHexDigits = "0123456789ABCDEF";
+
+/// A buffer for a single escape sequence.
+class EscapeBuffer {
+public:
+    void append(const char character) noexcept { _data[_size++] = character; }
+    void appendHex(const uint32_t value, const std::size_t minimumDigits) noexcept {
+        std::size_t digits = minimumDigits;
+        while (digits < 8 && (value >> (digits * 4U)) != 0) {
+            ++digits;
         }
-        if (valid) {
-            result.append(std::format("\\u{{{:04X}}}", static_cast<uint32_t>(unicodeValue)));
-            currentIndex += cSize - 1;
+        for (std::size_t i = digits; i > 0; --i) {
+            append(cHexDigits[(value >> ((i - 1) * 4U)) & 0x0FU]);
         }
     }
-}
-
-/// Processes a single character from the input text, appending a representation of the character to the result string.
-/// This function ensures that the character is safe and properly encoded.
-/// @param currentIndex Reference to the current index in the text to be processed.
-///     Will be updated to point to the next character index after processing multibyte sequences.
-/// @param text The string view containing the UTF-8 encoded text to process.
-/// @param result The string to which the processed and validated character representation will be appended.
-void processCharacterForSafeUtf8Encoding(std::size_t &currentIndex, const std::string_view &text, std::string &result) {
-
-    const auto character = text.at(currentIndex);
-    switch (character) {
-    case '\n':
-        result.append("\\n");
-        return;
-    case '\r':
-        result.append("\\r");
-        return;
-    case '\t':
-        result.append("\\t");
-        return;
-    case '\\':
-        result.append("\\\\");
-        return;
-    case '\"':
-        result.append("\\\"");
-        return;
-    default:
-        break;
+    [[nodiscard]] auto view() const noexcept -> std::string_view { return {_data.data(), _size}; }
+
+private:
+    std::array<char, 16> _data{};
+    std::size_t _size{0};
+};
+
+/// Get the escape sequence for a UTF-8 sequence, or for its start byte if the sequence is invalid.
+/// @param text The text.
+/// @param index The index of the start byte. It is moved after the last byte of the escaped sequence.
+/// @param buffer The buffer for the escape sequence.
+void escapeUtf8Sequence(const std::string_view text, std::size_t &index, EscapeBuffer &buffer) noexcept {
+    const auto leadByte = static_cast<uint8_t>(text[index]);
+    std::size_t sequenceSize = 0;
+    auto codePoint = uint32_t{0};
+    if (leadByte >= 0xC2U && leadByte < 0xE0U) {
+        sequenceSize = 2;
+        codePoint = leadByte & 0x1FU;
+    } else if (leadByte >= 0xE0U && leadByte < 0xF0U) {
+        sequenceSize = 3;
+        codePoint = leadByte & 0x0FU;
+    } else if (leadByte >= 0xF0U && leadByte < 0xF5U) {
+        sequenceSize = 4;
+        codePoint = leadByte & 0x07U;
     }
-
-    const auto asByte = static_cast<uint8_t>(character);
-    if (asByte < 0x20U || asByte == 0x7FU) {
-        result.append(std::format("\\x{:02X}", asByte));
-    } else if (asByte < 0x80U) {
-        result.push_back(character);
+    bool isValid = sequenceSize > 0 && index + sequenceSize <= text.size();
+    for (std::size_t i = 1; isValid && i < sequenceSize; ++i) {
+        const auto nextByte = static_cast<uint8_t>(text[index + i]);
+        isValid = (nextByte & 0xC0U) == 0x80U;
+        codePoint = (codePoint << 6U) | (nextByte & 0x3FU);
+    }
+    buffer.append('\\');
+    if (isValid) {
+        buffer.append('u');
+        buffer.append('{');
+        buffer.appendHex(codePoint, 4);
+        buffer.append('}');
+        index += sequenceSize;
     } else {
-        processSafeUtf8Character(currentIndex, text, result);
+        buffer.append('x');
+        buffer.appendHex(leadByte, 2);
+        index += 1;
     }
 }
 
-auto ConsoleLine::utf8SafeString(const std::string_view &text, const std::size_t maxLength) noexcept -> std::string {
-    std::string result;
-    for (std::size_t i = 0; i < text.size(); ++i) {
-        if (i >= maxLength) {
-            result.append(std::format("(... +{} more)", text.size() - maxLength));
+/// Escape UTF-8 text for the console.
+///
+/// Runs of bytes that need no escaping are passed to the sink as a whole. Each escape sequence is passed
+/// separately. A character that starts before `limit` is processed completely.
+///
+/// @tparam Sink A type with the methods `copy(std::string_view)` and `escape(std::string_view)`.
+/// @param text The text to escape.
+/// @param limit The index where the processing stops.
+/// @param sink The sink for the escaped text.
+/// @return The index after the last processed byte.
+template <typename Sink>
+auto escapeForConsole(const std::string_view text, const std::size_t limit, Sink &sink) noexcept -> std::size_t {
+    std::size_t index = 0;
+    while (index < limit) {
+        const auto runStart = index;
+        while (index < limit && cByteEscapes[static_cast<uint8_t>(text[index])] == ByteEscape::Copy) {
+            ++index;
+        }
+        if (index > runStart) {
+            sink.copy(text.substr(runStart, index - runStart));
+        }
+        if (index >= limit) {
+            break;
+        }
+        EscapeBuffer buffer;
+        const auto character = text[index];
+        switch (cByteEscapes[static_cast<uint8_t>(character)]) {
+        case ByteEscape::Short:
+            buffer.append('\\');
+            buffer.append(character == '\n' ? 'n' : character == '\r' ? 'r' : character == '\t' ? 't' : character);
+            index += 1;
+            break;
+        case ByteEscape::Unicode:
+            escapeUtf8Sequence(text, index, buffer);
+            break;
+        default:
+            buffer.append('\\');
+            buffer.append('x');
+            buffer.appendHex(static_cast<uint8_t>(character), 2);
+            index += 1;
             break;
         }
-        processCharacterForSafeUtf8Encoding(i, text, result);
+        sink.escape(buffer.view());
+    }
+    return index;
+}
+
+/// A sink that measures the size of the escaped text.
+struct EscapeMeasure {
+    void copy(const std::string_view run) noexcept {
+        size += run.size();
+        hasSpace = hasSpace || run.find(' ') != std::string_view::npos;
+    }
+    void escape(const std::string_view sequence) noexcept {
+        size += sequence.size();
+        hasEscape = true;
     }
-    // If the string contains escape sequences, enclose it in quotes
-    if (result.find_first_of(" \"\\") != std::string::npos) {
-        result.insert(0, "\"");
+
+    std::size_t size{0};   ///< The size of the escaped text.
+    bool hasSpace{false};  ///< If the escaped text contains a space.
+    bool hasEscape{false}; ///< If the escaped text contains an escape sequence.
+};
+
+/// A sink that writes the escaped text into a string.
+struct EscapeWriter {
+    void copy(const std::string_view run) const { result.append(run); }
+    void escape(const std::string_view sequence) const { result.append(sequence); }
+
+    std::string &result; ///< The string that receives the escaped text.
+};
+
+/// Escape UTF-8 text for the console.
+/// All control characters, quotes, backslashes, non-ASCII characters and invalid bytes are escaped.
+/// @param text The text to escape.
+/// @param maxLength The number of bytes of the text, after which the text is truncated.
+/// @param quoteIfNeeded If the result is enclosed in quotes, when it contains spaces, quotes or escape sequences.
+/// @return The escaped text.
+auto consoleEscapedString(const std::string_view text, const std::size_t maxLength, const bool quoteIfNeeded) noexcept
+    -> std::string {
+
+    const auto limit = std::min(maxLength, text.size());
+    EscapeMeasure measure;
+    const auto end = escapeForConsole(text, limit, measure);
+    std::string truncation;
+    if (end < text.size()) {
+        truncation = std::format("(... +{} more)", text.size() - maxLength);
+    }
+    const bool isQuoted = quoteIfNeeded && (measure.hasEscape || measure.hasSpace || !truncation.empty());
+    std::string result;
+    result.reserve(measure.size + truncation.size() + (isQuoted ? 2U : 0U));
+    if (isQuoted) {
+        result.push_back('\"');
+    }
+    EscapeWriter writer{result};
+    escapeForConsole(text, limit, writer);
+    result.append(truncation);
+    if (isQuoted) {
         result.push_back('\"');
     }
     return result;
 }
 
 }
+
+auto ConsoleLine::utf8SafeString(const std::string_view &text, const std::size_t maxLength) noexcept -> std::string {
+    return consoleEscapedString(text, maxLength, true);
+}
+
+auto ConsoleLine::utf8EscapedString(const std::string_view &text) noexcept -> std::string {
+    return consoleEscapedString(text, text.size(), false);
+}
+
+}
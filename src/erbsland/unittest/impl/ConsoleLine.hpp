@@ -64,6 +64,11 @@ public:
     /// @return A safe, escaped text that can be written to the console.
     static auto utf8SafeString(const std::string_view &text, std::size_t maxLength) noexcept -> std::string;
 
+    /// Escape all control characters, quotes, backslashes and non-ASCII characters in a text.
+    /// @param text The text to process.
+    /// @return The escaped text, that only contains printable ASCII characters.
+    static auto utf8EscapedString(const std::string_view &text) noexcept -> std::string;
+
 private:
     std::vector<Part> _parts;
 };
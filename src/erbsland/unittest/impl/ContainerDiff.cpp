@@ -0,0 +1,80 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "ContainerDiff.hpp"
+
+#include <format>
+#include <vector>
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// Get a count with a singular or plural noun.
+auto countText(const std::size_t count, const std::string_view noun) -> std::string {
+    return std::format("{} {}{}", count, noun, count == 1 ? "" : "s");
+}
+
+}
+
+auto containerDiffMessage(const ContainerDiff &diff, const std::string_view aExpr, const std::string_view bExpr)
+    -> std::string {
+
+    std::string_view kindText;
+    std::string_view noun;
+    switch (diff.kind) {
+    case ContainerKind::Map:
+        kindText = "Maps";
+        noun = "key";
+        break;
+    case ContainerKind::Set:
+        kindText = "Sets";
+        noun = "element";
+        break;
+    default:
+        kindText = "Containers";
+        noun = "element";
+        break;
+    }
+    std::vector<std::string> parts;
+    if (diff.onlyInA > 0) {
+        parts.push_back(std::format("{} only in A", countText(diff.onlyInA, noun)));
+    }
+    if (diff.onlyInB > 0) {
+        parts.push_back(std::format("{} only in B", countText(diff.onlyInB, noun)));
+    }
+    if (diff.changed > 0) {
+        const auto changedNoun = diff.isIndexWise ? std::string_view{"position"} : noun;
+        parts.push_back(std::format("{} with different values", countText(diff.changed, changedNoun)));
+    }
+    std::string result = std::format("{} differ: ", kindText);
+    if (parts.empty()) {
+        result += "no difference was found.";
+    }
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        if (i > 0) {
+            result += ", ";
+        }
+        result += parts[i];
+    }
+    if (!parts.empty()) {
+        result += '.';
+    }
+    if (diff.sizeA != diff.sizeB) {
+        result += std::format("\n  Sizes: A has {} elements, B has {} elements.", diff.sizeA, diff.sizeB);
+    }
+    if (diff.isIndexWise) {
+        result += "\n  There are too many differences for a sequence diff, the elements are compared by index.";
+    }
+    for (const auto &line : diff.lines) {
+        result += "\n  ";
+        result += line;
+    }
+    const auto totalCount = diff.onlyInA + diff.onlyInB + diff.changed;
+    if (totalCount > diff.lines.size()) {
+        result += std::format("\n  ... and {} more.", countText(totalCount - diff.lines.size(), "difference"));
+    }
+    result += std::format("\n  A: {}\n  B: {}", aExpr, bExpr);
+    return result;
+}
+
+}
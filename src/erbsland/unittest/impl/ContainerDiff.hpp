@@ -0,0 +1,269 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "SequenceDiff.hpp"
+#include "ValueText.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// The kind of containers in a structural difference.
+enum class ContainerKind : std::uint8_t {
+    Sequence, ///< Ordered ranges, compared with a sequence diff.
+    Map,      ///< Maps, compared by their keys.
+    Set,      ///< Sets, compared by their elements.
+};
+
+/// @internal
+/// The structural difference of two containers.
+struct ContainerDiff {
+    ContainerKind kind{ContainerKind::Sequence}; ///< The kind of the compared containers.
+    std::size_t sizeA{0};                        ///< The number of elements in the first container.
+    std::size_t sizeB{0};                        ///< The number of elements in the second container.
+    std::size_t onlyInA{0};                      ///< The number of elements or keys only in the first container.
+    std::size_t onlyInB{0};                      ///< The number of elements or keys only in the second container.
+    std::size_t changed{0};                      ///< The number of keys or indexes with different values.
+    bool isIndexWise{false};                     ///< If the sequences were compared index by index.
+    std::vector<std::string> lines{};            ///< The first listed differences.
+};
+
+/// @internal
+/// The maximum number of differences that are listed in the error message.
+constexpr std::size_t cContainerDiffMaximumLines = 20;
+/// @internal
+/// The maximum length of a value in the listed differences.
+constexpr std::size_t cContainerDiffMaximumValueLength = 40;
+
+/// Generates the error message for two containers that are not equal.
+/// @param diff The structural difference of the containers.
+/// @param aExpr The textual representation of the first container.
+/// @param bExpr The textual representation of the second container.
+/// @return A detailed error message.
+auto containerDiffMessage(const ContainerDiff &diff, std::string_view aExpr, std::string_view bExpr) -> std::string;
+
+/// Test if a type is a container, that is compared with a structural difference.
+/// Strings and other ranges of characters are excluded, as they are shown as text.
+/// @tparam T The tested type.
+template <typename T>
+constexpr bool is_diff_container = [] {
+    if constexpr (std::ranges::forward_range<const T> && std::ranges::sized_range<const T>) {
+        using Element = std::remove_cv_t<std::ranges::range_value_t<const T>>;
+        return !std::is_same_v<Element, char> && !std::is_same_v<Element, wchar_t> &&
+            !std::is_same_v<Element, char8_t> && !std::is_same_v<Element, char16_t> &&
+            !std::is_same_v<Element, char32_t>;
+    } else {
+        return false;
+    }
+}();
+
+/// Test if two containers are maps, where the keys of one can be searched in the other.
+template <typename A, typename B>
+constexpr bool is_diff_map = requires(const A &a, const B &b) {
+    typename A::key_type;
+    typename A::mapped_type;
+    typename B::mapped_type;
+    b.find(a.begin()->first) != b.end();
+    a.find(b.begin()->first) != a.end();
+    static_cast<bool>(a.begin()->second == b.begin()->second);
+};
+
+/// Test if two containers are sets, where the elements of one can be searched in the other.
+template <typename A, typename B>
+constexpr bool is_diff_set = !is_diff_map<A, B> && requires(const A &a, const B &b) {
+    typename A::key_type;
+    typename B::key_type;
+    b.find(*a.begin()) != b.end();
+    a.find(*b.begin()) != a.end();
+};
+
+/// Test if the elements of two containers can be compared for a sequence diff.
+template <typename A, typename B>
+constexpr bool is_diff_sequence = requires(const A &a, const B &b) {
+    static_cast<bool>(*std::ranges::begin(a) == *std::ranges::begin(b));
+};
+
+/// Test if two containers can be compared with a structural difference.
+template <typename A, typename B>
+constexpr bool can_diff_containers = [] {
+    if constexpr (is_diff_container<A> && is_diff_container<B>) {
+        return is_diff_map<A, B> || is_diff_set<A, B> || is_diff_sequence<A, B>;
+    } else {
+        return false;
+    }
+}();
+
+/// @internal
+/// Compare the elements of two sequences index by index.
+/// This is the fallback for sequences with too many differences for a sequence diff.
+template <typename ElementA, typename ElementB>
+void indexWiseDiff(ContainerDiff &diff, ElementA &elementA, ElementB &elementB) {
+    diff.isIndexWise = true;
+    diff.lines.clear();
+    const auto comparedCount = std::min(diff.sizeA, diff.sizeB);
+    for (std::size_t i = 0; i < comparedCount; ++i) {
+        if (static_cast<bool>(elementA(i) == elementB(i))) {
+            continue;
+        }
+        diff.changed += 1;
+        if (diff.lines.size() < cContainerDiffMaximumLines) {
+            diff.lines.push_back(std::format("~ [{}]: {} != {}",
+                i,
+                valueText(elementA(i), cContainerDiffMaximumValueLength),
+                valueText(elementB(i), cContainerDiffMaximumValueLength)));
+        }
+    }
+    diff.onlyInA = diff.sizeA - comparedCount;
+    diff.onlyInB = diff.sizeB - comparedCount;
+}
+
+/// @internal
+/// Get the structural difference of two sequences.
+template <typename A, typename B>
+[[nodiscard]] auto sequenceContainerDiff(const A &a, const B &b) -> ContainerDiff {
+    ContainerDiff diff{
+        .kind = ContainerKind::Sequence,
+        .sizeA = static_cast<std::size_t>(std::ranges::size(a)),
+        .sizeB = static_cast<std::size_t>(std::ranges::size(b))};
+    auto elementA = indexedElements(a);
+    auto elementB = indexedElements(b);
+    const auto ranges = sequenceDiff(diff.sizeA, diff.sizeB, [&](const std::size_t indexA, const std::size_t indexB) {
+        return static_cast<bool>(elementA(indexA) == elementB(indexB));
+    });
+    if (!ranges.has_value()) {
+        indexWiseDiff(diff, elementA, elementB);
+        return diff;
+    }
+    for (const auto &range : *ranges) {
+        for (std::size_t i = 0; i < range.count; ++i) {
+            if (range.operation == DiffOperation::Delete) {
+                diff.onlyInA += 1;
+                if (diff.lines.size() < cContainerDiffMaximumLines) {
+                    diff.lines.push_back(std::format("- A[{}]: {}",
+                        range.indexA + i,
+                        valueText(elementA(range.indexA + i), cContainerDiffMaximumValueLength)));
+                }
+            } else if (range.operation == DiffOperation::Insert) {
+                diff.onlyInB += 1;
+                if (diff.lines.size() < cContainerDiffMaximumLines) {
+                    diff.lines.push_back(std::format("+ B[{}]: {}",
+                        range.indexB + i,
+                        valueText(elementB(range.indexB + i), cContainerDiffMaximumValueLength)));
+                }
+            }
+        }
+    }
+    return diff;
+}
+
+/// @internal
+/// Get the structural difference of two maps, using the difference of their key sets.
+template <typename A, typename B>
+[[nodiscard]] auto mapContainerDiff(const A &a, const B &b) -> ContainerDiff {
+    ContainerDiff diff{
+        .kind = ContainerKind::Map,
+        .sizeA = static_cast<std::size_t>(std::ranges::size(a)),
+        .sizeB = static_cast<std::size_t>(std::ranges::size(b))};
+    std::vector<std::string> onlyInBLines;
+    std::vector<std::string> changedLines;
+    for (const auto &[key, value] : a) {
+        const auto it = b.find(key);
+        if (it == b.end()) {
+            diff.onlyInA += 1;
+            if (diff.lines.size() < cContainerDiffMaximumLines) {
+                diff.lines.push_back(std::format("- A[{}]: {}",
+                    valueText(key, cContainerDiffMaximumValueLength),
+                    valueText(value, cContainerDiffMaximumValueLength)));
+            }
+        } else if (!static_cast<bool>(value == it->second)) {
+            diff.changed += 1;
+            if (changedLines.size() < cContainerDiffMaximumLines) {
+                changedLines.push_back(std::format("~ [{}]: {} != {}",
+                    valueText(key, cContainerDiffMaximumValueLength),
+                    valueText(value, cContainerDiffMaximumValueLength),
+                    valueText(it->second, cContainerDiffMaximumValueLength)));
+            }
+        }
+    }
+    for (const auto &[key, value] : b) {
+        if (a.find(key) == a.end()) {
+            diff.onlyInB += 1;
+            if (onlyInBLines.size() < cContainerDiffMaximumLines) {
+                onlyInBLines.push_back(std::format("+ B[{}]: {}",
+                    valueText(key, cContainerDiffMaximumValueLength),
+                    valueText(value, cContainerDiffMaximumValueLength)));
+            }
+        }
+    }
+    diff.lines.insert(diff.lines.end(), onlyInBLines.begin(), onlyInBLines.end());
+    diff.lines.insert(diff.lines.end(), changedLines.begin(), changedLines.end());
+    diff.lines.resize(std::min(diff.lines.size(), cContainerDiffMaximumLines));
+    return diff;
+}
+
+/// @internal
+/// Get the structural difference of two sets, using the difference of their elements.
+template <typename A, typename B>
+[[nodiscard]] auto setContainerDiff(const A &a, const B &b) -> ContainerDiff {
+    ContainerDiff diff{
+        .kind = ContainerKind::Set,
+        .sizeA = static_cast<std::size_t>(std::ranges::size(a)),
+        .sizeB = static_cast<std::size_t>(std::ranges::size(b))};
+    std::vector<std::string> onlyInBLines;
+    for (const auto &element : a) {
+        if (b.find(element) == b.end()) {
+            diff.onlyInA += 1;
+            if (diff.lines.size() < cContainerDiffMaximumLines) {
+                diff.lines.push_back(std::format("- A: {}", valueText(element, cContainerDiffMaximumValueLength)));
+            }
+        }
+    }
+    for (const auto &element : b) {
+        if (a.find(element) == a.end()) {
+            diff.onlyInB += 1;
+            if (onlyInBLines.size() < cContainerDiffMaximumLines) {
+                onlyInBLines.push_back(std::format("+ B: {}", valueText(element, cContainerDiffMaximumValueLength)));
+            }
+        }
+    }
+    diff.lines.insert(diff.lines.end(), onlyInBLines.begin(), onlyInBLines.end());
+    diff.lines.resize(std::min(diff.lines.size(), cContainerDiffMaximumLines));
+    return diff;
+}
+
+/// @internal
+/// Get the structural difference of two containers.
+/// Maps and sets are compared by their keys. If this finds no difference, like for multimaps with a different
+/// number of equal keys, or if the containers are sequences, the elements are compared with a sequence diff.
+template <typename A, typename B>
+[[nodiscard]] auto containerDiff(const A &a, const B &b) -> ContainerDiff {
+    if constexpr (is_diff_map<A, B>) {
+        auto diff = mapContainerDiff(a, b);
+        if (diff.onlyInA + diff.onlyInB + diff.changed > 0 || !is_diff_sequence<A, B>) {
+            return diff;
+        }
+    } else if constexpr (is_diff_set<A, B>) {
+        auto diff = setContainerDiff(a, b);
+        if (diff.onlyInA + diff.onlyInB > 0 || !is_diff_sequence<A, B>) {
+            return diff;
+        }
+    }
+    if constexpr (is_diff_sequence<A, B>) {
+        return sequenceContainerDiff(a, b);
+    } else {
+        return ContainerDiff{};
+    }
+}
+
+}
@@ -2,22 +2,42 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "Controller.hpp"
 
+#include "AllocationHook.hpp"
 #include "AssertFailed.hpp"
+#include "AssertStats.hpp"
+#include "ChildProcess.hpp"
+#include "CrashHandler.hpp"
 #include "Demangle.hpp"
+#include "Fuzzer.hpp"
+#include "MemoryUsage.hpp"
+#include "Profiler.hpp"
+#include "ResourceSnapshot.hpp"
+#include "ResourceUsage.hpp"
 #include "TestBase.hpp"
 #include "TestClassBase.hpp"
+#include "TestStack.hpp"
 
 #include <algorithm>
 #include <chrono>
 #include <format>
+#include <limits>
 #include <mutex>
+#include <new>
+#include <random>
 #include <ranges>
 #include <sstream>
 #include <thread>
 
 namespace erbsland::unittest {
 
-Controller::Controller() noexcept : _console(new Console()) {
+namespace {
+
+/// The number of profiler samples per second of CPU time.
+constexpr int cProfileFrequency = 1000;
+
+}
+
+Controller::Controller() noexcept : _console(new Console()), _profileDirectory{"profiles"} {
 }
 
 Controller::~Controller() {
@@ -37,6 +57,21 @@ auto Controller::main(int argc, char **argv) -> int {
     }
     // Reset the formatting to make sure the output always starts in the same color.
     console()->resetFormatting();
+    // Report the running test if the process crashes.
+    CrashHandler::install();
+    // Isolated tests already run in their own process, so there is nothing to supervise.
+    if (_isolate || _allocationFaults) {
+        _supervise = false;
+    }
+    // Choose a random seed, if none was specified on the command line.
+    if (!_seed.has_value()) {
+        std::random_device randomDevice;
+        const auto timeValue =
+            static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        _seed = RandomGenerator::mixSeed(
+            (static_cast<std::uint64_t>(randomDevice()) << 32U) | static_cast<std::uint64_t>(randomDevice()),
+            timeValue);
+    }
     // Sort the test classes by name, as registration may change depending on the compilation order.
     std::ranges::stable_sort(_testClasses, [](const auto &a, const auto &b) -> bool { return a->name() < b->name(); });
     // Create the initial set of tests.
@@ -79,6 +114,24 @@ auto Controller::main(int argc, char **argv) -> int {
             testClass->setEnabled(false);
         }
     }
+    // In fuzz mode, only run the selected fuzz tests.
+    if (_fuzzMode) {
+        bool hasFuzzTest = false;
+        for (auto &testClass : _testClasses) {
+            for (std::size_t i = 0; i < testClass->testCount(); ++i) {
+                if (!testClass->testMetaData(i).isFuzzMethod()) {
+                    testClass->test(i)->setEnabled(false);
+                } else if (testClass->test(i)->isEnabled()) {
+                    hasFuzzTest = true;
+                }
+            }
+        }
+        if (!hasFuzzTest) {
+            console()->writeError("No fuzz test matches the name given with the \"--fuzz\" argument.");
+            console()->resetFormatting();
+            return 1;
+        }
+    }
     // Count enabled tests.
     int testCount = 0;
     int testClassCount = 0;
@@ -92,6 +145,27 @@ auto Controller::main(int argc, char **argv) -> int {
             ++testClassCount;
         }
     }
+    // Register the suites that declared shared fixtures, so these are kept until the last of these suites finished.
+    _sharedFixtures.setLogger([this](const std::string &message) -> void {
+        if (_verbose) {
+            console()->writeDebug(message);
+        }
+    });
+    for (auto &testClass : _testClasses) {
+        if (!testClass->isEnabled()) {
+            continue;
+        }
+        for (const auto &name : testClass->metaData().sharedFixtures()) {
+            _sharedFixtures.addUser(name, testClass->shortName());
+        }
+        for (std::size_t i = 0; i < testClass->testCount(); ++i) {
+            if (testClass->test(i)->isEnabled()) {
+                for (const auto &name : testClass->testMetaData(i).sharedFixtures()) {
+                    _sharedFixtures.addUser(name, testClass->shortName());
+                }
+            }
+        }
+    }
     std::stringstream text;
     text << "===[ Running " << testClassCount << " test suites with " << testCount << " tests ]===\n";
     auto timeAsString = []() -> std::string {
@@ -106,123 +180,73 @@ auto Controller::main(int argc, char **argv) -> int {
     } else {
         text << "\nFilter: no filter set";
     }
+    text << "\nRandom Seed: " << std::format("0x{:016x}", _seed.value());
+    if (_isolate) {
+        text << "\nIsolation: each test runs in a forked process";
+    } else if (_supervise) {
+        text << "\nSupervision: each suite runs in a forked process, that resumes after a crash";
+    }
+    const bool isMemoryLimitEnforced = AllocationHook::isAvailable() || _isolate;
+    if (_memoryLimit > 0) {
+        text << "\nMemory Limit: " << memorySizeText(static_cast<std::int64_t>(_memoryLimit)) << " per test";
+        if (!isMemoryLimitEnforced) {
+            text << " (only enforced with --isolate)";
+        }
+    } else if (!isMemoryLimitEnforced) {
+        // Without the allocation hook, the limits of `MEMORY_LIMIT()` would be silently ignored.
+        if (const auto count = memoryLimitTestCount(); count > 0) {
+            text << "\nMemory Limit: set for " << count << (count == 1 ? " test" : " tests")
+                 << " with MEMORY_LIMIT() (only enforced with --isolate)";
+        }
+    }
+    if (_allocationFaults) {
+        text << "\nAllocation Faults: each allocation of each test fails once, in forked processes";
+    } else if (_failingAllocation > 0) {
+        text << "\nAllocation Fault: allocation " << _failingAllocation << " of each test fails";
+    }
+    if (_strictLeaks) {
+        text << "\nLeak Checks: leaked resources fail the test";
+    }
+    if (AssertStats::isEnabled()) {
+        text << "\nAssertion Statistics: the executions and the time of each assertion are counted";
+    }
+    if (_stackSize > 0) {
+        text << "\nStack Size: " << memorySizeText(static_cast<std::int64_t>(TestStack::effectiveSize(_stackSize)))
+             << " per test";
+    }
+    if (_fuzzMode) {
+        text << "\nFuzzing: " << _fuzzTime.count() << " seconds per test";
+    }
+    if (_profileMode) {
+        text << "\nProfiling: " << cProfileFrequency << " samples per second of CPU time, written to "
+             << _profileDirectory.string();
+    }
     console()->writeLine(text.str());
-    int errors = 0;
-    const int totalTaskCount = testClassCount + testCount;
-    int currentTask = 1;
+    _totalTaskCount = testClassCount + testCount;
     for (auto testClass : _testClasses) {
-        text.str({});
-        text << "Suite: " << testClass->shortName();
         _currentSuite = testClass->shortName();
-        _currentTest = "<ctor>";
-        if (testClass->isEnabled()) {
-            console()->startTask(text.str(), currentTask, totalTaskCount);
-            try {
-                testClass->createUnitTest();
-            } catch (const std::exception &ex) {
-                auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
-                console()->writeLine("Exception while creating the unit test instance.");
-                errorCapture->addContextInfo("Exception while creating the unit test instance.");
-                auto exceptionType = std::string(typeid(ex).name());
-                auto exceptionMessage = std::string(ex.what());
-                text.str({});
-                text << "Exception Type: " << demangleTypeName(exceptionType) << "\n"
-                     << "Exception Message: " << exceptionMessage;
-                console()->writeDebug(text.str());
-                errorCapture->addDebugInfo(text.str());
-                ++errors;
-                if (_stopAtFirstError) {
-                    break;
-                }
-                continue;
-            } catch (...) {
-                auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
-                console()->writeErrorInfo("Unknown exception while creating the unit test instance.");
-                errorCapture->addContextInfo("Unknown exception while creating the unit test instance.");
-                console()->writeDebug("Unknown exception.");
-                ++errors;
-                continue;
-            }
-            if (_waitAfterEachTest) {
-                std::this_thread::sleep_for(std::chrono::seconds{1});
-            }
-            console()->finishTask("Running", ConsoleColor::White);
-            ++currentTask;
-        } else {
+        setCurrentTest("<ctor>");
+        if (!testClass->isEnabled()) {
             if (_verbose) {
-                console()->startTask(text.str(), currentTask, totalTaskCount);
+                console()->startTask(std::format("Suite: {}", testClass->shortName()), _currentTask, _totalTaskCount);
                 console()->finishTask("Skipped", ConsoleColor::Orange);
             }
             continue;
         }
-        for (std::size_t i = 0; i < testClass->testCount(); ++i) {
-            auto test = testClass->test(i);
-            text.str({});
-            if (test->metaData().isPrintMethod()) {
-                text << "  Print: " << test->shortName();
-            } else {
-                text << "  Test: " << test->shortName();
-            }
-            if (test->isEnabled()) {
-                console()->startTask(text.str(), currentTask, totalTaskCount);
-            } else {
-                if (_verbose) {
-                    console()->startTask(text.str(), currentTask, totalTaskCount);
-                    console()->finishTask("Skipped", ConsoleColor::Orange);
-                }
-                continue;
-            }
-            _currentTest = test->shortName();
-            try {
-                if (test->metaData().isPrintMethod()) {
-                    _printMethodRunning = true;
-                    text.str({});
-                    text << "---{ start output from " << testClass->shortName() << " / " << test->shortName()
-                         << " }---";
-                    console()->writeDebug(text.str());
-                }
-                testClass->callTest(i);
-                if (test->metaData().isPrintMethod()) {
-                    _printMethodRunning = false;
-                    text.str({});
-                    text << "---{ end output from " << testClass->shortName() << " / " << test->shortName() << " }---";
-                    console()->writeDebug(text.str());
-                }
-                if (_waitAfterEachTest) {
-                    std::this_thread::sleep_for(std::chrono::seconds{1});
-                }
-                console()->finishTask("OK!", ConsoleColor::Green);
-            } catch (const AssertFailed &) {
-                ++errors;
-            } catch (const std::exception &ex) {
-                auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
-                console()->writeErrorInfo("Exception outside of assert clause.");
-                errorCapture->addContextInfo("Exception outside of assert clause.");
-                auto exceptionType = std::string(typeid(ex).name());
-                auto exceptionMessage = std::string(ex.what());
-                text.str({});
-                text << "Exception Type: " << demangleTypeName(exceptionType) << "\n"
-                     << "Exception Message: " << exceptionMessage;
-                console()->writeDebug(text.str());
-                errorCapture->addDebugInfo(text.str());
-                ++errors;
-            } catch (...) {
-                auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
-                console()->writeErrorInfo("Unknown exception outside of assert clause.");
-                errorCapture->addContextInfo("Unknown exception outside of assert clause.");
-                console()->writeDebug("Unknown exception.");
-                ++errors;
-            }
-            ++currentTask;
-            if (_stopAtFirstError && errors > 0) {
-                break;
-            }
-        }
-        if (_stopAtFirstError && errors > 0) {
+        const auto shallContinue = _supervise ? runSupervisedSuite(testClass) : runSuite(testClass, 0);
+        if (!shallContinue) {
             break;
         }
     }
-    if (errors > 0) {
+    _sharedFixtures.releaseAll();
+    if (_verbose) {
+        writeWaitingTests();
+    }
+    if (AssertStats::isEnabled()) {
+        writeAssertStats(std::chrono::steady_clock::now() - startTime);
+    }
+    writeSuiteFixtureDuration();
+    if (_errorCount > 0) {
         if (_showSummary) {
             console()->writeError("===[ ERROR SUMMARY ]===");
             auto it = _capturedErrors.begin();
@@ -239,7 +263,7 @@ auto Controller::main(int argc, char **argv) -> int {
             }
         }
         text.str({});
-        text << "===[ ERROR | " << errors << " errors while running the tests. ]===";
+        text << "===[ ERROR | " << _errorCount << " errors while running the tests. ]===";
         console()->writeError(text.str());
         console()->resetFormatting();
         return 1;
@@ -277,7 +301,29 @@ auto Controller::parseCommandLine(int argc, char **argv) -> int {
     for (int i = 1; i < argc; ++i) {
         args.emplace_back(argv[i]);
     }
-    for (const auto &arg : args) {
+    // Get the value for an option in the form `--option <value>` or `--option=<value>`.
+    std::size_t argIndex = 0;
+    auto optionValue = [&](const std::string &arg, const std::string &option) -> std::optional<std::string> {
+        if (arg == option) {
+            if (argIndex + 1 >= args.size()) {
+                return std::nullopt;
+            }
+            return args[++argIndex];
+        }
+        return arg.substr(option.size() + 1);
+    };
+    auto isOption = [](const std::string &arg, const std::string &option) -> bool {
+        return arg == option || arg.starts_with(option + "=");
+    };
+    auto missingValue = [&](const std::string &option) -> int {
+        std::stringstream text;
+        text << "Missing value for the \"" << option << "\" argument.\n\n";
+        console()->writeError(text.str());
+        printHelp();
+        return 1;
+    };
+    for (; argIndex < args.size(); ++argIndex) {
+        const auto &arg = args[argIndex];
         if (arg == "-h" || arg == "-help" || arg == "--help") {
             printHelp();
             return 1;
@@ -306,6 +352,171 @@ auto Controller::parseCommandLine(int argc, char **argv) -> int {
             _waitAfterEachTest = true;
             continue;
         }
+        if (isOption(arg, "--seed")) {
+            const auto value = optionValue(arg, "--seed");
+            if (!value.has_value()) {
+                return missingValue("--seed");
+            }
+            _seed = parseSeed(*value);
+            if (!_seed.has_value()) {
+                std::stringstream text;
+                text << "Invalid seed \"" << *value << "\". Use a decimal or hexadecimal (0x...) number.\n\n";
+                console()->writeError(text.str());
+                printHelp();
+                return 1;
+            }
+            continue;
+        }
+        if (arg == "--isolate") {
+            if (!ChildProcess::isSupported()) {
+                console()->writeError("The \"--isolate\" option is not supported on this platform.\n\n");
+                printHelp();
+                return 1;
+            }
+            _isolate = true;
+            continue;
+        }
+        if (arg == "--supervise") {
+            if (!ChildProcess::isSupported()) {
+                console()->writeError("The \"--supervise\" option is not supported on this platform.\n\n");
+                printHelp();
+                return 1;
+            }
+            _supervise = true;
+            continue;
+        }
+        if (isOption(arg, "--memory-limit")) {
+            const auto value = optionValue(arg, "--memory-limit");
+            if (!value.has_value()) {
+                return missingValue("--memory-limit");
+            }
+            const auto size = parseMemorySize(*value);
+            if (!size.has_value() || *size == 0) {
+                std::stringstream text;
+                text << "Invalid memory limit \"" << *value
+                     << "\". Use a number with an optional unit k, M, G or T.\n\n";
+                console()->writeError(text.str());
+                printHelp();
+                return 1;
+            }
+            _memoryLimit = *size;
+            continue;
+        }
+        if (arg == "--alloc-faults") {
+            if (!ChildProcess::isSupported() || !AllocationHook::isAvailable()) {
+                console()->writeError("The \"--alloc-faults\" option is not supported by this build.\n\n");
+                printHelp();
+                return 1;
+            }
+            _allocationFaults = true;
+            continue;
+        }
+        if (isOption(arg, "--alloc-fault")) {
+            const auto value = optionValue(arg, "--alloc-fault");
+            if (!value.has_value()) {
+                return missingValue("--alloc-fault");
+            }
+            if (!AllocationHook::isAvailable()) {
+                console()->writeError("The \"--alloc-fault\" option is not supported by this build.\n\n");
+                printHelp();
+                return 1;
+            }
+            const auto allocation = parseSeed(*value);
+            if (!allocation.has_value() || *allocation == 0) {
+                std::stringstream text;
+                text << "Invalid allocation number \"" << *value << "\". Use a positive number.\n\n";
+                console()->writeError(text.str());
+                printHelp();
+                return 1;
+            }
+            _failingAllocation = static_cast<std::size_t>(*allocation);
+            continue;
+        }
+        if (arg == "--strict-leaks") {
+            _strictLeaks = true;
+            continue;
+        }
+        if (arg == "--assert-stats") {
+            AssertStats::enable();
+            continue;
+        }
+        if (isOption(arg, "--stack-size")) {
+            const auto value = optionValue(arg, "--stack-size");
+            if (!value.has_value()) {
+                return missingValue("--stack-size");
+            }
+            if (!TestStack::isSupported()) {
+                console()->writeError("The \"--stack-size\" option is not supported on this platform.\n\n");
+                printHelp();
+                return 1;
+            }
+            const auto size = parseMemorySize(*value);
+            if (!size.has_value() || *size == 0) {
+                std::stringstream text;
+                text << "Invalid stack size \"" << *value
+                     << "\". Use a number with an optional unit k, M, G or T.\n\n";
+                console()->writeError(text.str());
+                printHelp();
+                return 1;
+            }
+            _stackSize = *size;
+            continue;
+        }
+        if (isOption(arg, "--fuzz")) {
+            const auto value = optionValue(arg, "--fuzz");
+            if (!value.has_value() || value->empty()) {
+                return missingValue("--fuzz");
+            }
+            _fuzzMode = true;
+            _filter.names.exclusive.insert(*value);
+            continue;
+        }
+        if (isOption(arg, "--profile")) {
+            const auto value = optionValue(arg, "--profile");
+            if (!value.has_value() || value->empty()) {
+                return missingValue("--profile");
+            }
+            if (!Profiler::isSupported()) {
+                console()->writeError("The \"--profile\" option is not supported on this platform.\n\n");
+                printHelp();
+                return 1;
+            }
+            _profileMode = true;
+            _filter.names.exclusive.insert(*value);
+            continue;
+        }
+        if (isOption(arg, "--profile-dir")) {
+            const auto value = optionValue(arg, "--profile-dir");
+            if (!value.has_value() || value->empty()) {
+                return missingValue("--profile-dir");
+            }
+            _profileDirectory = std::filesystem::path{*value};
+            continue;
+        }
+        if (isOption(arg, "--time")) {
+            const auto value = optionValue(arg, "--time");
+            if (!value.has_value()) {
+                return missingValue("--time");
+            }
+            const auto duration = parseDuration(*value);
+            if (!duration.has_value()) {
+                std::stringstream text;
+                text << "Invalid time \"" << *value << "\". Use a number with an optional unit s, m or h.\n\n";
+                console()->writeError(text.str());
+                printHelp();
+                return 1;
+            }
+            _fuzzTime = *duration;
+            continue;
+        }
+        if (isOption(arg, "--corpus")) {
+            const auto value = optionValue(arg, "--corpus");
+            if (!value.has_value() || value->empty()) {
+                return missingValue("--corpus");
+            }
+            _fuzzCorpus = std::filesystem::path{*value};
+            continue;
+        }
         auto index = arg.find(':');
         if (index > 0) {
             std::string option = arg.substr(0, index);
@@ -363,6 +574,21 @@ void Controller::printHelp() {
          << "  -l/--list ......... List all suites and tests. Do not run any test.\n"
          << "  -c/--no-color ..... Do not colorize the output and disable status updates.\n"
          << "  -s/--no-summary ... Do not list the first three errors at the end of the run.\n"
+         << "  --seed <seed> ..... Use the given random seed (decimal or 0x... hex) to replay a run.\n"
+         << "  --isolate ......... Run each test in a forked process, with a copy of the suite instance.\n"
+         << "  --supervise ....... Run each suite in a forked process, and continue after a crash.\n"
+         << "  --memory-limit <size> Limit the memory each test allocates with `operator new`, e.g. `512M`.\n"
+         << "                      With --isolate, also limit the address space of each process (see docs).\n"
+         << "  --stack-size <size> Run each test on a thread with the given stack size, e.g. `256k`.\n"
+         << "  --alloc-faults .... Run each test again for each allocation, with this allocation failing.\n"
+         << "  --alloc-fault <n> . Let allocation <n> of each test fail, to replay an allocation fault.\n"
+         << "  --strict-leaks .... Fail tests that leak memory, file descriptors or threads, instead of warning.\n"
+         << "  --assert-stats .... Count the executions and the time of each assertion, and list the slowest.\n"
+         << "  --fuzz <name> ..... Run the fuzzer for the fuzz test with the given name.\n"
+         << "  --time <time> ..... The time to fuzz each test, e.g. `60s`, `10m` or `1h` (default 60s).\n"
+         << "  --corpus <dir> .... The corpus directory to read and write while fuzzing.\n"
+         << "  --profile <name> .. Profile the tests with the given test or class name, and write folded stacks.\n"
+         << "  --profile-dir <dir> The directory for the profiles (default `profiles`).\n"
          << "  name:<name> ....... Exclusively run tests with the specified test or class name (case sensitive).\n"
          << "  +name:<name> ...... Run tests with the specified test or class name, even optional ones.\n"
          << "  -name:<name> ...... Skip tests with the specified test or class name.\n"
@@ -412,7 +638,892 @@ auto Controller::reportError(const std::string &result, ConsoleColor textColor)
     auto errorCapture = std::make_shared<ErrorCapture>(_currentSuite, _currentTest, result, textColor);
     _capturedErrors.push_back(errorCapture);
     console()->finishTask(result, textColor);
+    if (!_fuzzInput.empty()) {
+        auto fuzzInfo = std::format("Fuzz input: {}", _fuzzInput);
+        console()->writeErrorInfo(fuzzInfo);
+        errorCapture->addContextInfo(fuzzInfo);
+    }
+    if (_randomUsed && _seed.has_value()) {
+        const auto &replayName = _currentTest.starts_with('<') ? _currentSuite : _currentTest;
+        auto seedInfo = std::format(
+            "Random seed: 0x{:016x} (replay with: --seed=0x{:016x} name:{})", _random.seed(), _seed.value(), replayName);
+        console()->writeErrorInfo(seedInfo);
+        errorCapture->addContextInfo(seedInfo);
+    }
     return errorCapture;
 }
 
+auto Controller::random() noexcept -> RandomGenerator & {
+    _randomUsed = true;
+    return _random;
+}
+
+auto Controller::parseSeed(const std::string &text) -> std::optional<std::uint64_t> {
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    try {
+        std::size_t processed = 0;
+        std::uint64_t value = 0;
+        if (text.starts_with("0x") || text.starts_with("0X")) {
+            value = std::stoull(text.substr(2), &processed, 16);
+            processed += 2;
+        } else {
+            value = std::stoull(text, &processed, 10);
+        }
+        if (processed != text.size() || text.find('-') != std::string::npos) {
+            return std::nullopt;
+        }
+        return value;
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+auto Controller::parseDuration(const std::string &text) -> std::optional<std::chrono::seconds> {
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    std::string number = text;
+    std::chrono::seconds::rep factor = 1;
+    switch (text.back()) {
+    case 's':
+        number.pop_back();
+        break;
+    case 'm':
+        number.pop_back();
+        factor = 60;
+        break;
+    case 'h':
+        number.pop_back();
+        factor = 3600;
+        break;
+    default:
+        break;
+    }
+    if (number.empty() || !std::ranges::all_of(number, [](char c) -> bool { return c >= '0' && c <= '9'; })) {
+        return std::nullopt;
+    }
+    try {
+        return std::chrono::seconds{std::stoll(number) * factor};
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+auto Controller::parseMemorySize(const std::string &text) -> std::optional<std::size_t> {
+    std::string number = text;
+    if (!number.empty() && number.back() == 'B') {
+        number.pop_back();
+    }
+    std::size_t factor = 1;
+    if (!number.empty()) {
+        switch (number.back()) {
+        case 'k':
+        case 'K':
+            factor = 1'000;
+            break;
+        case 'M':
+            factor = 1'000'000;
+            break;
+        case 'G':
+            factor = 1'000'000'000;
+            break;
+        case 'T':
+            factor = 1'000'000'000'000;
+            break;
+        default:
+            break;
+        }
+        if (factor > 1) {
+            number.pop_back();
+        }
+    }
+    if (number.empty() || !std::ranges::all_of(number, [](char c) -> bool { return c >= '0' && c <= '9'; })) {
+        return std::nullopt;
+    }
+    try {
+        const auto value = static_cast<std::size_t>(std::stoull(number));
+        if (value > std::numeric_limits<std::size_t>::max() / factor) {
+            return std::nullopt;
+        }
+        return value * factor;
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+}
+
+auto Controller::testMemoryLimit(TestClassBase *testClass, const std::size_t index) const noexcept -> std::size_t {
+    if (const auto limit = testClass->testMetaData(index).memoryLimit(); limit > 0) {
+        return limit;
+    }
+    if (const auto limit = testClass->metaData().memoryLimit(); limit > 0) {
+        return limit;
+    }
+    return _memoryLimit;
+}
+
+auto Controller::memoryLimitTestCount() const noexcept -> std::size_t {
+    std::size_t count = 0;
+    for (const auto &testClass : _testClasses) {
+        if (!testClass->isEnabled()) {
+            continue;
+        }
+        for (std::size_t i = 0; i < testClass->testCount(); ++i) {
+            if (testClass->test(i)->isEnabled() && testMemoryLimit(testClass, i) > 0) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+void Controller::reportMemoryLimitExceeded(const std::size_t memoryLimit) {
+    auto errorCapture = reportError("MEMORY LIMIT EXCEEDED!", ConsoleColor::Red);
+    auto context = std::format(
+        "The test exceeded its memory limit of {}.", memorySizeText(static_cast<std::int64_t>(memoryLimit)));
+    if (AllocationHook::isAvailable()) {
+        context += std::format(
+            " Peak memory: {}.", memorySizeText(static_cast<std::int64_t>(AllocationHook::peakBytes())));
+    }
+    console()->writeErrorInfo(context);
+    errorCapture->addContextInfo(context);
+}
+
+auto Controller::testStackSize(TestClassBase *testClass, const std::size_t index) const noexcept -> std::size_t {
+    if (const auto size = testClass->testMetaData(index).stackSize(); size > 0) {
+        return size;
+    }
+    if (const auto size = testClass->metaData().stackSize(); size > 0) {
+        return size;
+    }
+    return _stackSize;
+}
+
+void Controller::reportTestDetails(const std::size_t stackSize, const ResourceUsage &usage) {
+    if (_failingAllocation > 0) {
+        if (AllocationHook::isFailureInjected()) {
+            console()->writeDebug(std::format("Allocation {} of the test failed.", _failingAllocation));
+        } else {
+            console()->writeDebug(std::format("The test made only {} allocations, so allocation {} did not fail.",
+                AllocationHook::allocationCount(),
+                _failingAllocation));
+        }
+    }
+    if (_verbose && stackSize > 0 && TestStack::isSupported()) {
+        console()->writeDebug(std::format("Test stack: used {} of {} bytes.",
+            TestStack::lastUsedBytes(),
+            TestStack::effectiveSize(stackSize)));
+    }
+    if (_verbose) {
+        console()->writeDebug(std::format("Test usage: {}", usage.toText()));
+    }
+}
+
+void Controller::callTestMethod(TestClassBase *testClass, const std::size_t index) {
+    // Only the test method is measured, on the thread that runs it.
+    const auto usageBefore = ResourceUsage::current();
+    try {
+        if (testClass->test(index)->metaData().isFuzzMethod()) {
+            callFuzzTest(testClass, index);
+        } else {
+            testClass->callTest(index);
+        }
+    } catch (...) {
+        _testUsage = ResourceUsage::current() - usageBefore;
+        throw;
+    }
+    _testUsage = ResourceUsage::current() - usageBefore;
+}
+
+void Controller::callFuzzTest(TestClassBase *testClass, std::size_t index) {
+    Fuzzer fuzzer{*testClass, index};
+    if (_fuzzMode) {
+        const auto seed = RandomGenerator::mixSeed(_seed.value_or(0), RandomGenerator::hashText("fuzzer"));
+        fuzzer.run(_fuzzCorpus, _fuzzTime, seed);
+    } else {
+        fuzzer.replayCorpus();
+    }
+}
+
+auto Controller::runTest(TestClassBase *testClass, const std::size_t index) -> bool {
+    _testUsage = {};
+    if (_profileMode) {
+        Profiler::start(cProfileFrequency);
+    }
+    const auto success = callAndReportTest(testClass, index);
+    if (_profileMode) {
+        Profiler::stop();
+    }
+    const auto usage = _testUsage;
+    auto name = std::format("{} / {}", testClass->shortName(), testClass->test(index)->shortName());
+    _testUsages.emplace_back(std::move(name), usage);
+    reportTestDetails(testStackSize(testClass, index), usage);
+    if (_profileMode) {
+        writeProfile(testClass, index);
+    }
+    return success;
+}
+
+void Controller::writeProfile(TestClassBase *testClass, const std::size_t index) {
+    const auto path =
+        _profileDirectory / std::format("{}.{}.folded", testClass->shortName(), testClass->test(index)->shortName());
+    try {
+        const auto result = Profiler::writeFoldedStacks(path);
+        auto message = std::format("Profile: {} samples written to {}", result.sampleCount, path.string());
+        if (result.droppedCount > 0) {
+            message += std::format(" ({} samples dropped, because the buffer was full)", result.droppedCount);
+        }
+        console()->writeDebug(message);
+    } catch (const std::exception &ex) {
+        console()->writeError(std::format("Could not write the profile: {}", ex.what()));
+    }
+}
+
+auto Controller::callAndReportTest(TestClassBase *testClass, const std::size_t index) -> bool {
+    auto test = testClass->test(index);
+    const auto memoryLimit = testMemoryLimit(testClass, index);
+    const auto stackSize = testStackSize(testClass, index);
+    std::stringstream text;
+    const auto resourcesBefore = ResourceSnapshot::capture();
+    AllocationHook::startTest(memoryLimit, _failingAllocation);
+    try {
+        if (test->metaData().isPrintMethod()) {
+            _printMethodRunning = true;
+            text.str({});
+            text << "---{ start output from " << testClass->shortName() << " / " << test->shortName() << " }---";
+            console()->writeDebug(text.str());
+        }
+        if (stackSize > 0 && TestStack::isSupported()) {
+            TestStack::run(stackSize, [&]() -> void { callTestMethod(testClass, index); });
+        } else {
+            callTestMethod(testClass, index);
+        }
+        if (test->metaData().isPrintMethod()) {
+            _printMethodRunning = false;
+            text.str({});
+            text << "---{ end output from " << testClass->shortName() << " / " << test->shortName() << " }---";
+            console()->writeDebug(text.str());
+        }
+        const auto heapBytes = AllocationHook::isAvailable() ? AllocationHook::currentBytes() : 0;
+        AllocationHook::stopTest();
+        if (AllocationHook::isLimitExceeded()) {
+            // The test caught the `std::bad_alloc` exception, but it still exceeded its limit.
+            reportMemoryLimitExceeded(memoryLimit);
+            return false;
+        }
+        if (_waitAfterEachTest) {
+            std::this_thread::sleep_for(std::chrono::seconds{1});
+        }
+        const auto leaks = resourceLeaks(resourcesBefore, heapBytes);
+        if (!leaks.empty()) {
+            return reportResourceLeaks(leaks);
+        }
+        console()->finishTask("OK!", ConsoleColor::Green);
+        return true;
+    } catch (const AssertFailed &) {
+        AllocationHook::stopTest();
+        return false;
+    } catch (const std::exception &ex) {
+        AllocationHook::stopTest();
+        if (AllocationHook::isLimitExceeded() || (memoryLimit > 0 && !AllocationHook::isFailureInjected() &&
+                                                     dynamic_cast<const std::bad_alloc *>(&ex) != nullptr)) {
+            reportMemoryLimitExceeded(memoryLimit);
+            return false;
+        }
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        console()->writeErrorInfo("Exception outside of assert clause.");
+        errorCapture->addContextInfo("Exception outside of assert clause.");
+        auto exceptionType = std::string(typeid(ex).name());
+        auto exceptionMessage = std::string(ex.what());
+        text.str({});
+        text << "Exception Type: " << demangleTypeName(exceptionType) << "\n"
+             << "Exception Message: " << exceptionMessage;
+        console()->writeDebug(text.str());
+        errorCapture->addDebugInfo(text.str());
+        return false;
+    } catch (...) {
+        AllocationHook::stopTest();
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        console()->writeErrorInfo("Unknown exception outside of assert clause.");
+        errorCapture->addContextInfo("Unknown exception outside of assert clause.");
+        console()->writeDebug("Unknown exception.");
+        return false;
+    }
+}
+
+auto Controller::resourceLeaks(const ResourceSnapshot &before, const std::int64_t heapBytes) const
+    -> std::vector<std::string> {
+
+    auto after = ResourceSnapshot::capture(heapBytes);
+    // Threads that were joined or finished at the end of the test may need a moment to disappear.
+    constexpr auto cThreadExitTimeout = std::chrono::milliseconds{100};
+    const auto deadline = std::chrono::steady_clock::now() + cThreadExitTimeout;
+    while (after.threadCount() > before.threadCount() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        after = ResourceSnapshot::capture(heapBytes);
+    }
+    return after.leaksSince(before);
+}
+
+auto Controller::reportResourceLeaks(const std::vector<std::string> &leaks) -> bool {
+    std::string context;
+    for (const auto &leak : leaks) {
+        if (!context.empty()) {
+            context += "\n";
+        }
+        context += leak;
+    }
+    if (!_strictLeaks) {
+        console()->finishTask("LEAKED!", ConsoleColor::Yellow);
+        console()->writeErrorInfo(context);
+        return true;
+    }
+    auto errorCapture = reportError("LEAKED!", ConsoleColor::Red);
+    console()->writeErrorInfo(context);
+    errorCapture->addContextInfo(context);
+    return false;
+}
+
+auto Controller::runIsolatedTest(TestClassBase *testClass, const std::size_t index) -> bool {
+    const auto memoryLimit = testMemoryLimit(testClass, index);
+    const auto stackSize = testStackSize(testClass, index);
+    const auto outcome = ChildProcess::run([&]() -> std::string {
+        if (memoryLimit > 0) {
+            // Also limit allocations that bypass `operator new`. The address space grows faster than the allocated
+            // memory, because of stacks and the allocator overhead, so the exact limit is left to the hook.
+            constexpr std::size_t cAddressSpaceMargin = 64'000'000;
+            ChildProcess::limitAddressSpace(
+                AllocationHook::isAvailable() ? memoryLimit * 2 + cAddressSpaceMargin : memoryLimit);
+        }
+        const auto previousErrorCount = _capturedErrors.size();
+        const auto previousUsageCount = _testUsages.size();
+        const auto success = runTest(testClass, index);
+        sendTestUsages(previousUsageCount);
+        sendAssertStats();
+        if (_allocationFaults) {
+            ChildProcess::sendMessage(
+                std::format("A{} {}", AllocationHook::allocationCount(), AllocationHook::currentBytes()));
+        }
+        std::string message;
+        message.push_back(success ? '1' : '0');
+        for (auto it = std::next(_capturedErrors.begin(), static_cast<std::ptrdiff_t>(previousErrorCount));
+            it != _capturedErrors.end();
+            ++it) {
+            (*it)->serialize(message);
+        }
+        return message;
+    });
+    _testAllocationCount = 0;
+    _testAllocatedBytes = 0;
+    for (const auto &message : outcome.messages) {
+        if (message.starts_with('A')) {
+            std::stringstream{message.substr(1)} >> _testAllocationCount >> _testAllocatedBytes;
+        } else if (message.starts_with('U')) {
+            receiveTestUsage(std::string_view{message}.substr(1));
+        } else if (message.starts_with('T')) {
+            AssertStats::deserialize(std::string_view{message}.substr(1));
+        }
+    }
+    if (outcome.hasResult && !outcome.result.empty()) {
+        // The child process already wrote the result of the test.
+        console()->resetTask();
+        std::string_view message{outcome.result};
+        const auto success = (message.front() == '1');
+        message.remove_prefix(1);
+        while (!message.empty()) {
+            auto errorCapture = ErrorCapture::deserialize(message);
+            if (errorCapture == nullptr) {
+                break;
+            }
+            _capturedErrors.push_back(std::move(errorCapture));
+        }
+        return success;
+    }
+    auto errorCapture = reportError("CRASHED!", ConsoleColor::Red);
+    auto context = outcome.termination;
+    if (memoryLimit > 0) {
+        context += std::format(
+            " The test had a memory limit of {}.", memorySizeText(static_cast<std::int64_t>(memoryLimit)));
+    }
+    if (stackSize > 0) {
+        context += std::format(" The test had a stack size of {} bytes.", TestStack::effectiveSize(stackSize));
+    }
+    console()->writeErrorInfo(context);
+    errorCapture->addContextInfo(context);
+    return false;
+}
+
+auto Controller::runAllocationFaultTest(TestClassBase *testClass, const std::size_t index) -> bool {
+    // The first run counts the allocations, and the number of bytes that the test does not release.
+    if (!runIsolatedTest(testClass, index)) {
+        return false;
+    }
+    const auto allocationCount = _testAllocationCount;
+    if (allocationCount == 0) {
+        return true;
+    }
+    const auto testName = testClass->test(index)->shortName();
+    console()->startTask(std::format("  Allocation Faults: {}", testName), _currentTask, _totalTaskCount);
+    std::vector<ChildProcess::Outcome> outcomes;
+    try {
+        outcomes = ChildProcess::runParallel(allocationCount, [&](const std::size_t faultIndex) -> std::string {
+            return runAllocationFault(testClass, index, faultIndex + 1);
+        });
+    } catch (const std::exception &ex) {
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        const auto context = std::format("Could not run the test with allocation faults: {}", ex.what());
+        console()->writeErrorInfo(context);
+        errorCapture->addContextInfo(context);
+        return false;
+    }
+    std::vector<std::string> failures;
+    std::size_t firstFailingAllocation = 0;
+    for (std::size_t i = 0; i < outcomes.size(); ++i) {
+        const auto &failure = outcomes[i].hasResult ? outcomes[i].result : outcomes[i].termination;
+        if (failure.empty()) {
+            continue;
+        }
+        if (failures.empty()) {
+            firstFailingAllocation = i + 1;
+        }
+        failures.push_back(std::format("Allocation {}: {}", i + 1, failure));
+    }
+    if (failures.empty()) {
+        console()->finishTask("OK!", ConsoleColor::Green);
+        if (_verbose) {
+            console()->writeDebug(std::format("Each of the {} allocations failed once.", allocationCount));
+        }
+        return true;
+    }
+    constexpr std::size_t cMaximumReportedFailures = 5;
+    auto context = std::format(
+        "The test did not handle {} of {} allocation failures.", failures.size(), allocationCount);
+    for (std::size_t i = 0; i < failures.size() && i < cMaximumReportedFailures; ++i) {
+        context += "\n";
+        context += failures[i];
+    }
+    if (failures.size() > cMaximumReportedFailures) {
+        context += std::format("\n... ({} more)", failures.size() - cMaximumReportedFailures);
+    }
+    context += std::format("\nReplay with: --alloc-fault {} name:{}", firstFailingAllocation, testName);
+    auto errorCapture = reportError("FAILED!", ConsoleColor::Red);
+    console()->writeErrorInfo(context);
+    errorCapture->addContextInfo(context);
+    return false;
+}
+
+auto Controller::runAllocationFault(TestClassBase *testClass, const std::size_t index, const std::size_t allocation)
+    -> std::string {
+
+    const auto previousErrorCount = static_cast<std::ptrdiff_t>(_capturedErrors.size());
+    const auto stackSize = testStackSize(testClass, index);
+    AllocationHook::startTest(testMemoryLimit(testClass, index), allocation);
+    try {
+        if (stackSize > 0 && TestStack::isSupported()) {
+            TestStack::run(stackSize, [&]() -> void { testClass->callTest(index); });
+        } else {
+            testClass->callTest(index);
+        }
+    } catch (...) {
+        // Throwing an exception is a valid way to handle the failure, and failed assertions are checked below.
+    }
+    std::string failure;
+    const auto newErrors = std::next(_capturedErrors.begin(), previousErrorCount);
+    for (auto it = newErrors; it != _capturedErrors.end() && failure.empty(); ++it) {
+        // An assertion that failed because of an exception is expected, but not a wrong result.
+        if (!(*it)->isCausedByException()) {
+            failure = "An assertion failed.";
+            for (const auto &contextInfo : (*it)->contextInfo()) {
+                failure += "\n  ";
+                failure += contextInfo;
+            }
+        }
+    }
+    {
+        // The reported errors were allocated during a pause, so they must be released during one.
+        const AllocationHook::Pause allocationPause;
+        _capturedErrors.erase(newErrors, _capturedErrors.end());
+    }
+    const auto leakedBytes = AllocationHook::currentBytes() - _testAllocatedBytes;
+    AllocationHook::stopTest();
+    if (failure.empty() && leakedBytes > 0) {
+        failure = std::format("The test did not release {}.", memorySizeText(leakedBytes));
+    }
+    return failure;
+}
+
+auto Controller::runSuite(TestClassBase *testClass, const std::size_t firstTestIndex) -> bool {
+    std::stringstream text;
+    text << "Suite: " << testClass->shortName();
+    console()->startTask(text.str(), _currentTask, _totalTaskCount);
+    resetRandom();
+    startSuiteMemory();
+    try {
+        testClass->createUnitTest();
+    } catch (const std::exception &ex) {
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        console()->writeLine("Exception while creating the unit test instance.");
+        errorCapture->addContextInfo("Exception while creating the unit test instance.");
+        auto exceptionType = std::string(typeid(ex).name());
+        auto exceptionMessage = std::string(ex.what());
+        text.str({});
+        text << "Exception Type: " << demangleTypeName(exceptionType) << "\n"
+             << "Exception Message: " << exceptionMessage;
+        console()->writeDebug(text.str());
+        errorCapture->addDebugInfo(text.str());
+        ++_errorCount;
+        finishSuite(testClass);
+        return !_stopAtFirstError;
+    } catch (...) {
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        console()->writeErrorInfo("Unknown exception while creating the unit test instance.");
+        errorCapture->addContextInfo("Unknown exception while creating the unit test instance.");
+        console()->writeDebug("Unknown exception.");
+        ++_errorCount;
+        finishSuite(testClass);
+        return !_stopAtFirstError;
+    }
+    setCurrentTest("<setUpSuite>");
+    resetRandom();
+    if (!runSuiteFixture(testClass, true)) {
+        ++_errorCount;
+        finishSuite(testClass);
+        return !_stopAtFirstError;
+    }
+    if (_waitAfterEachTest) {
+        std::this_thread::sleep_for(std::chrono::seconds{1});
+    }
+    if (firstTestIndex == 0) {
+        console()->finishTask("Running", ConsoleColor::White);
+        ++_currentTask;
+    } else {
+        console()->finishTask("Resumed", ConsoleColor::White);
+    }
+    for (std::size_t i = firstTestIndex; i < testClass->testCount(); ++i) {
+        auto test = testClass->test(i);
+        text.str({});
+        if (test->metaData().isPrintMethod()) {
+            text << "  Print: " << test->shortName();
+        } else if (test->metaData().isFuzzMethod()) {
+            text << "  Fuzz: " << test->shortName();
+        } else {
+            text << "  Test: " << test->shortName();
+        }
+        if (test->isEnabled()) {
+            sendSupervisorProgress(std::format("S{}", i));
+            console()->startTask(text.str(), _currentTask, _totalTaskCount);
+        } else {
+            if (_verbose) {
+                console()->startTask(text.str(), _currentTask, _totalTaskCount);
+                console()->finishTask("Skipped", ConsoleColor::Orange);
+            }
+            continue;
+        }
+        setCurrentTest(test->shortName());
+        _fuzzInput.clear();
+        resetRandom();
+        bool success = false;
+        if (_allocationFaults && !test->metaData().isPrintMethod() && !test->metaData().isFuzzMethod()) {
+            success = runAllocationFaultTest(testClass, i);
+        } else if (_isolate) {
+            success = runIsolatedTest(testClass, i);
+        } else {
+            success = runTest(testClass, i);
+        }
+        if (!success) {
+            ++_errorCount;
+        }
+        sampleSuiteMemory();
+        ++_currentTask;
+        if (_stopAtFirstError && _errorCount > 0) {
+            break;
+        }
+    }
+    sendSupervisorProgress("D");
+    text.str({});
+    text << "  Tear Down Suite: " << testClass->shortName();
+    console()->startTask(text.str(), _currentTask - 1, _totalTaskCount);
+    setCurrentTest("<tearDownSuite>");
+    _fuzzInput.clear();
+    resetRandom();
+    if (runSuiteFixture(testClass, false)) {
+        console()->cancelTask();
+    } else {
+        ++_errorCount;
+    }
+    finishSuite(testClass);
+    return !(_stopAtFirstError && _errorCount > 0);
+}
+
+auto Controller::runSupervisedSuite(TestClassBase *testClass) -> bool {
+    std::size_t firstTestIndex = 0;
+    while (true) {
+        const auto outcome = ChildProcess::run([&]() -> std::string {
+            _sentErrorCount = _capturedErrors.size();
+            _sentUsageCount = _testUsages.size();
+            const auto shallContinue = runSuite(testClass, firstTestIndex);
+            sendSupervisorProgress({});
+            return shallContinue ? "1" : "0";
+        });
+        // Apply the progress of the child process.
+        std::optional<std::size_t> crashedTestIndex;
+        bool isTearDown = false;
+        for (const auto &message : outcome.messages) {
+            std::string_view data{message};
+            const auto type = data.front();
+            data.remove_prefix(1);
+            if (type == 'E') {
+                if (auto errorCapture = ErrorCapture::deserialize(data); errorCapture != nullptr) {
+                    _capturedErrors.push_back(std::move(errorCapture));
+                }
+            } else if (type == 'C') {
+                std::int64_t fixtureDuration = 0;
+                std::stringstream{std::string{data}} >> _errorCount >> _currentTask >> fixtureDuration;
+                _suiteFixtureDuration = std::chrono::nanoseconds{fixtureDuration};
+            } else if (type == 'S') {
+                crashedTestIndex = static_cast<std::size_t>(std::stoull(std::string{data}));
+            } else if (type == 'D') {
+                isTearDown = true;
+            } else if (type == 'U') {
+                receiveTestUsage(data);
+            } else if (type == 'T') {
+                AssertStats::deserialize(data);
+            }
+        }
+        if (outcome.hasResult) {
+            return outcome.result == "1";
+        }
+        // Report the crash for the test that was running, and resume the suite after it.
+        std::string task;
+        if (isTearDown) {
+            setCurrentTest("<tearDownSuite>");
+            task = std::format("  Tear Down Suite: {}", testClass->shortName());
+        } else if (crashedTestIndex.has_value()) {
+            setCurrentTest(testClass->test(*crashedTestIndex)->shortName());
+            task = std::format("  Test: {}", testClass->test(*crashedTestIndex)->shortName());
+        } else {
+            setCurrentTest("<setUpSuite>");
+            task = std::format("Suite: {}", testClass->shortName());
+        }
+        _fuzzInput.clear();
+        _randomUsed = false;
+        console()->startTask(task, _currentTask, _totalTaskCount);
+        auto errorCapture = reportError("CRASHED!", ConsoleColor::Red);
+        console()->writeErrorInfo(outcome.termination);
+        errorCapture->addContextInfo(outcome.termination);
+        ++_errorCount;
+        if (_stopAtFirstError || isTearDown || !crashedTestIndex.has_value()) {
+            return !_stopAtFirstError;
+        }
+        ++_currentTask;
+        firstTestIndex = *crashedTestIndex + 1;
+    }
+}
+
+void Controller::sendSupervisorProgress(const std::string &message) {
+    if (!_supervise) {
+        return;
+    }
+    for (auto it = std::next(_capturedErrors.begin(), static_cast<std::ptrdiff_t>(_sentErrorCount));
+        it != _capturedErrors.end();
+        ++it) {
+        std::string errorMessage{"E"};
+        (*it)->serialize(errorMessage);
+        ChildProcess::sendMessage(errorMessage);
+    }
+    _sentErrorCount = _capturedErrors.size();
+    sendTestUsages(_sentUsageCount);
+    _sentUsageCount = _testUsages.size();
+    sendAssertStats();
+    ChildProcess::sendMessage(std::format("C{} {} {}", _errorCount, _currentTask, _suiteFixtureDuration.count()));
+    if (!message.empty()) {
+        ChildProcess::sendMessage(message);
+    }
+}
+
+void Controller::sendTestUsages(const std::size_t firstIndex) {
+    for (auto i = firstIndex; i < _testUsages.size(); ++i) {
+        std::string message{"U"};
+        _testUsages[i].second.serialize(message);
+        message += _testUsages[i].first;
+        ChildProcess::sendMessage(message);
+    }
+}
+
+void Controller::receiveTestUsage(std::string_view message) {
+    if (const auto usage = ResourceUsage::deserialize(message); usage.has_value()) {
+        _testUsages.emplace_back(std::string{message}, *usage);
+    }
+}
+
+void Controller::sendAssertStats() {
+    if (!AssertStats::isEnabled()) {
+        return;
+    }
+    std::string message{"T"};
+    AssertStats::serialize(message);
+    if (message.size() > 1) {
+        ChildProcess::sendMessage(message);
+    }
+}
+
+void Controller::writeAssertStats(const std::chrono::nanoseconds runDuration) {
+    constexpr std::size_t cMaximumListedSites = 10;
+    const auto sites = AssertStats::sites();
+    if (sites.empty()) {
+        return;
+    }
+    std::uint64_t totalCount = 0;
+    std::chrono::nanoseconds totalTime{};
+    for (const auto &site : sites) {
+        totalCount += site.count;
+        totalTime += site.time;
+    }
+    const auto share = runDuration.count() > 0
+        ? 100.0 * static_cast<double>(totalTime.count()) / static_cast<double>(runDuration.count())
+        : 0.0;
+    console()->writeLine(std::format("Assertions with the most time ({} executions of {} assertions took {}, {:.1f}% "
+                                     "of the run):",
+        totalCount,
+        sites.size(),
+        durationText(totalTime),
+        share));
+    for (std::size_t i = 0; i < sites.size() && i < cMaximumListedSites; ++i) {
+        const auto &site = sites[i];
+        console()->writeLine(std::format("  {} in {} executions ({} ns each): {} at {}:{}",
+            durationText(site.time),
+            site.count,
+            site.time.count() / static_cast<std::int64_t>(site.count),
+            site.macroName,
+            site.file,
+            site.lineNo));
+    }
+}
+
+void Controller::writeSuiteFixtureDuration() {
+    if (_suiteFixtureDuration < std::chrono::milliseconds{1}) {
+        return;
+    }
+    const std::chrono::duration<double> fixtureDuration = _suiteFixtureDuration;
+    std::stringstream text;
+    text << "Suite Fixture Duration: " << std::setprecision(3) << fixtureDuration.count() << " seconds";
+    console()->writeLine(text.str());
+}
+
+void Controller::writeWaitingTests() {
+    // Tests with a lot more wall time than CPU time are waiting, e.g. for sleeps, timeouts or I/O.
+    constexpr std::size_t cMaximumListedTests = 5;
+    constexpr auto cMinimumWaitTime = std::chrono::milliseconds{10};
+    std::vector<const TestUsage *> waitingTests;
+    for (const auto &entry : _testUsages) {
+        if (entry.second.waitTime() >= cMinimumWaitTime) {
+            waitingTests.push_back(&entry);
+        }
+    }
+    if (waitingTests.empty()) {
+        return;
+    }
+    std::ranges::stable_sort(waitingTests, [](const auto *a, const auto *b) -> bool {
+        return a->second.waitTime() > b->second.waitTime();
+    });
+    console()->writeLine("Tests waiting the longest (wall minus CPU time):");
+    for (std::size_t i = 0; i < waitingTests.size() && i < cMaximumListedTests; ++i) {
+        const auto &[name, usage] = *waitingTests[i];
+        console()->writeLine(std::format("  {} waiting: {} ({} wall, {} CPU)",
+            durationText(usage.waitTime()),
+            name,
+            durationText(usage.wallTime),
+            durationText(usage.cpuTime())));
+    }
+}
+
+void Controller::setCurrentTest(const std::string &name) {
+    _currentTest = name;
+    CrashHandler::setCurrentTest(_currentSuite, _currentTest);
+}
+
+auto Controller::runSuiteFixture(TestClassBase *testClass, const bool isSetUp) -> bool {
+    const auto methodName = std::string{isSetUp ? "setUpSuite()" : "tearDownSuite()"};
+    const auto startTime = std::chrono::steady_clock::now();
+    bool success = false;
+    try {
+        if (isSetUp) {
+            testClass->callSetUpSuite();
+        } else {
+            testClass->callTearDownSuite();
+        }
+        success = true;
+    } catch (const AssertFailed &) {
+        // already reported.
+    } catch (const std::exception &ex) {
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        const auto context = std::format("Exception in {}.", methodName);
+        console()->writeErrorInfo(context);
+        errorCapture->addContextInfo(context);
+        const auto debugText = std::format("Exception Type: {}\nException Message: {}",
+            demangleTypeName(std::string(typeid(ex).name())), ex.what());
+        console()->writeDebug(debugText);
+        errorCapture->addDebugInfo(debugText);
+    } catch (...) {
+        auto errorCapture = reportError("EXCEPTION!", ConsoleColor::Red);
+        const auto context = std::format("Unknown exception in {}.", methodName);
+        console()->writeErrorInfo(context);
+        errorCapture->addContextInfo(context);
+        console()->writeDebug("Unknown exception.");
+    }
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+    _suiteFixtureDuration += duration;
+    if (_verbose && duration >= std::chrono::milliseconds{1}) {
+        const std::chrono::duration<double> seconds = duration;
+        console()->writeDebug(std::format("{}::{} took {:.3f} seconds", _currentSuite, methodName, seconds.count()));
+    }
+    return success;
+}
+
+void Controller::startSuiteMemory() noexcept {
+    _peakMemoryWasReset = resetPeakResidentMemorySize();
+    _processPeakMemory = peakResidentMemorySize();
+    _suitePeakMemory = residentMemorySize();
+}
+
+void Controller::sampleSuiteMemory() noexcept {
+    _suitePeakMemory = std::max(_suitePeakMemory, residentMemorySize());
+}
+
+void Controller::finishSuite(TestClassBase *testClass) {
+    sampleSuiteMemory();
+    auto peakMemory = _suitePeakMemory;
+    // Use the peak of the process, if it was reset or a new peak was reached while running this suite.
+    if (const auto processPeak = peakResidentMemorySize(); _peakMemoryWasReset || processPeak > _processPeakMemory) {
+        peakMemory = std::max(peakMemory, processPeak);
+    }
+    testClass->destroyUnitTest();
+    _sharedFixtures.releaseSuite(_currentSuite);
+    if (_verbose && peakMemory > 0) {
+        console()->writeDebug(std::format("Suite memory: peak {}, {} after release.",
+            memorySizeText(static_cast<std::int64_t>(peakMemory)),
+            memorySizeText(static_cast<std::int64_t>(residentMemorySize()))));
+    }
+}
+
+auto Controller::sharedFixture(
+    const std::string &name, const std::type_info &type, const SharedFixtures::Factory &factory) -> void * {
+    // Shared fixtures are kept after the test, so their memory is not counted for it.
+    const AllocationHook::Pause allocationPause;
+    return _sharedFixtures.acquire(name, type, _currentSuite, factory);
+}
+
+void Controller::setFuzzInput(const std::string &path) {
+    const AllocationHook::Pause allocationPause;
+    _fuzzInput = path;
+}
+
+void Controller::resetRandom() noexcept {
+    auto seed = RandomGenerator::mixSeed(_seed.value_or(0), RandomGenerator::hashText(_currentSuite));
+    seed = RandomGenerator::mixSeed(seed, RandomGenerator::hashText(_currentTest));
+    _random = RandomGenerator{seed};
+    _randomUsed = false;
+}
+
 }
@@ -5,14 +5,25 @@
 #include "Console.hpp"
 #include "ErrorCapture.hpp"
 #include "Filter.hpp"
+#include "ResourceUsage.hpp"
+#include "SharedFixtures.hpp"
 
+#include "../RandomGenerator.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <list>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace erbsland::unittest {
 
+class ResourceSnapshot;
 class TestClassBase;
 
 /// @internal
@@ -39,6 +50,20 @@ public:
     auto reportError(const std::string &result, ConsoleColor textColor) -> ErrorCapturePtr;
     /// Access the console.
     [[nodiscard]] auto console() const noexcept -> Console *;
+    /// Access the random generator for the current test.
+    /// Marks the generator as used, so the seed is reported if the test fails.
+    [[nodiscard]] auto random() noexcept -> RandomGenerator &;
+    /// Reset the random generator for the current suite and test.
+    void resetRandom() noexcept;
+    /// Set the path of the fuzz input that is currently tested, to report it with errors.
+    void setFuzzInput(const std::string &path);
+    /// Get a shared fixture for the current suite, and create it if required.
+    auto sharedFixture(const std::string &name, const std::type_info &type, const SharedFixtures::Factory &factory)
+        -> void *;
+
+private:
+    /// The resource usage of a test, with the name of its suite and test.
+    using TestUsage = std::pair<std::string, ResourceUsage>;
 
 private:
     /// Parse the command line arguments.
@@ -47,6 +72,88 @@ private:
     void printHelp();
     /// Print a list of all suites and tests.
     void printList();
+    /// Parse a seed value from the command line.
+    static auto parseSeed(const std::string &text) -> std::optional<std::uint64_t>;
+    /// Parse a duration from the command line.
+    static auto parseDuration(const std::string &text) -> std::optional<std::chrono::seconds>;
+    /// Parse a memory size from the command line, like `512M`.
+    static auto parseMemorySize(const std::string &text) -> std::optional<std::size_t>;
+    /// Get the memory limit for a test, from its metadata, the class metadata or the command line.
+    /// @return The limit in bytes, or zero if there is no limit.
+    [[nodiscard]] auto testMemoryLimit(TestClassBase *testClass, std::size_t index) const noexcept -> std::size_t;
+    /// Get the number of enabled tests with a memory limit.
+    [[nodiscard]] auto memoryLimitTestCount() const noexcept -> std::size_t;
+    /// Report a test that exceeded its memory limit.
+    void reportMemoryLimitExceeded(std::size_t memoryLimit);
+    /// Get the stack size for a test, from its metadata, the class metadata or the command line.
+    /// @return The stack size in bytes, or zero if the test runs on the main thread.
+    [[nodiscard]] auto testStackSize(TestClassBase *testClass, std::size_t index) const noexcept -> std::size_t;
+    /// Report the injected allocation failure, and the stack and resource usage of the last test in verbose mode.
+    void reportTestDetails(std::size_t stackSize, const ResourceUsage &usage);
+    /// Call a test or fuzz test method, and measure its resource usage.
+    void callTestMethod(TestClassBase *testClass, std::size_t index);
+    /// Write the profile of the last test.
+    void writeProfile(TestClassBase *testClass, std::size_t index);
+    /// Run or replay a fuzz test.
+    void callFuzzTest(TestClassBase *testClass, std::size_t index);
+    /// Run a suite, starting with the given test.
+    /// @return `false` if the run shall stop.
+    auto runSuite(TestClassBase *testClass, std::size_t firstTestIndex) -> bool;
+    /// Run a suite in a forked child process, and resume it with the next test if the child crashes.
+    /// @return `false` if the run shall stop.
+    auto runSupervisedSuite(TestClassBase *testClass) -> bool;
+    /// Send new errors, the counters and a progress message from a supervised child process.
+    void sendSupervisorProgress(const std::string &message);
+    /// Send the resource usage of the tests, starting with the given index, from a child process.
+    void sendTestUsages(std::size_t firstIndex);
+    /// Add the resource usage of a test, that was sent by a child process.
+    void receiveTestUsage(std::string_view message);
+    /// Send the assertion statistics from a child process, and reset them.
+    void sendAssertStats();
+    /// Write the assertions that took the most time.
+    /// @param runDuration The duration of the whole run.
+    void writeAssertStats(std::chrono::nanoseconds runDuration);
+    /// Write the tests that spent the most time waiting, instead of using the CPU.
+    void writeWaitingTests();
+    /// Write the time spent in suite fixtures, if it is significant.
+    void writeSuiteFixtureDuration();
+    /// Set the name of the current test.
+    void setCurrentTest(const std::string &name);
+    /// Run a test and report its result.
+    /// @return `true` if the test passed, `false` if it failed.
+    auto runTest(TestClassBase *testClass, std::size_t index) -> bool;
+    /// Call a test and report its result, without the details.
+    /// @return `true` if the test passed, `false` if it failed.
+    auto callAndReportTest(TestClassBase *testClass, std::size_t index) -> bool;
+    /// Get the resources that the last test did not release.
+    /// @param before The resources before the test.
+    /// @param heapBytes The number of bytes allocated by the test, that were not freed.
+    /// @return A description of the leaked resources, or an empty list.
+    [[nodiscard]] auto resourceLeaks(const ResourceSnapshot &before, std::int64_t heapBytes) const
+        -> std::vector<std::string>;
+    /// Report leaked resources as warning, or as failure with `--strict-leaks`.
+    /// @return `false` if the leaks fail the test.
+    auto reportResourceLeaks(const std::vector<std::string> &leaks) -> bool;
+    /// Run a test in a forked child process, that starts with a snapshot of the suite instance.
+    /// @return `true` if the test passed, `false` if it failed or crashed.
+    auto runIsolatedTest(TestClassBase *testClass, std::size_t index) -> bool;
+    /// Run a test in a forked child process, and then once more for each of its allocations, with this allocation
+    /// failing. The runs with failing allocations are distributed across all cores.
+    /// @return `true` if the test passed and handled all allocation failures.
+    auto runAllocationFaultTest(TestClassBase *testClass, std::size_t index) -> bool;
+    /// Run a test with a failing allocation, in a child process.
+    /// @param allocation The number of the allocation that fails, starting with 1.
+    /// @return An empty string if the test handled the failure, or a description of the problem.
+    auto runAllocationFault(TestClassBase *testClass, std::size_t index, std::size_t allocation) -> std::string;
+    /// Start tracking the memory usage for a new suite.
+    void startSuiteMemory() noexcept;
+    /// Sample the memory usage of the current suite.
+    void sampleSuiteMemory() noexcept;
+    /// Destroy the suite instance, release its shared fixtures and report the peak memory of the suite.
+    void finishSuite(TestClassBase *testClass);
+    /// Run the suite set-up or tear-down method of a test class, and report errors.
+    /// @return `true` on success, `false` if the method failed.
+    auto runSuiteFixture(TestClassBase *testClass, bool isSetUp) -> bool;
 
 public:
     static auto instance() -> Controller *;
@@ -60,11 +167,41 @@ private:
     bool _stopAtFirstError{false};               ///< If the unit test shall stop at the first error.
     bool _showSummary{true};                     ///< Flag if the summary with the last three errors is displayed.
     bool _waitAfterEachTest{false};              ///< Wait a second after each test.
+    std::optional<std::uint64_t> _seed{};        ///< The global random seed, if set on the command line.
+    bool _fuzzMode{false};                       ///< Run the fuzzer for the selected fuzz tests.
+    std::chrono::seconds _fuzzTime{60};          ///< The time to fuzz each selected test.
+    std::filesystem::path _fuzzCorpus{};         ///< The corpus directory for fuzzing, if set.
+    bool _profileMode{false};                    ///< Profile the selected tests.
+    std::filesystem::path _profileDirectory{};   ///< The directory for the profiles.
+    bool _isolate{false};                        ///< Run each test in a forked child process.
+    bool _supervise{false};                      ///< Run each suite in a forked child process.
+    std::size_t _memoryLimit{0};                 ///< The default memory limit for each test, or zero.
+    std::size_t _stackSize{0};                   ///< The default stack size for each test, or zero.
+    bool _allocationFaults{false};               ///< Fail each allocation of each test once.
+    std::size_t _failingAllocation{0};           ///< The allocation that fails in each test, or zero.
+    bool _strictLeaks{false};                    ///< Fail tests that leak resources, instead of warning.
 
-    std::string _currentSuite;                   ///< The current suite that is running.
-    std::string _currentTest;                    ///< The current test that is running.
-    bool _printMethodRunning{false};             ///< Flag while a print method is running.
-    std::list<ErrorCapturePtr> _capturedErrors;  ///< The list with captured errors.
+    int _errorCount{0};                               ///< The number of errors in this run.
+    int _currentTask{1};                              ///< The number of the current task.
+    int _totalTaskCount{0};                           ///< The total number of tasks.
+    std::size_t _sentErrorCount{0};                   ///< The number of errors sent to the supervisor.
+    std::string _currentSuite;                        ///< The current suite that is running.
+    std::string _currentTest;                         ///< The current test that is running.
+    bool _printMethodRunning{false};                  ///< Flag while a print method is running.
+    std::list<ErrorCapturePtr> _capturedErrors;       ///< The list with captured errors.
+    RandomGenerator _random{};                        ///< The random generator for the current test.
+    bool _randomUsed{false};                          ///< If the current test used the random generator.
+    std::string _fuzzInput;                           ///< The path of the currently tested fuzz input.
+    std::chrono::nanoseconds _suiteFixtureDuration{}; ///< The time spent in suite set-up and tear-down.
+    SharedFixtures _sharedFixtures{};                 ///< The shared fixtures for all suites.
+    bool _peakMemoryWasReset{false};                  ///< If the process peak memory was reset for the suite.
+    std::size_t _processPeakMemory{0};                ///< The process peak memory at the start of the suite.
+    std::size_t _suitePeakMemory{0};                  ///< The highest sampled memory usage of the suite.
+    std::size_t _testAllocationCount{0};              ///< The allocations of the last isolated test.
+    std::int64_t _testAllocatedBytes{0};              ///< The bytes the last isolated test did not release.
+    ResourceUsage _testUsage{};                       ///< The resource usage of the last test method.
+    std::vector<TestUsage> _testUsages;               ///< The resource usage of each test.
+    std::size_t _sentUsageCount{0};                   ///< The number of usages sent to the supervisor.
 };
 
 }
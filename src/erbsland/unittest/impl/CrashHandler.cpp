@@ -0,0 +1,217 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "CrashHandler.hpp"
+
+#include "AssertContext.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstring>
+
+#if defined(ERBSLAND_OS_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define ERBSLAND_UNITTEST_HAS_BACKTRACE
+#endif
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// The size of the buffers for the suite and test names.
+constexpr std::size_t cNameSize = 256;
+/// The maximum number of frames in the backtrace.
+constexpr int cMaximumFrames = 64;
+
+/// The signals that are handled.
+#if defined(ERBSLAND_OS_WINDOWS)
+constexpr std::array<int, 4> cSignals = {SIGSEGV, SIGFPE, SIGABRT, SIGILL};
+#else
+constexpr std::array<int, 5> cSignals = {SIGSEGV, SIGBUS, SIGFPE, SIGABRT, SIGILL};
+#endif
+
+std::array<char, cNameSize> gSuiteName{};                                          ///< The current suite.
+std::array<char, cNameSize> gTestName{};                                           ///< The current test.
+std::array<const AssertContext *, CrashHandler::cMaximumContextDepth> gContexts{}; ///< The active contexts.
+std::atomic<std::size_t> gContextDepth{0};                                         ///< The number of contexts.
+std::atomic_flag gIsHandlingCrash = ATOMIC_FLAG_INIT;                              ///< Prevent recursive reports.
+std::array<bool, cSignals.size()> gIsInstalled{};                                  ///< The installed handlers.
+
+/// Write text to `stderr`.
+void writeText(const char *text) noexcept {
+    if (text == nullptr) {
+        return;
+    }
+#if defined(ERBSLAND_OS_WINDOWS)
+    (void)_write(2, text, static_cast<unsigned int>(std::strlen(text)));
+#else
+    (void)::write(STDERR_FILENO, text, std::strlen(text));
+#endif
+}
+
+/// Write a decimal number to `stderr`.
+void writeNumber(long long value) noexcept {
+    std::array<char, 24> buffer{};
+    auto position = buffer.size() - 1;
+    const bool isNegative = value < 0;
+    auto magnitude = static_cast<unsigned long long>(value);
+    if (isNegative) {
+        magnitude = 0ULL - magnitude;
+    }
+    do {
+        buffer[--position] = static_cast<char>('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    } while (magnitude > 0 && position > 1);
+    if (isNegative) {
+        buffer[--position] = '-';
+    }
+    writeText(buffer.data() + position);
+}
+
+/// Get the name of a handled signal.
+auto signalName(const int signal) noexcept -> const char * {
+    switch (signal) {
+    case SIGSEGV:
+        return "SIGSEGV";
+#if !defined(ERBSLAND_OS_WINDOWS)
+    case SIGBUS:
+        return "SIGBUS";
+#endif
+    case SIGFPE:
+        return "SIGFPE";
+    case SIGABRT:
+        return "SIGABRT";
+    case SIGILL:
+        return "SIGILL";
+    default:
+        return "unknown signal";
+    }
+}
+
+/// Copy a name into a static buffer, and shorten it if necessary.
+void copyName(std::array<char, cNameSize> &buffer, const std::string &name) noexcept {
+    const auto size = std::min(name.size(), buffer.size() - 1);
+    std::memcpy(buffer.data(), name.data(), size);
+    buffer[size] = '\0';
+}
+
+/// The signal handler.
+void handleCrash(int signal) {
+    if (!gIsHandlingCrash.test_and_set()) {
+        writeText("\n*** CRASH: Signal ");
+        writeNumber(signal);
+        writeText(" (");
+        writeText(signalName(signal));
+        writeText(") ***\nSuite: ");
+        writeText(gSuiteName.data());
+        writeText("\nTest: ");
+        writeText(gTestName.data());
+        writeText("\n");
+        const auto depth = std::min(gContextDepth.load(), gContexts.size());
+        for (auto i = depth; i > 0; --i) {
+            const auto *context = gContexts[i - 1];
+            writeText("[");
+            writeNumber(static_cast<long long>(i));
+            writeText("]: ");
+            if (context->sourceLocation.file != nullptr) {
+                writeText(context->sourceLocation.file);
+                writeText(":");
+                writeNumber(context->sourceLocation.lineNo);
+                writeText(": ");
+            }
+            if (context->macroName != nullptr && context->expression != nullptr) {
+                writeText(context->macroName);
+                writeText("(");
+                writeText(context->expression);
+                writeText(")");
+            }
+            writeText("\n");
+        }
+#if defined(ERBSLAND_UNITTEST_HAS_BACKTRACE)
+        writeText("Backtrace:\n");
+        std::array<void *, cMaximumFrames> frames{};
+        const auto frameCount = ::backtrace(frames.data(), cMaximumFrames);
+        ::backtrace_symbols_fd(frames.data(), frameCount, STDERR_FILENO);
+#endif
+    }
+    // Terminate the process with the original signal, so the exit status stays the same.
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+}
+
+void CrashHandler::install() noexcept {
+#if defined(ERBSLAND_UNITTEST_HAS_BACKTRACE)
+    // The first call of `backtrace()` may load a library, which must not happen in the signal handler.
+    std::array<void *, 1> frames{};
+    (void)::backtrace(frames.data(), 1);
+#endif
+#if defined(ERBSLAND_OS_WINDOWS)
+    for (std::size_t i = 0; i < cSignals.size(); ++i) {
+        const auto previous = std::signal(cSignals[i], handleCrash);
+        if (previous != SIG_DFL && previous != SIG_ERR) {
+            std::signal(cSignals[i], previous);
+        } else {
+            gIsInstalled[i] = (previous != SIG_ERR);
+        }
+    }
+#else
+    // Use an alternate stack, to report stack overflows.
+    static std::array<char, 64 * 1024> alternateStack{};
+    stack_t stack{};
+    stack.ss_sp = alternateStack.data();
+    stack.ss_size = alternateStack.size();
+    stack.ss_flags = 0;
+    (void)::sigaltstack(&stack, nullptr);
+    for (std::size_t i = 0; i < cSignals.size(); ++i) {
+        struct sigaction previous {};
+        if (::sigaction(cSignals[i], nullptr, &previous) != 0 || previous.sa_handler != SIG_DFL) {
+            continue;
+        }
+        struct sigaction action {};
+        action.sa_handler = handleCrash;
+        action.sa_flags = SA_ONSTACK | SA_RESETHAND;
+        sigemptyset(&action.sa_mask);
+        gIsInstalled[i] = (::sigaction(cSignals[i], &action, nullptr) == 0);
+    }
+#endif
+}
+
+void CrashHandler::restoreDefaults() noexcept {
+    for (std::size_t i = 0; i < cSignals.size(); ++i) {
+        if (gIsInstalled[i]) {
+            std::signal(cSignals[i], SIG_DFL);
+            gIsInstalled[i] = false;
+        }
+    }
+}
+
+void CrashHandler::setCurrentTest(const std::string &suite, const std::string &test) noexcept {
+    copyName(gSuiteName, suite);
+    copyName(gTestName, test);
+}
+
+void CrashHandler::pushContext(const AssertContext *context) noexcept {
+    const auto depth = gContextDepth.load(std::memory_order_relaxed);
+    if (depth < gContexts.size()) {
+        gContexts[depth] = context;
+    }
+    gContextDepth.store(depth + 1, std::memory_order_release);
+}
+
+void CrashHandler::popContext() noexcept {
+    const auto depth = gContextDepth.load(std::memory_order_relaxed);
+    if (depth > 0) {
+        gContextDepth.store(depth - 1, std::memory_order_release);
+    }
+}
+
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace erbsland::unittest {
+
+class AssertContext;
+
+/// @internal
+/// Reports the running test if the process crashes.
+///
+/// The handler is called for `SIGSEGV`, `SIGBUS`, `SIGFPE`, `SIGABRT` and `SIGILL`. It writes the current suite
+/// and test, the active assert contexts and a backtrace to `stderr`, and then terminates the process with the
+/// original signal. All information is kept in static buffers, as the handler must not allocate memory.
+///
+class CrashHandler {
+public:
+    /// The maximum number of nested contexts, that are reported.
+    static constexpr std::size_t cMaximumContextDepth = 32;
+
+public:
+    /// Install the signal handlers.
+    /// Signals that already have a handler, e.g. from a sanitizer, are not changed.
+    static void install() noexcept;
+    /// Restore the default action for all signals that were handled.
+    /// This is used in child processes, that are expected to terminate.
+    static void restoreDefaults() noexcept;
+    /// Set the suite and test that are currently running.
+    static void setCurrentTest(const std::string &suite, const std::string &test) noexcept;
+    /// Add an active assert context.
+    static void pushContext(const AssertContext *context) noexcept;
+    /// Remove the last active assert context.
+    static void popContext() noexcept;
+};
+
+}
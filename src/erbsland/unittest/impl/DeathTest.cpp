@@ -0,0 +1,129 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "DeathTest.hpp"
+
+#include "AssertContext.hpp"
+#include "ChildProcess.hpp"
+#include "CrashHandler.hpp"
+#include "Demangle.hpp"
+#include "TextHelperImpl.hpp"
+
+#include "../TextHelper.hpp"
+
+#include <algorithm>
+#include <format>
+#include <string>
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// The maximum number of lines from the error output, that are shown in a failure message.
+constexpr std::size_t cMaximumOutputLines = 20;
+
+/// Describe the captured error output for a failure message.
+auto errorOutputText(const std::string &errorOutput) -> std::string {
+    if (errorOutput.empty()) {
+        return "\n  The process wrote no error output.";
+    }
+    const auto lines = th::splitLines(errorOutput);
+    std::string result = "\n  Error output:";
+    for (std::size_t i = 0; i < lines.size() && i < cMaximumOutputLines; ++i) {
+        result += "\n    ";
+        result += lines[i];
+    }
+    if (lines.size() > cMaximumOutputLines) {
+        result += std::format("\n    ... ({} more lines)", lines.size() - cMaximumOutputLines);
+    }
+    return result;
+}
+
+/// Test the outcome of the child process.
+/// @return An empty string on success, or the failure message.
+auto verifyOutcome(
+    const ChildProcess::Outcome &outcome, const std::optional<int> exitCode, const std::string_view pattern)
+    -> std::string {
+
+    if (outcome.hasResult) {
+        if (!outcome.result.empty()) {
+            return std::format("The expression threw an exception instead of terminating the process: {}{}",
+                outcome.result, errorOutputText(outcome.errorOutput));
+        }
+        return std::format("The expression returned without terminating the process.{}",
+            errorOutputText(outcome.errorOutput));
+    }
+    if (exitCode.has_value()) {
+        if (outcome.exitCode != exitCode) {
+            const auto termination = outcome.exitCode.has_value()
+                ? std::format("The process exited with code {}.", *outcome.exitCode)
+                : outcome.termination;
+            return std::format("Expected the process to exit with code {}. {}{}",
+                *exitCode, termination, errorOutputText(outcome.errorOutput));
+        }
+    } else if (outcome.exitCode == 0) {
+        return std::format("Expected the process to terminate with an error, but it exited with code 0.{}",
+            errorOutputText(outcome.errorOutput));
+    }
+    if (!pattern.empty()) {
+        const auto lines = th::splitLines(outcome.errorOutput);
+        if (std::ranges::none_of(lines, [&](const std::string &line) -> bool {
+                return th::impl::compareWithStarAndQuestionMark(pattern, std::string_view{line});
+            })) {
+            return std::format("No line of the error output matches the pattern \"{}\".{}",
+                pattern, errorOutputText(outcome.errorOutput));
+        }
+    }
+    return {};
+}
+
+}
+
+void requireDeath(UnitTest *test,
+    const int flags,
+    const char *macroName,
+    const char *expr,
+    const SourceLocation loc,
+    const std::optional<int> exitCode,
+    const std::string_view pattern,
+    const std::function<void()> &func) {
+
+    AssertContext ctx{test, flags, macroName, expr, loc};
+    if (!ChildProcess::isSupported()) {
+        ctx.exceptionType = "requireComparison";
+        ctx.exceptionMessage = "Death tests are not supported on this platform.";
+        ctx.unexpectedResult();
+        return;
+    }
+    ChildProcess::Outcome outcome;
+    try {
+        outcome = ChildProcess::run(
+            [&]() -> std::string {
+                // The termination is expected, so it must not be reported as a crash.
+                CrashHandler::restoreDefaults();
+                try {
+                    func();
+                } catch (const std::exception &ex) {
+                    return std::format("{}: {}", demangleTypeName(typeid(ex).name()), ex.what());
+                } catch (...) {
+                    return "unknown exception";
+                }
+                return {};
+            },
+            true);
+    } catch (const std::exception &ex) {
+        ctx.exceptionType = std::string(typeid(ex).name());
+        ctx.exceptionMessage = std::string(ex.what());
+        ctx.unexpectedException();
+        return;
+    }
+    const auto message = verifyOutcome(outcome, exitCode, pattern);
+    if (message.empty()) {
+        ctx.expectedResult();
+    } else {
+        ctx.exceptionType = "requireComparison";
+        ctx.exceptionMessage = message;
+        ctx.unexpectedResult();
+    }
+}
+
+}
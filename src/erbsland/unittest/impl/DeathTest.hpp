@@ -0,0 +1,39 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "SourceLocation.hpp"
+
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace erbsland::unittest {
+
+class UnitTest;
+
+/// Verifies that the provided function terminates the process.
+///
+/// The function is called in a forked child process, without `exec()`. The error output of the child is captured,
+/// and the crash handler is disabled in the child, so only the output of the tested code is captured.
+///
+/// @param test The UnitTest instance in which this check is running.
+/// @param flags Flags that modify assertion behavior.
+/// @param macroName The name of the macro that invoked this check (e.g. "REQUIRE_DEATH").
+/// @param expr The textual representation of the call or expression expected to terminate the process.
+/// @param loc The source location where the check was invoked.
+/// @param exitCode The expected exit code. If not set, the process must exit with a non-zero code or by a signal.
+/// @param pattern A pattern, that must match at least one line of the error output. May contain any number of
+///     `*` and `?` wildcards, `\*` and `\?` match the characters literally, and other backslashes are literal.
+///     See `matchesWildcardPattern()`. An empty pattern matches any output.
+/// @param func The function or lambda that should terminate the process.
+void requireDeath(UnitTest *test,
+    int flags,
+    const char *macroName,
+    const char *expr,
+    SourceLocation loc,
+    std::optional<int> exitCode,
+    std::string_view pattern,
+    const std::function<void()> &func);
+
+}
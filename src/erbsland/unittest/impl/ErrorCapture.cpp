@@ -2,10 +2,76 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "ErrorCapture.hpp"
 
+#include <cstdint>
+#include <cstring>
+#include <optional>
 #include <utility>
 
 namespace erbsland::unittest {
 
+namespace {
+
+/// Append a size value to a message.
+void appendSize(std::string &message, const std::size_t size) {
+    const auto value = static_cast<std::uint32_t>(size);
+    message.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/// Append a string to a message.
+void appendString(std::string &message, const std::string &text) {
+    appendSize(message, text.size());
+    message.append(text);
+}
+
+/// Read a size value from a message.
+auto readSize(std::string_view &message) -> std::optional<std::size_t> {
+    std::uint32_t value = 0;
+    if (message.size() < sizeof(value)) {
+        return std::nullopt;
+    }
+    std::memcpy(&value, message.data(), sizeof(value));
+    message.remove_prefix(sizeof(value));
+    return static_cast<std::size_t>(value);
+}
+
+/// Read a string from a message.
+auto readString(std::string_view &message) -> std::optional<std::string> {
+    const auto size = readSize(message);
+    if (!size.has_value() || message.size() < *size) {
+        return std::nullopt;
+    }
+    auto result = std::string{message.substr(0, *size)};
+    message.remove_prefix(*size);
+    return result;
+}
+
+/// Append a list of strings to a message.
+void appendList(std::string &message, const std::list<std::string> &list) {
+    appendSize(message, list.size());
+    for (const auto &text : list) {
+        appendString(message, text);
+    }
+}
+
+/// Read a list of strings from a message.
+auto readList(std::string_view &message) -> std::optional<std::list<std::string>> {
+    const auto size = readSize(message);
+    if (!size.has_value()) {
+        return std::nullopt;
+    }
+    std::list<std::string> result;
+    for (std::size_t i = 0; i < *size; ++i) {
+        auto text = readString(message);
+        if (!text.has_value()) {
+            return std::nullopt;
+        }
+        result.push_back(std::move(*text));
+    }
+    return result;
+}
+
+}
+
 ErrorCapture::ErrorCapture(std::string suite, std::string test, std::string result, const ConsoleColor resultColor) :
     _suite{std::move(suite)}, _test{std::move(test)}, _result{std::move(result)}, _resultColor{resultColor} {
 }
@@ -18,6 +84,43 @@ void ErrorCapture::addDebugInfo(const std::string &debugLine) {
     _debugInfo.push_back(debugLine);
 }
 
+void ErrorCapture::setCausedByException(const bool causedByException) {
+    _causedByException = causedByException;
+}
+
+void ErrorCapture::serialize(std::string &message) const {
+    appendString(message, _suite);
+    appendString(message, _test);
+    appendString(message, _result);
+    message.push_back(static_cast<char>(_resultColor.value()));
+    message.push_back(_causedByException ? '\x01' : '\x00');
+    appendList(message, _contextInfo);
+    appendList(message, _debugInfo);
+}
+
+auto ErrorCapture::deserialize(std::string_view &message) -> std::shared_ptr<ErrorCapture> {
+    auto suite = readString(message);
+    auto test = readString(message);
+    auto result = readString(message);
+    if (!suite.has_value() || !test.has_value() || !result.has_value() || message.size() < 2) {
+        return nullptr;
+    }
+    const auto color = ConsoleColor{static_cast<ConsoleColor::Value>(message.front())};
+    const auto causedByException = message[1] != '\x00';
+    message.remove_prefix(2);
+    auto contextInfo = readList(message);
+    auto debugInfo = readList(message);
+    if (!contextInfo.has_value() || !debugInfo.has_value()) {
+        return nullptr;
+    }
+    auto errorCapture =
+        std::make_shared<ErrorCapture>(std::move(*suite), std::move(*test), std::move(*result), color);
+    errorCapture->_contextInfo = std::move(*contextInfo);
+    errorCapture->_debugInfo = std::move(*debugInfo);
+    errorCapture->_causedByException = causedByException;
+    return errorCapture;
+}
+
 auto ErrorCapture::suite() const -> const std::string & {
     return _suite;
 }
@@ -42,4 +145,8 @@ auto ErrorCapture::debugInfo() const -> const std::list<std::string> & {
     return _debugInfo;
 }
 
+auto ErrorCapture::isCausedByException() const -> bool {
+    return _causedByException;
+}
+
 }
@@ -6,6 +6,8 @@
 
 #include <list>
 #include <memory>
+#include <string>
+#include <string_view>
 
 namespace erbsland::unittest {
 
@@ -20,6 +22,13 @@ public:
     void addContextInfo(const std::string &infoLine);
     /// Add debug information.
     void addDebugInfo(const std::string &debugLine);
+    /// Mark this error as caused by an exception, instead of a wrong result.
+    void setCausedByException(bool causedByException);
+    /// Append this error capture in a binary form to a message.
+    void serialize(std::string &message) const;
+    /// Read an error capture from the beginning of a message, and remove it from the message.
+    /// @return The error capture, or `nullptr` if the message is incomplete.
+    [[nodiscard]] static auto deserialize(std::string_view &message) -> std::shared_ptr<ErrorCapture>;
 
 public:
     [[nodiscard]] auto suite() const -> const std::string &;
@@ -28,6 +37,7 @@ public:
     [[nodiscard]] auto resultColor() const -> ConsoleColor;
     [[nodiscard]] auto contextInfo() const -> const std::list<std::string> &;
     [[nodiscard]] auto debugInfo() const -> const std::list<std::string> &;
+    [[nodiscard]] auto isCausedByException() const -> bool;
 
 private:
     std::string _suite;
@@ -36,6 +46,7 @@ private:
     ConsoleColor _resultColor;
     std::list<std::string> _contextInfo;
     std::list<std::string> _debugInfo;
+    bool _causedByException{false};
 };
 
 using ErrorCapturePtr = std::shared_ptr<ErrorCapture>;
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+// This file implements the SanitizerCoverage callbacks for the fuzzer. It is only linked into the unittest
+// executable if the test code is compiled with coverage instrumentation, as no other code references it.
+
+#include "Definitions.hpp"
+#include "Fuzzer.hpp"
+
+#if defined(ERBSLAND_COMPILER_CLANG) || defined(ERBSLAND_COMPILER_GCC)
+
+#if defined(ERBSLAND_COMPILER_CLANG)
+#define ERBSLAND_UNITTEST_NO_COVERAGE __attribute__((no_sanitize("coverage")))
+#elif __GNUC__ >= 12
+#define ERBSLAND_UNITTEST_NO_COVERAGE __attribute__((no_sanitize_coverage))
+#else
+#define ERBSLAND_UNITTEST_NO_COVERAGE
+#endif
+
+using erbsland::unittest::FuzzCoverage;
+
+namespace {
+
+std::uint32_t gNextGuardId = 0; ///< The next identifier for a guard.
+
+}
+
+extern "C" {
+
+/// Assign a unique identifier to each edge guard (Clang `-fsanitize-coverage=trace-pc-guard`).
+ERBSLAND_UNITTEST_NO_COVERAGE void __sanitizer_cov_trace_pc_guard_init(std::uint32_t *start, std::uint32_t *stop) {
+    if (start == stop || *start != 0) {
+        return;
+    }
+    for (auto *guard = start; guard < stop; ++guard) {
+        *guard = ++gNextGuardId;
+    }
+    FuzzCoverage::isAvailable = true;
+}
+
+/// Count an edge (Clang `-fsanitize-coverage=trace-pc-guard`).
+ERBSLAND_UNITTEST_NO_COVERAGE void __sanitizer_cov_trace_pc_guard(std::uint32_t *guard) {
+    ++FuzzCoverage::counters[*guard & (FuzzCoverage::cMapSize - 1U)];
+}
+
+/// Count a basic block transition (GCC `-fsanitize-coverage=trace-pc`).
+ERBSLAND_UNITTEST_NO_COVERAGE void __sanitizer_cov_trace_pc() {
+    auto location = reinterpret_cast<std::uintptr_t>(__builtin_return_address(0));
+    location ^= location >> 16U;
+    ++FuzzCoverage::counters[(location ^ FuzzCoverage::previousLocation) & (FuzzCoverage::cMapSize - 1U)];
+    FuzzCoverage::previousLocation = location >> 1U;
+    FuzzCoverage::isAvailable = true;
+}
+
+}
+
+#endif
@@ -0,0 +1,450 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "Fuzzer.hpp"
+
+#include "Controller.hpp"
+#include "Definitions.hpp"
+#include "TestClassBase.hpp"
+
+#include "../FileHelper.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <span>
+
+#ifndef ERBSLAND_OS_WINDOWS
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace erbsland::unittest {
+
+alignas(64) std::array<std::uint8_t, FuzzCoverage::cMapSize> FuzzCoverage::counters{};
+std::uintptr_t FuzzCoverage::previousLocation{0};
+bool FuzzCoverage::isAvailable{false};
+
+void FuzzCoverage::reset() noexcept {
+    counters.fill(0);
+    previousLocation = 0;
+}
+
+namespace {
+
+/// Convert the hit count of an edge into a bucket bit.
+constexpr auto bucketBit(const std::uint8_t count) noexcept -> std::uint8_t {
+    if (count == 0) {
+        return 0;
+    }
+    if (count <= 3) {
+        return static_cast<std::uint8_t>(1U << (count - 1U));
+    }
+    if (count <= 7) {
+        return 8;
+    }
+    if (count <= 15) {
+        return 16;
+    }
+    if (count <= 31) {
+        return 32;
+    }
+    if (count <= 127) {
+        return 64;
+    }
+    return 128;
+}
+
+/// Values that often trigger edge cases.
+constexpr std::array<std::uint8_t, 10> cInterestingBytes = {0x00, 0x01, 0x7f, 0x80, 0xff, 0x20, 0x0a, 0x30, 0x39, 0x2d};
+
+/// The prefix for files with inputs that caused a failure.
+constexpr std::string_view cCrashPrefix = "crash-";
+
+/// Read a complete file into a string.
+auto readInputFile(const std::filesystem::path &path) -> std::string {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {
+        return {};
+    }
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+/// Convert an input into a span of bytes.
+auto toBytes(const std::string &data) noexcept -> std::span<const std::byte> {
+    return {reinterpret_cast<const std::byte *>(data.data()), data.size()};
+}
+
+#ifndef ERBSLAND_OS_WINDOWS
+
+// The state for the crash signal handler. Only accessed from the main thread and the signal handler.
+const char *gCrashInputData = nullptr;        ///< The currently executed input.
+std::size_t gCrashInputSize = 0;              ///< The size of the currently executed input.
+std::array<char, 4096> gCrashDirectory{};     ///< The corpus directory as null terminated string.
+constexpr std::array cCrashSignals = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+std::array<struct sigaction, cCrashSignals.size()> gPreviousActions{}; ///< The previous signal handlers.
+
+/// Write a text to a file descriptor, in an async-signal-safe way.
+void writeToFd(const int fd, const char *data, std::size_t size) noexcept {
+    while (size > 0) {
+        const auto written = ::write(fd, data, size);
+        if (written <= 0) {
+            return;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+/// Pass a signal to the handler that was installed before the fuzzer, e.g. the crash report of the controller.
+void callPreviousHandler(const int signal, siginfo_t *info, void *context) noexcept {
+    const auto it = std::ranges::find(cCrashSignals, signal);
+    if (it == cCrashSignals.end()) {
+        return;
+    }
+    const auto &previous = gPreviousActions[static_cast<std::size_t>(it - cCrashSignals.begin())];
+    if ((previous.sa_flags & SA_SIGINFO) != 0) {
+        previous.sa_sigaction(signal, info, context);
+    } else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN) {
+        previous.sa_handler(signal);
+    }
+}
+
+/// Save the current input if the process crashes.
+void handleCrashSignal(const int signal, siginfo_t *info, void *context) {
+    // Only async-signal-safe functions must be used in this handler.
+    std::array<char, 4200> path{};
+    std::size_t length = 0;
+    for (; length < gCrashDirectory.size() && gCrashDirectory[length] != '\0'; ++length) {
+        path[length] = gCrashDirectory[length];
+    }
+    path[length++] = '/';
+    for (const auto c : cCrashPrefix) {
+        path[length++] = c;
+    }
+    const auto hash = RandomGenerator::hashText(std::string_view{gCrashInputData, gCrashInputSize});
+    for (int shift = 60; shift >= 0; shift -= 4) {
+        path[length++] = "0123456789abcdef"[(hash >> static_cast<unsigned>(shift)) & 0xfU];
+    }
+    path[length] = '\0';
+    const auto fd = ::open(path.data(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        writeToFd(fd, gCrashInputData, gCrashInputSize);
+        ::close(fd);
+        constexpr std::string_view message = "\nFuzzer: Crash input saved to: ";
+        writeToFd(STDERR_FILENO, message.data(), message.size());
+        writeToFd(STDERR_FILENO, path.data(), length);
+        writeToFd(STDERR_FILENO, "\n", 1);
+    }
+    callPreviousHandler(signal, info, context);
+    // Terminate the process with the original signal, if the previous handler returned.
+    std::signal(signal, SIG_DFL);
+    ::raise(signal);
+}
+
+void installCrashHandler(const std::filesystem::path &corpusDir) noexcept {
+    const auto dirText = corpusDir.string();
+    const auto size = std::min(dirText.size(), gCrashDirectory.size() - 1);
+    std::memcpy(gCrashDirectory.data(), dirText.data(), size);
+    gCrashDirectory[size] = '\0';
+    struct sigaction action{};
+    action.sa_sigaction = &handleCrashSignal;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (std::size_t i = 0; i < cCrashSignals.size(); ++i) {
+        sigaction(cCrashSignals[i], &action, &gPreviousActions[i]);
+    }
+}
+
+void removeCrashHandler() noexcept {
+    for (std::size_t i = 0; i < cCrashSignals.size(); ++i) {
+        sigaction(cCrashSignals[i], &gPreviousActions[i], nullptr);
+    }
+}
+
+void setCrashInput(const std::string &data) noexcept {
+    gCrashInputData = data.data();
+    gCrashInputSize = data.size();
+}
+
+#else
+
+void installCrashHandler(const std::filesystem::path &) noexcept {
+    // Not supported on this platform.
+}
+
+void removeCrashHandler() noexcept {
+    // Not supported on this platform.
+}
+
+void setCrashInput(const std::string &) noexcept {
+    // Not supported on this platform.
+}
+
+#endif
+
+}
+
+Fuzzer::Fuzzer(TestClassBase &testClass, const std::size_t testIndex) noexcept :
+    _testClass{testClass}, _testIndex{testIndex} {
+}
+
+auto Fuzzer::defaultCorpusPath() const -> std::filesystem::path {
+    return std::filesystem::path{"data"} / "fuzz" / _testClass.shortName() /
+           _testClass.testMetaData(_testIndex).shortName();
+}
+
+void Fuzzer::replayCorpus() {
+    const auto controller = Controller::instance();
+    std::vector<std::filesystem::path> files;
+    const auto corpusDir = fh::findDataPath(defaultCorpusPath().generic_string());
+    if (!corpusDir.empty() && std::filesystem::is_directory(corpusDir)) {
+        for (const auto &entry : std::filesystem::directory_iterator(corpusDir)) {
+            if (entry.is_regular_file() && !entry.path().filename().string().starts_with(".")) {
+                files.push_back(entry.path());
+            }
+        }
+    }
+    if (files.empty()) {
+        // Without a corpus, make sure the fuzz test at least runs once.
+        const std::string emptyInput;
+        execute(emptyInput);
+        return;
+    }
+    std::ranges::sort(files);
+    for (const auto &file : files) {
+        const auto data = readInputFile(file);
+        controller->setFuzzInput(file.string());
+        execute(data);
+    }
+    controller->setFuzzInput({});
+}
+
+void Fuzzer::run(std::filesystem::path corpusDir, const Duration duration, const std::uint64_t seed) {
+    const auto controller = Controller::instance();
+    const auto console = controller->console();
+    _random = RandomGenerator{seed};
+    if (corpusDir.empty()) {
+        corpusDir = fh::findDataPath(defaultCorpusPath().generic_string());
+        if (corpusDir.empty()) {
+            corpusDir = fh::unitTestExecutablePath().parent_path() / defaultCorpusPath();
+        }
+    }
+    std::error_code errorCode;
+    std::filesystem::create_directories(corpusDir, errorCode);
+    if (errorCode || !std::filesystem::is_directory(corpusDir)) {
+        throw std::runtime_error(std::format("Could not create the corpus directory: {}", corpusDir.string()));
+    }
+    _corpusDir = std::filesystem::absolute(corpusDir);
+    console->writeDebug(std::format("Fuzzer: Using corpus directory: {}", _corpusDir.string()));
+    if (!FuzzCoverage::isAvailable) {
+        console->writeDebug(
+            "Fuzzer: No coverage instrumentation found. Inputs are mutated without feedback.\n"
+            "Fuzzer: Use the `FUZZ_COVERAGE` option of `erbsland_unittest()` to enable coverage feedback.");
+    }
+    _startTime = std::chrono::steady_clock::now();
+    installCrashHandler(_corpusDir);
+    try {
+        loadNewCorpusFiles(true);
+        if (_corpus.empty()) {
+            _corpus.emplace_back();
+            executeAndMerge(_corpus.back());
+        }
+        writeStatus("START");
+        const auto endTime = _startTime + duration;
+        auto nextRescan = _startTime + std::chrono::seconds{1};
+        std::string input;
+        while (true) {
+            if ((_executions & 0xffU) == 0) {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= endTime) {
+                    break;
+                }
+                if (now >= nextRescan) {
+                    // Pick up inputs from other workers that share the same corpus directory.
+                    loadNewCorpusFiles(false);
+                    nextRescan = now + std::chrono::seconds{1};
+                }
+            }
+            input = _corpus[_random.nextInRange<std::size_t>(0, _corpus.size() - 1)];
+            mutate(input);
+            if (executeAndMerge(input)) {
+                const auto path = saveInput(input, {});
+                _knownFiles.insert(path.filename().string());
+                _corpus.push_back(input);
+                if (std::chrono::steady_clock::now() >= _nextStatusTime) {
+                    writeStatus("NEW");
+                }
+            }
+        }
+    } catch (...) {
+        removeCrashHandler();
+        if (_failedInput.has_value()) {
+            const auto path = saveInput(*_failedInput, std::string{cCrashPrefix});
+            controller->setFuzzInput(path.string());
+            console->writeErrorInfo(std::format("Fuzzer: Input that caused the failure saved to: {}", path.string()));
+        }
+        throw;
+    }
+    removeCrashHandler();
+    writeStatus("DONE");
+}
+
+void Fuzzer::execute(const std::string &data) {
+    setCrashInput(data);
+    Controller::instance()->resetRandom();
+    _executions += 1;
+    try {
+        _testClass.callFuzzTest(_testIndex, toBytes(data));
+    } catch (...) {
+        _failedInput = data;
+        throw;
+    }
+}
+
+auto Fuzzer::executeAndMerge(const std::string &data) -> bool {
+    FuzzCoverage::reset();
+    execute(data);
+    bool hasNewCoverage = false;
+    constexpr std::size_t wordSize = sizeof(std::uint64_t);
+    for (std::size_t wordIndex = 0; wordIndex < FuzzCoverage::cMapSize; wordIndex += wordSize) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, FuzzCoverage::counters.data() + wordIndex, wordSize);
+        if (word == 0) {
+            continue; // Most of the map is empty, skip it quickly.
+        }
+        for (std::size_t i = wordIndex; i < wordIndex + wordSize; ++i) {
+            const auto bucket = bucketBit(FuzzCoverage::counters[i]);
+            if ((bucket & ~_seen[i]) != 0) {
+                _seen[i] = static_cast<std::uint8_t>(_seen[i] | bucket);
+                hasNewCoverage = true;
+            }
+        }
+    }
+    return hasNewCoverage;
+}
+
+void Fuzzer::loadNewCorpusFiles(const bool addWithoutCoverage) {
+    std::vector<std::filesystem::path> newFiles;
+    std::error_code errorCode;
+    for (const auto &entry : std::filesystem::directory_iterator(_corpusDir, errorCode)) {
+        auto fileName = entry.path().filename().string();
+        if (!entry.is_regular_file() || fileName.starts_with(".") || _knownFiles.contains(fileName)) {
+            continue;
+        }
+        _knownFiles.insert(fileName);
+        if (fileName.starts_with(cCrashPrefix)) {
+            continue; // Do not run inputs that are known to fail.
+        }
+        newFiles.push_back(entry.path());
+    }
+    std::ranges::sort(newFiles);
+    for (const auto &path : newFiles) {
+        auto data = readInputFile(path);
+        _maximumSize = std::max(_maximumSize, data.size());
+        if (executeAndMerge(data) || addWithoutCoverage) {
+            _corpus.push_back(std::move(data));
+        }
+    }
+}
+
+void Fuzzer::mutate(std::string &data) {
+    const auto randomPosition = [&](const std::size_t size) -> std::size_t {
+        return _random.nextInRange<std::size_t>(0, size - 1);
+    };
+    const auto mutationCount = _random.nextInRange(1, 4);
+    for (int mutation = 0; mutation < mutationCount; ++mutation) {
+        auto strategy = _random.nextInRange(0, 7);
+        if (data.empty()) {
+            strategy = 2; // Only inserting makes sense for empty inputs.
+        }
+        switch (strategy) {
+        case 0: // Flip a single bit.
+            data[randomPosition(data.size())] ^= static_cast<char>(1U << _random.nextInRange(0U, 7U));
+            break;
+        case 1: // Replace a byte with a random value.
+            data[randomPosition(data.size())] = static_cast<char>(_random());
+            break;
+        case 2: { // Insert random bytes.
+            const auto position = _random.nextInRange<std::size_t>(0, data.size());
+            data.insert(position, _random.randomBytes(_random.nextInRange<std::size_t>(1, 8)));
+            break;
+        }
+        case 3: { // Erase a range of bytes.
+            const auto position = randomPosition(data.size());
+            data.erase(position, _random.nextInRange<std::size_t>(1, std::min<std::size_t>(16, data.size() - position)));
+            break;
+        }
+        case 4: { // Duplicate a block of bytes.
+            const auto position = randomPosition(data.size());
+            const auto length = _random.nextInRange<std::size_t>(1, std::min<std::size_t>(32, data.size() - position));
+            data.insert(randomPosition(data.size()), data.substr(position, length));
+            break;
+        }
+        case 5: // Replace a byte with an interesting value.
+            data[randomPosition(data.size())] =
+                static_cast<char>(cInterestingBytes[_random.nextInRange<std::size_t>(0, cInterestingBytes.size() - 1)]);
+            break;
+        case 6: { // Add or subtract a small value.
+            auto &value = data[randomPosition(data.size())];
+            value = static_cast<char>(value + static_cast<char>(_random.nextInRange(-8, 8)));
+            break;
+        }
+        default: { // Cross over with another input from the corpus.
+            const auto &other = _corpus[_random.nextInRange<std::size_t>(0, _corpus.size() - 1)];
+            if (other.empty()) {
+                break;
+            }
+            const auto position = randomPosition(other.size());
+            const auto length = _random.nextInRange<std::size_t>(1, other.size() - position);
+            data.replace(randomPosition(data.size()), length, other, position, length);
+            break;
+        }
+        }
+    }
+    if (data.size() > _maximumSize) {
+        data.resize(_maximumSize);
+    }
+}
+
+auto Fuzzer::saveInput(const std::string &data, const std::string &prefix) -> std::filesystem::path {
+    const auto path = _corpusDir / (prefix + inputFileName(data));
+    // Write into a temporary file first, so other workers never read a partial input.
+    const auto temporaryPath = _corpusDir / std::format(".tmp-{:016x}", _random());
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, path, errorCode);
+    if (errorCode) {
+        std::filesystem::remove(temporaryPath, errorCode);
+    }
+    return path;
+}
+
+auto Fuzzer::inputFileName(const std::string &data) -> std::string {
+    return std::format("{:016x}", RandomGenerator::hashText(data));
+}
+
+auto Fuzzer::seenEdgeCount() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(std::ranges::count_if(_seen, [](const auto bucket) -> bool { return bucket != 0; }));
+}
+
+void Fuzzer::writeStatus(const std::string &event) {
+    const auto now = std::chrono::steady_clock::now();
+    _nextStatusTime = now + std::chrono::seconds{1};
+    const std::chrono::duration<double> elapsed = now - _startTime;
+    const auto executionsPerSecond =
+        elapsed.count() > 0.0 ? static_cast<std::uint64_t>(static_cast<double>(_executions) / elapsed.count()) : 0U;
+    Controller::instance()->console()->writeDebug(std::format(
+        "Fuzzer: {} executions: {} corpus: {} edges: {} exec/s: {}",
+        event,
+        _executions,
+        _corpus.size(),
+        seenEdgeCount(),
+        executionsPerSecond));
+}
+
+}
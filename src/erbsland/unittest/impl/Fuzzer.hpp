@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "../RandomGenerator.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace erbsland::unittest {
+
+class TestClassBase;
+
+/// @internal
+/// The coverage map for fuzzing.
+///
+/// The map is filled by the SanitizerCoverage callbacks in `FuzzCoverage.cpp`. These callbacks are only linked
+/// into the unittest executable if the test code is compiled with `-fsanitize-coverage=trace-pc-guard` (Clang)
+/// or `-fsanitize-coverage=trace-pc` (GCC), see the `FUZZ_COVERAGE` option of `erbsland_unittest()`.
+///
+class FuzzCoverage {
+public:
+    static constexpr std::size_t cMapSize = 1U << 16U; ///< The number of counters in the map.
+
+public:
+    /// Clear all counters.
+    static void reset() noexcept;
+
+public:
+    alignas(64) static std::array<std::uint8_t, cMapSize> counters; ///< The edge hit counters.
+    static std::uintptr_t previousLocation;                          ///< The previous location for `trace-pc`.
+    static bool isAvailable;                                         ///< If instrumented code was found.
+};
+
+/// @internal
+/// A simple in-process, coverage-guided fuzzer for fuzz tests.
+///
+class Fuzzer {
+public:
+    using Duration = std::chrono::steady_clock::duration; ///< The type used for durations.
+
+public:
+    /// Create a new fuzzer for a fuzz test.
+    /// @param testClass The test class.
+    /// @param testIndex The index of the fuzz test in the test class.
+    Fuzzer(TestClassBase &testClass, std::size_t testIndex) noexcept;
+
+public:
+    /// The default relative path of the corpus for a fuzz test.
+    [[nodiscard]] auto defaultCorpusPath() const -> std::filesystem::path;
+    /// Replay all inputs from the corpus, or an empty input if there is no corpus.
+    void replayCorpus();
+    /// Run the fuzzer.
+    /// @param corpusDir The corpus directory to read and write. Empty to use the default corpus path.
+    /// @param duration The duration of the fuzzing run.
+    /// @param seed The seed for the mutations.
+    void run(std::filesystem::path corpusDir, Duration duration, std::uint64_t seed);
+
+private:
+    /// Execute the fuzz test with one input.
+    void execute(const std::string &data);
+    /// Execute an input and update the seen coverage.
+    /// @return `true` if the input triggered new coverage.
+    auto executeAndMerge(const std::string &data) -> bool;
+    /// Load all new files from the corpus directory.
+    void loadNewCorpusFiles(bool addWithoutCoverage);
+    /// Mutate an input.
+    void mutate(std::string &data);
+    /// Save an input to the corpus directory.
+    auto saveInput(const std::string &data, const std::string &prefix) -> std::filesystem::path;
+    /// Get the file name for an input.
+    [[nodiscard]] static auto inputFileName(const std::string &data) -> std::string;
+    /// Count the edges that were seen.
+    [[nodiscard]] auto seenEdgeCount() const noexcept -> std::size_t;
+    /// Write a status line.
+    void writeStatus(const std::string &event);
+
+private:
+    TestClassBase &_testClass;                                 ///< The test class with the fuzz test.
+    std::size_t _testIndex;                                    ///< The index of the fuzz test.
+    std::filesystem::path _corpusDir;                          ///< The corpus directory.
+    std::vector<std::string> _corpus;                          ///< The inputs in the corpus.
+    std::optional<std::string> _failedInput;                   ///< The input that caused a failure.
+    std::set<std::string> _knownFiles;                         ///< File names that were already loaded.
+    std::array<std::uint8_t, FuzzCoverage::cMapSize> _seen{}; ///< The seen coverage buckets for each edge.
+    RandomGenerator _random;                                   ///< The generator for mutations.
+    std::size_t _maximumSize{4096};                            ///< The maximum size of generated inputs.
+    std::uint64_t _executions{0};                              ///< The number of executions.
+    std::chrono::steady_clock::time_point _startTime;          ///< The start time of the run.
+    std::chrono::steady_clock::time_point _nextStatusTime;     ///< Limit the rate of status messages.
+};
+
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+namespace erbsland::unittest::th {
+
+/// A lazy range over the lines of a text.
+///
+/// The range iterates over string views into the original text and does not allocate any memory. The text must
+/// stay alive and unchanged while the range or its lines are used.
+///
+/// Lines are split at newline characters (`\n`). A carriage return in front of a newline (`\r\n`) is removed from
+/// the line, while a carriage return at any other location is kept. A trailing newline does not produce an
+/// additional empty line at the end, and an empty text has no lines.
+///
+/// @tparam tChar The character type of the text.
+template <typename tChar>
+class LineRange : public std::ranges::view_interface<LineRange<tChar>> {
+public:
+    using StringView = std::basic_string_view<tChar>; ///< The type of the lines.
+
+    /// The forward iterator over the lines.
+    class Iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = StringView;
+        using difference_type = std::ptrdiff_t;
+
+    public:
+        Iterator() = default;
+        Iterator(const StringView text, const std::size_t lineStart) noexcept : _text{text}, _lineStart{lineStart} {
+            findLineEnd();
+        }
+
+    public:
+        auto operator*() const noexcept -> StringView {
+            auto line = _text.substr(_lineStart, _lineEnd - _lineStart);
+            if (_lineEnd < _text.size() && !line.empty() && line.back() == static_cast<tChar>('\r')) {
+                line.remove_suffix(1);
+            }
+            return line;
+        }
+        auto operator++() noexcept -> Iterator & {
+            _lineStart = (_lineEnd < _text.size()) ? _lineEnd + 1 : _text.size();
+            findLineEnd();
+            return *this;
+        }
+        auto operator++(int) noexcept -> Iterator {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+        auto operator==(const Iterator &other) const noexcept -> bool { return _lineStart == other._lineStart; }
+
+    private:
+        void findLineEnd() noexcept {
+            _lineEnd = _text.find(static_cast<tChar>('\n'), _lineStart);
+            if (_lineEnd == StringView::npos) {
+                _lineEnd = _text.size();
+            }
+        }
+
+    private:
+        StringView _text;          ///< The whole text.
+        std::size_t _lineStart{0}; ///< The index of the first character of the line, or the text size at the end.
+        std::size_t _lineEnd{0};   ///< The index of the newline after the line, or the text size.
+    };
+
+public:
+    LineRange() = default;
+    explicit LineRange(const StringView text) noexcept : _text{text} {}
+
+public:
+    /// Get an iterator to the first line.
+    [[nodiscard]] auto begin() const noexcept -> Iterator { return Iterator{_text, 0}; }
+    /// Get the iterator after the last line.
+    [[nodiscard]] auto end() const noexcept -> Iterator { return Iterator{_text, _text.size()}; }
+    /// Test if the text has no lines.
+    [[nodiscard]] auto empty() const noexcept -> bool { return _text.empty(); }
+    /// Get the text of this range.
+    [[nodiscard]] auto text() const noexcept -> StringView { return _text; }
+
+private:
+    StringView _text; ///< The text of the lines.
+};
+
+}
+
+/// The lines of a line range point into the text, not into the range.
+template <typename tChar>
+constexpr bool std::ranges::enable_borrowed_range<erbsland::unittest::th::LineRange<tChar>> = true;
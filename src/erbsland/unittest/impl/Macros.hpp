@@ -12,23 +12,39 @@
 #undef REQUIRE_THROWS
 #undef REQUIRE_THROWS_AS
 #undef REQUIRE_NOTHROW
+#undef REQUIRE_DEATH
+#undef REQUIRE_DEATH_MATCHES
+#undef REQUIRE_EXIT
+#undef REQUIRE_EXIT_MATCHES
+#undef REQUIRE_MAX_STACK
 #undef REQUIRE_EQUAL
 #undef REQUIRE_NOT_EQUAL
 #undef REQUIRE_LESS
 #undef REQUIRE_LESS_EQUAL
 #undef REQUIRE_GREATER
 #undef REQUIRE_GREATER_EQUAL
+#undef REQUIRE_RANGES_EQUAL
+#undef REQUIRE_APPROX
+#undef REQUIRE_RANGES_APPROX
 #undef CHECK
 #undef CHECK_FALSE
 #undef CHECK_THROWS
 #undef CHECK_THROWS_AS
 #undef CHECK_NOTHROW
+#undef CHECK_DEATH
+#undef CHECK_DEATH_MATCHES
+#undef CHECK_EXIT
+#undef CHECK_EXIT_MATCHES
+#undef CHECK_MAX_STACK
 #undef CHECK_EQUAL
 #undef CHECK_NOT_EQUAL
 #undef CHECK_LESS
 #undef CHECK_LESS_EQUAL
 #undef CHECK_GREATER
 #undef CHECK_GREATER_EQUAL
+#undef CHECK_RANGES_EQUAL
+#undef CHECK_APPROX
+#undef CHECK_RANGES_APPROX
 #undef UNITTEST_SUBCLASS
 
 #define ASSERT_CONTEXT_REQUIRE(macroName, flags, ...)                                                                  \
@@ -70,6 +86,37 @@
         this, flags, macroName, #exceptionClass ", " #__VA_ARGS__, {__FILE__, __LINE__}, [&]() -> void {               \
             static_cast<void>(__VA_ARGS__);                                                                            \
         });
+#define ASSERT_CONTEXT_DEATH(macroName, flags, exitCode, pattern, ...)                                               \
+    ::erbsland::unittest::requireDeath(                                                                                \
+        this, flags, macroName, #__VA_ARGS__, {__FILE__, __LINE__}, exitCode, pattern, [&]() -> void {                 \
+            static_cast<void>(__VA_ARGS__);                                                                            \
+        });
+#define ASSERT_CONTEXT_MAX_STACK(macroName, flags, ...)                                                                \
+    ::erbsland::unittest::requireMaxStack(                                                                             \
+        this, flags, macroName, #__VA_ARGS__, {__FILE__, __LINE__}, static_cast<std::size_t>(__VA_ARGS__));
+#define ASSERT_CONTEXT_RANGES_EQUAL(macroName, flags, a, b)                                                            \
+    ::erbsland::unittest::requireRangesEqual(                                                                          \
+        this,                                                                                                          \
+        flags,                                                                                                         \
+        macroName,                                                                                                     \
+        #a ", " #b,                                                                                                    \
+        {__FILE__, __LINE__},                                                                                          \
+        #a,                                                                                                            \
+        #b,                                                                                                            \
+        [&]() -> decltype(auto) { return (a); },                                                                       \
+        [&]() -> decltype(auto) { return (b); });
+#define ASSERT_CONTEXT_APPROX(function, macroName, flags, a, b, ...)                                                  \
+    ::erbsland::unittest::function(                                                                                    \
+        this,                                                                                                          \
+        flags,                                                                                                         \
+        macroName,                                                                                                     \
+        #a ", " #b ", " #__VA_ARGS__,                                                                                  \
+        {__FILE__, __LINE__},                                                                                          \
+        #a,                                                                                                            \
+        #b,                                                                                                            \
+        [&]() -> decltype(auto) { return (a); },                                                                       \
+        [&]() -> decltype(auto) { return (b); },                                                                       \
+        [&]() -> ::erbsland::unittest::Tolerance { return __VA_ARGS__; });
 // run an expression, but add context information to it.
 #define WITH_CONTEXT(...)                                                                                              \
     ::erbsland::unittest::runWithContext(this, 0, "WITH_CONTEXT", #__VA_ARGS__, {__FILE__, __LINE__}, [&]() -> void {  \
@@ -84,12 +131,26 @@
 #define REQUIRE_THROWS_AS(exceptionClass, ...)                                                                         \
     ASSERT_CONTEXT_THROWS_AS("REQUIRE_THROWS_AS", 0, exceptionClass, __VA_ARGS__)
 #define REQUIRE_NOTHROW(...) ASSERT_CONTEXT_NOTHROW("REQUIRE_NOTHROW", 0, __VA_ARGS__)
+#define REQUIRE_DEATH(...) ASSERT_CONTEXT_DEATH("REQUIRE_DEATH", 0, std::nullopt, "", __VA_ARGS__)
+#define REQUIRE_DEATH_MATCHES(expr, pattern)                                                                           \
+    ASSERT_CONTEXT_DEATH("REQUIRE_DEATH_MATCHES", 0, std::nullopt, pattern, expr)
+#define REQUIRE_EXIT(expr, code) ASSERT_CONTEXT_DEATH("REQUIRE_EXIT", 0, (code), "", expr)
+#define REQUIRE_EXIT_MATCHES(expr, code, pattern)                                                                      \
+    ASSERT_CONTEXT_DEATH("REQUIRE_EXIT_MATCHES", 0, (code), pattern, expr)
+#define REQUIRE_MAX_STACK(...) ASSERT_CONTEXT_MAX_STACK("REQUIRE_MAX_STACK", 0, __VA_ARGS__)
 #define REQUIRE_EQUAL(a, b) ASSERT_CONTEXT_COMPARISON("REQUIRE_EQUAL", 0, ==, a, b)
 #define REQUIRE_NOT_EQUAL(a, b) ASSERT_CONTEXT_COMPARISON("REQUIRE_NOT_EQUAL", 0, !=, a, b)
 #define REQUIRE_LESS(a, b) ASSERT_CONTEXT_COMPARISON("REQUIRE_LESS", 0, <, a, b)
 #define REQUIRE_LESS_EQUAL(a, b) ASSERT_CONTEXT_COMPARISON("REQUIRE_LESS_EQUAL", 0, <=, a, b)
 #define REQUIRE_GREATER(a, b) ASSERT_CONTEXT_COMPARISON("REQUIRE_GREATER", 0, >, a, b)
 #define REQUIRE_GREATER_EQUAL(a, b) ASSERT_CONTEXT_COMPARISON("REQUIRE_GREATER_EQUAL", 0, >=, a, b)
+#define REQUIRE_RANGES_EQUAL(a, b) ASSERT_CONTEXT_RANGES_EQUAL("REQUIRE_RANGES_EQUAL", 0, a, b)
+#define REQUIRE_APPROX(a, b, ...) ASSERT_CONTEXT_APPROX(requireApprox, "REQUIRE_APPROX", 0, a, b, __VA_ARGS__)
+#define REQUIRE_RANGES_APPROX(a, b, ...)                                                                               \
+    ASSERT_CONTEXT_APPROX(requireRangesApprox, "REQUIRE_RANGES_APPROX", 0, a, b, __VA_ARGS__)
+/// Convenience macro to call `fh::requireMatchesDataFile()` for the current test instance.
+#define REQUIRE_MATCHES_DATA_FILE(actual, relativePath)                                                                \
+    WITH_CONTEXT(erbsland::unittest::fh::requireMatchesDataFile(*this, actual, relativePath));
 
 #define CHECK(...) ASSERT_CONTEXT_REQUIRE("CHECK", (::erbsland::unittest::AssertCheck), __VA_ARGS__)
 #define CHECK_FALSE(...)                                                                                               \
@@ -99,6 +160,15 @@
 #define CHECK_THROWS_AS(exceptionClass, ...)                                                                           \
     ASSERT_CONTEXT_THROWS_AS("CHECK_THROWS_AS", (::erbsland::unittest::AssertCheck), exceptionClass, __VA_ARGS__)
 #define CHECK_NOTHROW(...) ASSERT_CONTEXT_NOTHROW("CHECK_NOTHROW", (::erbsland::unittest::AssertCheck), __VA_ARGS__)
+#define CHECK_DEATH(...)                                                                                               \
+    ASSERT_CONTEXT_DEATH("CHECK_DEATH", (::erbsland::unittest::AssertCheck), std::nullopt, "", __VA_ARGS__)
+#define CHECK_DEATH_MATCHES(expr, pattern)                                                                             \
+    ASSERT_CONTEXT_DEATH("CHECK_DEATH_MATCHES", (::erbsland::unittest::AssertCheck), std::nullopt, pattern, expr)
+#define CHECK_EXIT(expr, code) ASSERT_CONTEXT_DEATH("CHECK_EXIT", (::erbsland::unittest::AssertCheck), (code), "", expr)
+#define CHECK_EXIT_MATCHES(expr, code, pattern)                                                                        \
+    ASSERT_CONTEXT_DEATH("CHECK_EXIT_MATCHES", (::erbsland::unittest::AssertCheck), (code), pattern, expr)
+#define CHECK_MAX_STACK(...)                                                                                           \
+    ASSERT_CONTEXT_MAX_STACK("CHECK_MAX_STACK", (::erbsland::unittest::AssertCheck), __VA_ARGS__)
 #define CHECK_EQUAL(a, b) ASSERT_CONTEXT_COMPARISON("CHECK_EQUAL", (::erbsland::unittest::AssertCheck), ==, a, b)
 #define CHECK_NOT_EQUAL(a, b)                                                                                          \
     ASSERT_CONTEXT_COMPARISON("CHECK_NOT_EQUAL", (::erbsland::unittest::AssertCheck), !=, a, b)
@@ -108,6 +178,13 @@
 #define CHECK_GREATER(a, b) ASSERT_CONTEXT_COMPARISON("CHECK_GREATER", (::erbsland::unittest::AssertCheck), >, a, b)
 #define CHECK_GREATER_EQUAL(a, b)                                                                                      \
     ASSERT_CONTEXT_COMPARISON("CHECK_GREATER_EQUAL", (::erbsland::unittest::AssertCheck), >=, a, b)
+#define CHECK_RANGES_EQUAL(a, b)                                                                                       \
+    ASSERT_CONTEXT_RANGES_EQUAL("CHECK_RANGES_EQUAL", (::erbsland::unittest::AssertCheck), a, b)
+#define CHECK_APPROX(a, b, ...)                                                                                        \
+    ASSERT_CONTEXT_APPROX(requireApprox, "CHECK_APPROX", (::erbsland::unittest::AssertCheck), a, b, __VA_ARGS__)
+#define CHECK_RANGES_APPROX(a, b, ...)                                                                                 \
+    ASSERT_CONTEXT_APPROX(                                                                                             \
+        requireRangesApprox, "CHECK_RANGES_APPROX", (::erbsland::unittest::AssertCheck), a, b, __VA_ARGS__)
 
 /// Begin: Manual test registration.
 #define TESTS_BEGIN(class_name)                                                                                        \
@@ -144,6 +221,16 @@ public:
 /// An empty macro to skip the test or class unless the tag is explicitly specified.
 #define SKIP_BY_DEFAULT()
 
+/// Define an empty SHARED_FIXTURES() macro, to declare the shared fixtures used by a class or test.
+#define SHARED_FIXTURES(name_list)
+
+/// Define an empty MEMORY_LIMIT() macro, to limit the memory a class or test may allocate, e.g. `MEMORY_LIMIT(512M)`.
+#define MEMORY_LIMIT(size)
+
+/// Define an empty STACK_SIZE() macro, to run a class or test on a thread with the given stack size,
+/// e.g. `STACK_SIZE(256k)`.
+#define STACK_SIZE(size)
+
 /// Define the main method for the unit test executable.
 /// Create a file `main.cpp` with this macro to define the main method for the unit test.
 #define ERBSLAND_UNITTEST_MAIN()                                                                                       \
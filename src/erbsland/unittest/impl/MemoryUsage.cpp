@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "MemoryUsage.hpp"
+
+#include <array>
+#include <cstdio>
+#include <format>
+
+#if defined(ERBSLAND_OS_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(ERBSLAND_OS_MACOS)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace erbsland::unittest {
+
+auto residentMemorySize() noexcept -> std::size_t {
+#if defined(ERBSLAND_OS_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(counters.WorkingSetSize);
+#elif defined(ERBSLAND_OS_MACOS)
+    mach_task_basic_info_data_t info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) !=
+        KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<std::size_t>(info.resident_size);
+#else
+    // The second value in `statm` is the number of resident pages.
+    auto *file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    unsigned long long totalPages = 0;
+    unsigned long long residentPages = 0;
+    const auto matched = std::fscanf(file, "%llu %llu", &totalPages, &residentPages);
+    std::fclose(file);
+    const auto pageSize = sysconf(_SC_PAGESIZE);
+    if (matched != 2 || pageSize <= 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(residentPages * static_cast<unsigned long long>(pageSize));
+#endif
+}
+
+auto peakResidentMemorySize() noexcept -> std::size_t {
+#if defined(ERBSLAND_OS_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+#elif defined(ERBSLAND_OS_MACOS)
+    mach_task_basic_info_data_t info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) !=
+        KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<std::size_t>(info.resident_size_max);
+#else
+    // The `VmHWM` line in `status` contains the peak resident size in kB.
+    auto *file = std::fopen("/proc/self/status", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    std::array<char, 256> line{};
+    unsigned long long peakKilobytes = 0;
+    while (std::fgets(line.data(), static_cast<int>(line.size()), file) != nullptr) {
+        if (std::sscanf(line.data(), "VmHWM: %llu kB", &peakKilobytes) == 1) {
+            break;
+        }
+    }
+    std::fclose(file);
+    return static_cast<std::size_t>(peakKilobytes * 1024ULL);
+#endif
+}
+
+auto resetPeakResidentMemorySize() noexcept -> bool {
+#if defined(ERBSLAND_OS_WINDOWS) || defined(ERBSLAND_OS_MACOS)
+    return false;
+#else
+    // Writing `5` to `clear_refs` resets the peak resident size (Linux 4.0 and later).
+    auto *file = std::fopen("/proc/self/clear_refs", "w");
+    if (file == nullptr) {
+        return false;
+    }
+    const auto success = std::fputs("5", file) >= 0;
+    return (std::fclose(file) == 0) && success;
+#endif
+}
+
+auto memorySizeText(const std::int64_t bytes) -> std::string {
+    constexpr std::array<const char *, 5> units = {"bytes", "kB", "MB", "GB", "TB"};
+    auto value = static_cast<double>(bytes < 0 ? -bytes : bytes);
+    std::size_t unitIndex = 0;
+    while (value >= 1000.0 && unitIndex + 1 < units.size()) {
+        value /= 1000.0;
+        ++unitIndex;
+    }
+    const auto sign = (bytes < 0) ? "-" : "";
+    if (unitIndex == 0) {
+        return std::format("{}{} {}", sign, static_cast<std::int64_t>(value), units[unitIndex]);
+    }
+    return std::format("{}{:.1f} {}", sign, value, units[unitIndex]);
+}
+
+}
@@ -0,0 +1,28 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace erbsland::unittest {
+
+/// Get the current resident memory size of this process.
+/// @return The size in bytes, or zero if it cannot be determined on this platform.
+auto residentMemorySize() noexcept -> std::size_t;
+
+/// Get the peak resident memory size of this process.
+/// @return The size in bytes, or zero if it cannot be determined on this platform.
+auto peakResidentMemorySize() noexcept -> std::size_t;
+
+/// Reset the peak resident memory size to the current size.
+/// @return `true` if the peak was reset, `false` if this is not supported on this platform.
+auto resetPeakResidentMemorySize() noexcept -> bool;
+
+/// Format a memory size or difference for the console, like `812.3 MB` or `-4.0 kB`.
+auto memorySizeText(std::int64_t bytes) -> std::string;
+
+}
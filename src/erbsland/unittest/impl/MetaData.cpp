@@ -4,14 +4,22 @@
 
 namespace erbsland::unittest {
 
-MetaData::MetaData(const std::string &name) : _name{name}, _shortName{name}, _flags{0} {
+MetaData::MetaData(const std::string &name) : _name{name}, _shortName{name}, _memoryLimit{0}, _stackSize{0}, _flags{0} {
 }
 
 MetaData::MetaData(const std::string &name,
     const std::vector<std::string> &tags,
     const std::vector<std::string> &testedTargets,
-    Flags flags) noexcept :
-    _name{name}, _shortName{name}, _flags{flags} {
+    Flags flags,
+    const std::vector<std::string> &sharedFixtures,
+    std::size_t memoryLimit,
+    std::size_t stackSize) noexcept :
+    _name{name},
+    _shortName{name},
+    _sharedFixtures{sharedFixtures.begin(), sharedFixtures.end()},
+    _memoryLimit{memoryLimit},
+    _stackSize{stackSize},
+    _flags{flags} {
 
     for (const auto &tag : tags) {
         _tags.insert(tag);
@@ -33,6 +41,9 @@ MetaData::MetaData(const std::string &name,
     } else if (_shortName.size() > 5 && _shortName.substr(0, 5) == "print") {
         _flags |= PrintMethod;
         _shortName = name.substr(5);
+    } else if (_shortName.size() > 4 && _shortName.substr(0, 4) == "fuzz") {
+        _flags |= FuzzMethod;
+        _shortName = name.substr(4);
     }
 }
 
@@ -73,6 +84,18 @@ auto MetaData::targets() const noexcept -> const std::set<std::string> & {
     return _targets;
 }
 
+auto MetaData::sharedFixtures() const noexcept -> const std::set<std::string> & {
+    return _sharedFixtures;
+}
+
+auto MetaData::memoryLimit() const noexcept -> std::size_t {
+    return _memoryLimit;
+}
+
+auto MetaData::stackSize() const noexcept -> std::size_t {
+    return _stackSize;
+}
+
 auto MetaData::isSkipByDefault() const noexcept -> bool {
     return (_flags & SkipByDefault) != 0;
 }
@@ -81,4 +104,8 @@ auto MetaData::isPrintMethod() const noexcept -> bool {
     return (_flags & PrintMethod) != 0;
 }
 
+auto MetaData::isFuzzMethod() const noexcept -> bool {
+    return (_flags & FuzzMethod) != 0;
+}
+
 }
@@ -4,6 +4,7 @@
 
 #include "Filter.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <set>
 #include <string>
@@ -20,17 +21,23 @@ public:
         SkipByDefault = (1u << 1u),
         /// This is a print-only method, used to visualize results while debugging.
         PrintMethod = (1u << 2u),
+        /// This is a fuzz method, that is called with byte inputs from a corpus.
+        FuzzMethod = (1u << 3u),
     };
     using Flags = uint32_t;
 
 public:
     /// Create metadata with only the object name.
     explicit MetaData(const std::string &name);
-    /// Create metadata with the object name, tags and targets.
+    /// Create metadata with the object name, tags, targets, the used shared fixtures, the memory limit and the
+    /// stack size.
     MetaData(const std::string &name,
         const std::vector<std::string> &tags,
         const std::vector<std::string> &testedTargets,
-        Flags flags) noexcept;
+        Flags flags,
+        const std::vector<std::string> &sharedFixtures = {},
+        std::size_t memoryLimit = 0,
+        std::size_t stackSize = 0) noexcept;
 
 public:
     /// Test if this matches the given filter option.
@@ -46,17 +53,28 @@ public:
     [[nodiscard]] auto tags() const noexcept -> const std::set<std::string> &;
     /// The targets.
     [[nodiscard]] auto targets() const noexcept -> const std::set<std::string> &;
+    /// The names of the shared fixtures used by this class or method.
+    [[nodiscard]] auto sharedFixtures() const noexcept -> const std::set<std::string> &;
+    /// The memory limit in bytes, or zero if no limit was set.
+    [[nodiscard]] auto memoryLimit() const noexcept -> std::size_t;
+    /// The stack size in bytes, or zero if the test runs on the main thread.
+    [[nodiscard]] auto stackSize() const noexcept -> std::size_t;
     /// If the target shall be skipped by default.
     [[nodiscard]] auto isSkipByDefault() const noexcept -> bool;
     /// If the target is a print method.
     [[nodiscard]] auto isPrintMethod() const noexcept -> bool;
+    /// If the target is a fuzz method.
+    [[nodiscard]] auto isFuzzMethod() const noexcept -> bool;
 
 private:
-    std::string _name;              ///< The name.
-    std::string _shortName;         ///< A short version of the name.
-    std::set<std::string> _tags;    ///< The tags.
-    std::set<std::string> _targets; ///< The targets.
-    Flags _flags;                   ///< Flags.
+    std::string _name;                     ///< The name.
+    std::string _shortName;                ///< A short version of the name.
+    std::set<std::string> _tags;           ///< The tags.
+    std::set<std::string> _targets;        ///< The targets.
+    std::set<std::string> _sharedFixtures; ///< The used shared fixtures.
+    std::size_t _memoryLimit;              ///< The memory limit in bytes, or zero.
+    std::size_t _stackSize;                ///< The stack size in bytes, or zero.
+    Flags _flags;                          ///< Flags.
 };
 
 }
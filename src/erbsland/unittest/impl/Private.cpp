@@ -2,23 +2,29 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "Private.hpp"
 
+#include "AllocationHook.hpp"
 #include "AssertFailed.hpp"
 #include "AssertFlags.hpp"
+#include "AssertStats.hpp"
 #include "Controller.hpp"
+#include "CrashHandler.hpp"
 #include "Demangle.hpp"
 #include "ErrorCapture.hpp"
 
 #include "../UnitTest.hpp"
 
+#include <chrono>
 #include <sstream>
 
 namespace erbsland::unittest {
 
 void Private::handleAssertResult(AssertResult result, const AssertContext &context, UnitTest *unitTest) {
+    const AllocationHook::Pause allocationPause;
 
     ErrorCapturePtr errorCapture;
     if (result == UnexpectedException) {
         errorCapture = Controller::instance()->reportError("UNEXPECTED EXCEPTION!", ConsoleColor::Red);
+        errorCapture->setCausedByException(true);
     } else {
         bool isExpected = (result == ExpectedResult);
         if ((context.flags & AssertNegate) != 0) {
@@ -41,6 +47,8 @@ void Private::handleAssertResult(AssertResult result, const AssertContext &conte
              << "Exception Message: " << context.exceptionMessage;
         console->writeDebug(text.str());
         errorCapture->addDebugInfo(text.str());
+        // Failures like `REQUIRE_NOTHROW()` report the caught exception as unexpected result.
+        errorCapture->setCausedByException(true);
     }
 
     if (!_contextStack.empty()) {
@@ -67,7 +75,12 @@ void Private::handleAssertResult(AssertResult result, const AssertContext &conte
 }
 
 void Private::addContext(AssertContext *context) noexcept {
+    const AllocationHook::Pause allocationPause;
     _contextStack.push_back(context);
+    CrashHandler::pushContext(context);
+    if (AssertStats::isEnabled()) {
+        context->startTime = std::chrono::steady_clock::now();
+    }
 }
 
 void Private::removeContext(AssertContext *context) noexcept {
@@ -75,7 +88,17 @@ void Private::removeContext(AssertContext *context) noexcept {
         auto console = Controller::instance()->console();
         console->writeError("Context stack corruption. Do not use `REQUIRE` macros in sub threads!");
     } else {
+        if (AssertStats::isEnabled()) {
+            const AllocationHook::Pause allocationPause;
+            const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - context->startTime);
+            if (_contextStack.size() > 1) {
+                _contextStack[_contextStack.size() - 2]->nestedTime += time;
+            }
+            AssertStats::add(context->sourceLocation, context->macroName, time - context->nestedTime);
+        }
         _contextStack.pop_back();
+        CrashHandler::popContext();
     }
 }
 
@@ -0,0 +1,207 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "Profiler.hpp"
+
+#include "Demangle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if !defined(ERBSLAND_OS_WINDOWS) && __has_include(<execinfo.h>) && __has_include(<dlfcn.h>)
+#include <csignal>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+#define ERBSLAND_UNITTEST_HAS_PROFILER
+#endif
+
+namespace erbsland::unittest {
+
+#if defined(ERBSLAND_UNITTEST_HAS_PROFILER)
+
+namespace {
+
+/// The maximum number of frames of a sample.
+constexpr int cMaximumFrames = 64;
+/// The frames of the signal handler and the signal trampoline, at the start of each backtrace.
+constexpr int cHandlerFrames = 2;
+/// The size of the sample buffer, in words. Each sample uses one word for its size and one for each frame.
+constexpr std::size_t cBufferSize = 1024 * 1024;
+
+std::unique_ptr<std::uintptr_t[]> gBuffer; ///< The buffer with the samples.
+std::atomic<std::size_t> gBufferUsed{0};   ///< The number of reserved words in the buffer.
+std::atomic<std::size_t> gDroppedCount{0}; ///< The number of samples that did not fit into the buffer.
+std::atomic<bool> gSampling{false};        ///< If samples are recorded.
+std::atomic<int> gActiveHandlers{0};       ///< The number of signal handlers that are running.
+struct sigaction gPreviousAction {};       ///< The signal action before the profiler started.
+
+/// Record a sample of the interrupted call stack.
+void handleProfilerSignal(int /*signal*/) {
+    const auto savedErrno = errno;
+    gActiveHandlers.fetch_add(1, std::memory_order_acquire);
+    if (gSampling.load(std::memory_order_relaxed)) {
+        std::array<void *, cMaximumFrames> frames{};
+        const auto frameCount = ::backtrace(frames.data(), cMaximumFrames);
+        if (frameCount > cHandlerFrames) {
+            const auto depth = static_cast<std::size_t>(frameCount - cHandlerFrames);
+            const auto position = gBufferUsed.fetch_add(depth + 1, std::memory_order_relaxed);
+            if (position + depth + 1 <= cBufferSize) {
+                gBuffer[position] = depth;
+                for (std::size_t i = 0; i < depth; ++i) {
+                    gBuffer[position + 1 + i] = reinterpret_cast<std::uintptr_t>(frames[cHandlerFrames + i]);
+                }
+            } else {
+                if (position < cBufferSize) {
+                    gBuffer[position] = 0; // Marks the end of the recorded samples.
+                }
+                gDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    gActiveHandlers.fetch_sub(1, std::memory_order_release);
+    errno = savedErrno;
+}
+
+/// Get the name of the function at an address, or the module and offset, if it has no public symbol.
+auto functionName(const std::uintptr_t address) -> std::string {
+    Dl_info info{};
+    if (::dladdr(reinterpret_cast<void *>(address), &info) == 0) {
+        return std::format("0x{:x}", address);
+    }
+    std::string name;
+    if (info.dli_sname != nullptr) {
+        name = demangleTypeName(info.dli_sname);
+    } else if (info.dli_fname != nullptr) {
+        name = std::format("{}+0x{:x}",
+            std::filesystem::path{info.dli_fname}.filename().string(),
+            address - reinterpret_cast<std::uintptr_t>(info.dli_fbase));
+    } else {
+        name = std::format("0x{:x}", address);
+    }
+    // The semicolon separates the frames in the folded format.
+    std::ranges::replace(name, ';', ',');
+    return name;
+}
+
+}
+
+#endif
+
+auto Profiler::isSupported() noexcept -> bool {
+#if defined(ERBSLAND_UNITTEST_HAS_PROFILER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::start(const int frequency) {
+#if defined(ERBSLAND_UNITTEST_HAS_PROFILER)
+    if (gBuffer == nullptr) {
+        gBuffer = std::make_unique<std::uintptr_t[]>(cBufferSize);
+        // The first call of `backtrace()` may load a library, which must not happen in the signal handler.
+        std::array<void *, 1> frames{};
+        (void)::backtrace(frames.data(), 1);
+    }
+    gBufferUsed.store(0, std::memory_order_relaxed);
+    gDroppedCount.store(0, std::memory_order_relaxed);
+    struct sigaction action {};
+    action.sa_handler = handleProfilerSignal;
+    sigemptyset(&action.sa_mask);
+    // Use the alternate stack if there is one, so the handler does not change the measured stack of a test.
+    action.sa_flags = SA_RESTART | SA_ONSTACK;
+    if (::sigaction(SIGPROF, &action, &gPreviousAction) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Could not install the profiler signal handler");
+    }
+    gSampling.store(true, std::memory_order_seq_cst);
+    const auto interval = std::max(1'000'000 / std::max(frequency, 1), 1);
+    itimerval timer{};
+    timer.it_interval.tv_usec = interval;
+    timer.it_value.tv_usec = interval;
+    if (::setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        const auto error = errno;
+        stop();
+        throw std::system_error(error, std::generic_category(), "Could not start the profiler timer");
+    }
+#else
+    (void)frequency;
+    throw std::logic_error("The profiler is not supported on this platform.");
+#endif
+}
+
+void Profiler::stop() noexcept {
+#if defined(ERBSLAND_UNITTEST_HAS_PROFILER)
+    const itimerval timer{};
+    (void)::setitimer(ITIMER_PROF, &timer, nullptr);
+    gSampling.store(false, std::memory_order_seq_cst);
+    while (gActiveHandlers.load(std::memory_order_acquire) > 0) {
+    }
+    (void)::sigaction(SIGPROF, &gPreviousAction, nullptr);
+#endif
+}
+
+auto Profiler::writeFoldedStacks(const std::filesystem::path &path) -> Result {
+#if defined(ERBSLAND_UNITTEST_HAS_PROFILER)
+    Result result;
+    result.droppedCount = gDroppedCount.load(std::memory_order_relaxed);
+    // Count the identical call stacks first, so each address is only resolved once.
+    std::map<std::vector<std::uintptr_t>, std::size_t> stacks;
+    const auto used = std::min(gBufferUsed.load(std::memory_order_relaxed), cBufferSize);
+    std::size_t position = 0;
+    while (position < used && gBuffer[position] != 0 && position + 1 + gBuffer[position] <= used) {
+        const auto depth = static_cast<std::size_t>(gBuffer[position]);
+        const auto *frames = gBuffer.get() + position + 1;
+        // The backtrace starts with the innermost frame, the folded format with the outermost one.
+        std::vector<std::uintptr_t> stack{frames, frames + depth};
+        std::ranges::reverse(stack);
+        ++stacks[std::move(stack)];
+        ++result.sampleCount;
+        position += depth + 1;
+    }
+    std::map<std::uintptr_t, std::string> names;
+    std::map<std::string, std::size_t> foldedStacks;
+    for (const auto &[stack, count] : stacks) {
+        std::string line;
+        for (std::size_t i = 0; i < stack.size(); ++i) {
+            // All frames, except the interrupted one, are return addresses after the call instruction.
+            const auto address = (i + 1 < stack.size()) ? stack[i] - 1 : stack[i];
+            auto it = names.find(address);
+            if (it == names.end()) {
+                it = names.emplace(address, functionName(address)).first;
+            }
+            if (!line.empty()) {
+                line += ';';
+            }
+            line += it->second;
+        }
+        foldedStacks[line] += count;
+    }
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file) {
+        throw std::runtime_error(std::format("Could not write the profile \"{}\".", path.string()));
+    }
+    for (const auto &[line, count] : foldedStacks) {
+        file << line << ' ' << count << '\n';
+    }
+    return result;
+#else
+    (void)path;
+    throw std::logic_error("The profiler is not supported on this platform.");
+#endif
+}
+
+}
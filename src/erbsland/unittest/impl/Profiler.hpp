@@ -0,0 +1,43 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstddef>
+#include <filesystem>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// A sampling profiler, that writes the sampled call stacks in the folded format for flame graph tools.
+///
+/// The profiler uses `setitimer(ITIMER_PROF)`, so `SIGPROF` is sent for each interval of CPU time used by the
+/// process, to the thread that was running. The signal handler captures the call stack with `backtrace()` into a
+/// buffer that is allocated before the sampling starts. The stacks are resolved to function names after the
+/// sampling stopped. Time spent waiting, like in sleeps, is not sampled.
+///
+class Profiler {
+public:
+    /// The result of writing a profile.
+    struct Result {
+        std::size_t sampleCount{0};  ///< The number of written samples.
+        std::size_t droppedCount{0}; ///< The number of samples, that did not fit into the buffer.
+    };
+
+public:
+    /// Test if the profiler is supported on this platform.
+    [[nodiscard]] static auto isSupported() noexcept -> bool;
+    /// Start sampling the process.
+    /// @param frequency The number of samples per second of CPU time.
+    static void start(int frequency);
+    /// Stop sampling, and wait until all signal handlers finished.
+    static void stop() noexcept;
+    /// Write the samples since the last start as folded stacks, with one line per call stack.
+    /// Each line contains the functions, from the outermost to the innermost, separated by semicolons, and the
+    /// number of samples.
+    /// @param path The path of the file to write.
+    static auto writeFoldedStacks(const std::filesystem::path &path) -> Result;
+};
+
+}
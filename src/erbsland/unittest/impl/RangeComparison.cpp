@@ -0,0 +1,44 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "RangeComparison.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace erbsland::unittest {
+
+auto rangeMismatchMessage(const RangeMismatch &mismatch, const std::string_view aExpr, const std::string_view bExpr)
+    -> std::string {
+
+    std::string result;
+    if (mismatch.mismatchCount > 0) {
+        result = std::format("Ranges differ: {} of {} compared elements differ, the first at index {}.",
+            mismatch.mismatchCount,
+            std::min(mismatch.sizeA, mismatch.sizeB),
+            mismatch.firstIndex);
+        if (mismatch.sizeA != mismatch.sizeB) {
+            result += std::format("\n  Sizes: A has {} elements, B has {} elements.", mismatch.sizeA, mismatch.sizeB);
+        }
+    } else {
+        result = std::format("Ranges differ in size: A has {} elements, B has {} elements.",
+            mismatch.sizeA,
+            mismatch.sizeB);
+    }
+    const auto lastIndex = mismatch.windowStart + mismatch.windowDiffers.size();
+    const auto indexWidth = std::format("{}", lastIndex).size() + 2;
+    for (std::size_t i = 0; i < mismatch.windowDiffers.size(); ++i) {
+        const auto index = mismatch.windowStart + i;
+        auto indexText = std::format("[{}]", index);
+        indexText.resize(indexWidth, ' ');
+        result += std::format("\n{} {} {} {} {}",
+            index == mismatch.firstIndex ? '>' : ' ',
+            indexText,
+            mismatch.windowA[i].value_or("<none>"),
+            mismatch.windowDiffers[i] ? "!=" : "==",
+            mismatch.windowB[i].value_or("<none>"));
+    }
+    result += std::format("\n  A: {}\n  B: {}", aExpr, bExpr);
+    return result;
+}
+
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "AssertContext.hpp"
+#include "ConsoleLine.hpp"
+#include "SourceLocation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace erbsland::unittest {
+
+class UnitTest;
+
+/// @internal
+/// The details of two ranges that are not equal.
+struct RangeMismatch {
+    std::size_t sizeA{0};                              ///< The number of elements in the first range.
+    std::size_t sizeB{0};                              ///< The number of elements in the second range.
+    std::size_t firstIndex{0};                         ///< The index of the first difference.
+    std::size_t mismatchCount{0};                      ///< The number of compared elements that differ.
+    std::size_t windowStart{0};                        ///< The index of the first element in the window.
+    std::vector<std::optional<std::string>> windowA{}; ///< The elements of the first range around the difference.
+    std::vector<std::optional<std::string>> windowB{}; ///< The elements of the second range around the difference.
+    std::vector<bool> windowDiffers{};                 ///< If the elements in the window differ.
+};
+
+/// Generates the error message for two ranges that are not equal.
+/// @param mismatch The details of the difference.
+/// @param aExpr The textual representation of the first range.
+/// @param bExpr The textual representation of the second range.
+/// @return A detailed error message.
+auto rangeMismatchMessage(const RangeMismatch &mismatch, std::string_view aExpr, std::string_view bExpr)
+    -> std::string;
+
+/// Test if two ranges can be compared byte by byte.
+/// This is the case for contiguous ranges with the same scalar element type, where equal values always have the
+/// same bytes. Floating-point values are excluded, because of `-0.0 == 0.0` and NaN.
+/// @tparam A The type of the first range.
+/// @tparam B The type of the second range.
+template <typename A, typename B>
+constexpr bool can_compare_range_bytes = [] {
+    if constexpr (std::ranges::contiguous_range<A> && std::ranges::contiguous_range<B> &&
+                  std::ranges::sized_range<A> && std::ranges::sized_range<B>) {
+        using ElementA = std::remove_cv_t<std::ranges::range_value_t<A>>;
+        using ElementB = std::remove_cv_t<std::ranges::range_value_t<B>>;
+        return std::is_same_v<ElementA, ElementB> && std::is_scalar_v<ElementA> &&
+            std::has_unique_object_representations_v<ElementA>;
+    } else {
+        return false;
+    }
+}();
+
+/// Test if two ranges have equal elements.
+/// Ranges with scalar elements are compared with `std::memcmp`, that uses vector instructions of the platform.
+/// Other ranges are compared element by element, using `operator==`.
+template <typename A, typename B>
+[[nodiscard]] auto rangesEqual(const A &a, const B &b) -> bool {
+    if constexpr (can_compare_range_bytes<A, B>) {
+        const auto size = std::ranges::size(a);
+        if (size != std::ranges::size(b)) {
+            return false;
+        }
+        return size == 0 ||
+            std::memcmp(std::ranges::data(a), std::ranges::data(b), size * sizeof(std::ranges::range_value_t<A>)) ==
+            0;
+    } else {
+        auto itA = std::ranges::begin(a);
+        auto itB = std::ranges::begin(b);
+        for (; itA != std::ranges::end(a) && itB != std::ranges::end(b); ++itA, ++itB) {
+            if (!static_cast<bool>(*itA == *itB)) {
+                return false;
+            }
+        }
+        return itA == std::ranges::end(a) && itB == std::ranges::end(b);
+    }
+}
+
+/// Get the text for an element of a range, or `?` if it cannot be formatted.
+template <typename T>
+[[nodiscard]] auto rangeElementText(const T &value) -> std::string {
+    constexpr std::size_t cMaximumLength = 40;
+    if constexpr (is_formattable<T>) {
+        return ConsoleLine::utf8SafeString(std::format("{}", value), cMaximumLength);
+    } else {
+        return "?";
+    }
+}
+
+/// Collect the details of two ranges that are not equal.
+template <typename A, typename B>
+[[nodiscard]] auto rangeMismatch(const A &a, const B &b) -> RangeMismatch {
+    constexpr std::size_t cWindowBefore = 3;
+    constexpr std::size_t cWindowAfter = 3;
+    RangeMismatch result;
+    result.sizeA = static_cast<std::size_t>(std::ranges::distance(a));
+    result.sizeB = static_cast<std::size_t>(std::ranges::distance(b));
+    result.firstIndex = std::min(result.sizeA, result.sizeB);
+    std::size_t index = 0;
+    auto itA = std::ranges::begin(a);
+    auto itB = std::ranges::begin(b);
+    for (; itA != std::ranges::end(a) && itB != std::ranges::end(b); ++itA, ++itB, ++index) {
+        if (!static_cast<bool>(*itA == *itB)) {
+            if (result.mismatchCount == 0) {
+                result.firstIndex = index;
+            }
+            ++result.mismatchCount;
+        }
+    }
+    result.windowStart = result.firstIndex > cWindowBefore ? result.firstIndex - cWindowBefore : 0;
+    const auto windowEnd = std::min(result.firstIndex + cWindowAfter + 1, std::max(result.sizeA, result.sizeB));
+    itA = std::ranges::next(std::ranges::begin(a), static_cast<std::ptrdiff_t>(result.windowStart));
+    itB = std::ranges::next(std::ranges::begin(b), static_cast<std::ptrdiff_t>(result.windowStart));
+    for (auto i = result.windowStart; i < windowEnd; ++i) {
+        const bool hasA = i < result.sizeA;
+        const bool hasB = i < result.sizeB;
+        result.windowA.push_back(hasA ? std::optional{rangeElementText(*itA)} : std::nullopt);
+        result.windowB.push_back(hasB ? std::optional{rangeElementText(*itB)} : std::nullopt);
+        result.windowDiffers.push_back(!hasA || !hasB || !static_cast<bool>(*itA == *itB));
+        if (hasA) {
+            ++itA;
+        }
+        if (hasB) {
+            ++itB;
+        }
+    }
+    return result;
+}
+
+/// Verifies that two ranges have the same size and equal elements.
+/// On failure, the message shows the sizes, the index of the first difference, the elements around it and the
+/// number of elements that differ.
+/// @tparam FuncA A callable returning the first range.
+/// @tparam FuncB A callable returning the second range.
+/// @param test The UnitTest instance in which this check is running.
+/// @param flags Flags that modify assertion behavior.
+/// @param macroName The name of the macro that invoked this check (e.g. "REQUIRE_RANGES_EQUAL").
+/// @param expr The textual representation of both ranges.
+/// @param loc The source location where the check was invoked.
+/// @param aExpr The textual representation of the first range.
+/// @param bExpr The textual representation of the second range.
+/// @param funcA Callable that returns the first range.
+/// @param funcB Callable that returns the second range.
+template <typename FuncA, typename FuncB>
+void requireRangesEqual(UnitTest *test,
+    const int flags,
+    const char *macroName,
+    const char *expr,
+    const SourceLocation loc,
+    const char *aExpr,
+    const char *bExpr,
+    FuncA &&funcA,
+    FuncB &&funcB) {
+    AssertContext ctx{test, flags, macroName, expr, loc};
+    try {
+        decltype(auto) a = funcA();
+        decltype(auto) b = funcB();
+        if (rangesEqual(a, b)) {
+            ctx.expectedResult();
+        } else {
+            ctx.exceptionType = "requireComparison";
+            ctx.exceptionMessage = rangeMismatchMessage(rangeMismatch(a, b), aExpr, bExpr);
+            ctx.unexpectedResult();
+        }
+    } catch (const AssertFailed &) {
+        throw;
+    } catch (const std::exception &ex) {
+        ctx.exceptionType = std::string(typeid(ex).name());
+        ctx.exceptionMessage = std::string(ex.what());
+        ctx.unexpectedException();
+    } catch (...) {
+        ctx.unexpectedException();
+    }
+}
+
+}
@@ -6,6 +6,8 @@
 #include "MetaData.hpp"
 #include "TestClass.hpp"
 
+#include <cstddef>
+#include <span>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -18,12 +20,19 @@ namespace erbsland::unittest {
 template <class T>
 class Registration {
 public:
-    explicit Registration(
-        MetaData metaData, std::vector<std::tuple<void (T::*)(), MetaData>> testMethods = {}) noexcept {
+    explicit Registration(MetaData metaData,
+        std::vector<std::tuple<void (T::*)(), MetaData>> testMethods = {},
+        std::vector<std::tuple<void (T::*)(std::span<const std::byte>), MetaData>> fuzzMethods = {}) noexcept {
         auto testClass = new TestClass<T>(metaData);
         for (const auto &[fn, md] : testMethods) {
             testClass->addTest(fn, md);
         }
+        for (const auto &[fn, md] : fuzzMethods) {
+            testClass->addFuzzTest(fn, md);
+        }
+        if (metaData.isSkipByDefault()) {
+            testClass->setEnabled(false);
+        }
         Controller::instance()->addTestClass(testClass);
     }
 };
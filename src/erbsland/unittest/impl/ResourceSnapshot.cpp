@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "ResourceSnapshot.hpp"
+
+#include "MemoryUsage.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <format>
+#include <string_view>
+
+#ifndef ERBSLAND_OS_WINDOWS
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+namespace erbsland::unittest {
+
+namespace {
+
+#ifndef ERBSLAND_OS_WINDOWS
+
+/// Call a function for each entry in a directory, except `.`, `..` and the descriptor used to read it.
+/// @return `false` if the directory cannot be read.
+template <typename Func>
+auto forEachEntry(const char *path, Func &&func) -> bool {
+    auto *directory = ::opendir(path);
+    if (directory == nullptr) {
+        return false;
+    }
+    const auto directoryFd = std::to_string(::dirfd(directory));
+    while (const auto *entry = ::readdir(directory)) {
+        const std::string_view name{entry->d_name};
+        if (name == "." || name == ".." || name == directoryFd) {
+            continue;
+        }
+        func(name);
+    }
+    ::closedir(directory);
+    return true;
+}
+
+#endif
+
+#if defined(ERBSLAND_OS_MACOS)
+constexpr auto cFileDescriptorPath = "/dev/fd";
+#else
+constexpr auto cFileDescriptorPath = "/proc/self/fd";
+#endif
+
+}
+
+auto ResourceSnapshot::capture(const std::int64_t heapBytes) -> ResourceSnapshot {
+    ResourceSnapshot snapshot;
+    snapshot._heapBytes = heapBytes;
+#ifndef ERBSLAND_OS_WINDOWS
+    snapshot._hasFileDescriptors = forEachEntry(cFileDescriptorPath, [&](const std::string_view name) -> void {
+        const auto fd = std::atoi(std::string{name}.c_str());
+        std::array<char, 256> target{};
+        const auto path = std::format("{}/{}", cFileDescriptorPath, name);
+        const auto size = ::readlink(path.c_str(), target.data(), target.size() - 1);
+        snapshot._fileDescriptors.emplace(fd, size > 0 ? std::string{target.data(), static_cast<std::size_t>(size)}
+                                                       : std::string{});
+    });
+#if !defined(ERBSLAND_OS_MACOS)
+    (void)forEachEntry("/proc/self/task", [&](std::string_view) -> void { ++snapshot._threadCount; });
+#endif
+#endif
+    return snapshot;
+}
+
+auto ResourceSnapshot::leaksSince(const ResourceSnapshot &before) const -> std::vector<std::string> {
+    std::vector<std::string> leaks;
+    if (_heapBytes > before._heapBytes) {
+        leaks.push_back(std::format("The test did not release {}.", memorySizeText(_heapBytes - before._heapBytes)));
+    }
+    if (_hasFileDescriptors && before._hasFileDescriptors) {
+        std::string descriptors;
+        std::size_t count = 0;
+        for (const auto &[fd, target] : _fileDescriptors) {
+            if (before._fileDescriptors.contains(fd)) {
+                continue;
+            }
+            descriptors += count == 0 ? " " : ", ";
+            descriptors += target.empty() ? std::to_string(fd) : std::format("{} ({})", fd, target);
+            ++count;
+        }
+        if (count > 0) {
+            leaks.push_back(std::format(
+                "The test did not close {} file descriptor{}:{}", count, count == 1 ? "" : "s", descriptors));
+        }
+    }
+    if (_threadCount > 0 && before._threadCount > 0 && _threadCount > before._threadCount) {
+        const auto count = _threadCount - before._threadCount;
+        leaks.push_back(std::format("The test left {} thread{} running.", count, count == 1 ? "" : "s"));
+    }
+    return leaks;
+}
+
+}
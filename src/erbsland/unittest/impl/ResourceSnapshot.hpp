@@ -0,0 +1,42 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// A snapshot of the resources of this process, to find the resources that a test did not release.
+///
+/// The open file descriptors are read from `/proc/self/fd` (`/dev/fd` on macOS), and the running threads from
+/// `/proc/self/task`. Resources that cannot be read on a platform are not compared.
+///
+class ResourceSnapshot {
+public:
+    /// Capture the resources of this process.
+    /// @param heapBytes The number of bytes allocated by the test, that are not freed.
+    [[nodiscard]] static auto capture(std::int64_t heapBytes = 0) -> ResourceSnapshot;
+
+    /// The number of running threads, or zero if it cannot be determined on this platform.
+    [[nodiscard]] auto threadCount() const noexcept -> std::size_t { return _threadCount; }
+
+    /// Describe the resources that were acquired after an earlier snapshot, and are still in use.
+    /// @param before The snapshot that was captured before the test.
+    /// @return One line for each type of leaked resource, or an empty list if nothing leaked.
+    [[nodiscard]] auto leaksSince(const ResourceSnapshot &before) const -> std::vector<std::string>;
+
+private:
+    std::int64_t _heapBytes{0};                  ///< The allocated bytes that are not freed.
+    bool _hasFileDescriptors{false};             ///< If the file descriptors could be read.
+    std::map<int, std::string> _fileDescriptors; ///< The open file descriptors, with the file they refer to.
+    std::size_t _threadCount{0};                 ///< The number of running threads.
+};
+
+}
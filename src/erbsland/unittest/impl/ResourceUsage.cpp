@@ -0,0 +1,154 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "ResourceUsage.hpp"
+
+#include <algorithm>
+#include <format>
+#include <sstream>
+
+#if defined(ERBSLAND_OS_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace erbsland::unittest {
+
+namespace {
+
+#if defined(ERBSLAND_OS_WINDOWS)
+
+/// Convert a `FILETIME` duration, in units of 100 nanoseconds.
+auto fromFileTime(const FILETIME &fileTime) noexcept -> std::chrono::nanoseconds {
+    const auto ticks = (static_cast<std::uint64_t>(fileTime.dwHighDateTime) << 32U) | fileTime.dwLowDateTime;
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(ticks) * 100};
+}
+
+#else
+
+/// Convert a `timeval` duration.
+auto fromTimeval(const timeval &time) noexcept -> std::chrono::nanoseconds {
+    return std::chrono::seconds{time.tv_sec} + std::chrono::microseconds{time.tv_usec};
+}
+
+#endif
+
+}
+
+auto ResourceUsage::current() noexcept -> ResourceUsage {
+    ResourceUsage usage;
+    usage.wallTime = std::chrono::steady_clock::now().time_since_epoch();
+#if defined(ERBSLAND_OS_WINDOWS)
+    FILETIME creationTime{};
+    FILETIME exitTime{};
+    FILETIME kernelTime{};
+    FILETIME userTime{};
+    if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime) != 0) {
+        usage.userTime = fromFileTime(userTime);
+        usage.systemTime = fromFileTime(kernelTime);
+    }
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) != 0) {
+        // Windows does not distinguish between minor and major page faults.
+        usage.minorFaults = static_cast<std::int64_t>(counters.PageFaultCount);
+    }
+#else
+#if defined(RUSAGE_THREAD)
+    constexpr int cUsageScope = RUSAGE_THREAD;
+#else
+    constexpr int cUsageScope = RUSAGE_SELF;
+#endif
+    rusage data{};
+    if (::getrusage(cUsageScope, &data) == 0) {
+        usage.userTime = fromTimeval(data.ru_utime);
+        usage.systemTime = fromTimeval(data.ru_stime);
+        usage.minorFaults = data.ru_minflt;
+        usage.majorFaults = data.ru_majflt;
+        usage.voluntarySwitches = data.ru_nvcsw;
+        usage.involuntarySwitches = data.ru_nivcsw;
+    }
+#endif
+    return usage;
+}
+
+auto ResourceUsage::operator-(const ResourceUsage &other) const noexcept -> ResourceUsage {
+    return ResourceUsage{
+        .wallTime = wallTime - other.wallTime,
+        .userTime = userTime - other.userTime,
+        .systemTime = systemTime - other.systemTime,
+        .minorFaults = minorFaults - other.minorFaults,
+        .majorFaults = majorFaults - other.majorFaults,
+        .voluntarySwitches = voluntarySwitches - other.voluntarySwitches,
+        .involuntarySwitches = involuntarySwitches - other.involuntarySwitches,
+    };
+}
+
+auto ResourceUsage::cpuTime() const noexcept -> std::chrono::nanoseconds {
+    return userTime + systemTime;
+}
+
+auto ResourceUsage::waitTime() const noexcept -> std::chrono::nanoseconds {
+    // The CPU time is measured with a lower resolution, so it can exceed the wall time.
+    return std::max(wallTime - cpuTime(), std::chrono::nanoseconds{});
+}
+
+auto ResourceUsage::toText() const -> std::string {
+    return std::format("{} wall, {} user, {} system, {} minor and {} major page faults, "
+                       "{} voluntary and {} involuntary context switches.",
+        durationText(wallTime),
+        durationText(userTime),
+        durationText(systemTime),
+        minorFaults,
+        majorFaults,
+        voluntarySwitches,
+        involuntarySwitches);
+}
+
+void ResourceUsage::serialize(std::string &message) const {
+    message += std::format("{} {} {} {} {} {} {};",
+        wallTime.count(),
+        userTime.count(),
+        systemTime.count(),
+        minorFaults,
+        majorFaults,
+        voluntarySwitches,
+        involuntarySwitches);
+}
+
+auto ResourceUsage::deserialize(std::string_view &message) -> std::optional<ResourceUsage> {
+    const auto end = message.find(';');
+    if (end == std::string_view::npos) {
+        return std::nullopt;
+    }
+    std::stringstream text{std::string{message.substr(0, end)}};
+    std::int64_t wall = 0;
+    std::int64_t user = 0;
+    std::int64_t system = 0;
+    ResourceUsage usage;
+    text >> wall >> user >> system >> usage.minorFaults >> usage.majorFaults >> usage.voluntarySwitches >>
+        usage.involuntarySwitches;
+    if (text.fail()) {
+        return std::nullopt;
+    }
+    usage.wallTime = std::chrono::nanoseconds{wall};
+    usage.userTime = std::chrono::nanoseconds{user};
+    usage.systemTime = std::chrono::nanoseconds{system};
+    message.remove_prefix(end + 1);
+    return usage;
+}
+
+auto durationText(const std::chrono::nanoseconds duration) -> std::string {
+    const auto nanoseconds = static_cast<double>(duration.count());
+    if (duration < std::chrono::milliseconds{10}) {
+        return std::format("{:.2f} ms", nanoseconds / 1e6);
+    }
+    if (duration < std::chrono::seconds{1}) {
+        return std::format("{:.1f} ms", nanoseconds / 1e6);
+    }
+    return std::format("{:.2f} s", nanoseconds / 1e9);
+}
+
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// The time and system resources used by the calling thread, or the difference between two measurements.
+///
+/// On Linux, the values are read with `getrusage(RUSAGE_THREAD)`, so they only include the calling thread. Threads
+/// started by a test are not included. Platforms without `RUSAGE_THREAD`, like macOS, fall back to the usage of the
+/// whole process. On Windows, the CPU times are read for the thread, and the page faults for the process.
+///
+struct ResourceUsage {
+    std::chrono::nanoseconds wallTime{};   ///< The elapsed time.
+    std::chrono::nanoseconds userTime{};   ///< The CPU time spent in user mode.
+    std::chrono::nanoseconds systemTime{}; ///< The CPU time spent in the kernel.
+    std::int64_t minorFaults{0};           ///< Page faults, that were served without I/O.
+    std::int64_t majorFaults{0};           ///< Page faults, that required I/O.
+    std::int64_t voluntarySwitches{0};     ///< Context switches, because the process waited.
+    std::int64_t involuntarySwitches{0};   ///< Context switches, because the time slice ended.
+
+    /// Measure the current usage of the calling thread.
+    [[nodiscard]] static auto current() noexcept -> ResourceUsage;
+
+    /// The difference to an earlier measurement.
+    [[nodiscard]] auto operator-(const ResourceUsage &other) const noexcept -> ResourceUsage;
+
+    /// The CPU time in user mode and in the kernel.
+    [[nodiscard]] auto cpuTime() const noexcept -> std::chrono::nanoseconds;
+    /// The elapsed time without the CPU time, like the time spent in sleeps, timeouts and I/O.
+    [[nodiscard]] auto waitTime() const noexcept -> std::chrono::nanoseconds;
+
+    /// Get a description of this usage for the console.
+    [[nodiscard]] auto toText() const -> std::string;
+
+    /// Serialize this usage into a message, to send it from a child process.
+    void serialize(std::string &message) const;
+    /// Deserialize a usage from the start of a message, and remove the read part.
+    /// @return The usage, or no value if the message is incomplete.
+    [[nodiscard]] static auto deserialize(std::string_view &message) -> std::optional<ResourceUsage>;
+};
+
+/// Format a duration for the console, like `0.85 ms`, `12.3 ms` or `1.25 s`.
+auto durationText(std::chrono::nanoseconds duration) -> std::string;
+
+}
@@ -0,0 +1,188 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// The kind of a part in the difference of two sequences.
+enum class DiffOperation : std::uint8_t {
+    Equal,  ///< The elements are in both sequences.
+    Delete, ///< The elements are only in the first sequence.
+    Insert, ///< The elements are only in the second sequence.
+};
+
+/// @internal
+/// A part of the difference of two sequences.
+struct DiffRange {
+    DiffOperation operation{DiffOperation::Equal}; ///< The kind of this part.
+    std::size_t indexA{0};                         ///< The index of the part in the first sequence.
+    std::size_t indexB{0};                         ///< The index of the part in the second sequence.
+    std::size_t count{0};                          ///< The number of elements in this part.
+};
+
+/// @internal
+/// The limits for the difference of two sequences.
+struct DiffLimits {
+    std::size_t maximumEdits{1'000};            ///< The maximum number of deleted and inserted elements.
+    std::size_t maximumComparisons{50'000'000}; ///< The maximum number of compared elements.
+};
+
+/// @internal
+/// Get the shortest difference of two sequences, using the O(ND) algorithm from Eugene W. Myers.
+///
+/// The equal elements at the start and the end of both sequences are skipped first, so a few differences in long
+/// sequences are found in linear time. The runtime and memory of the algorithm grow with the number of differences,
+/// therefore the search stops at the given limits.
+///
+/// @param sizeA The number of elements in the first sequence.
+/// @param sizeB The number of elements in the second sequence.
+/// @param isEqual A callable `(indexA, indexB) -> bool`, that compares two elements.
+/// @param limits The limits for the search.
+/// @return The parts of the difference in order, or no value if the limits were exceeded.
+template <typename EqualFunc>
+[[nodiscard]] auto sequenceDiff(
+    const std::size_t sizeA, const std::size_t sizeB, EqualFunc &&isEqual, const DiffLimits &limits = {})
+    -> std::optional<std::vector<DiffRange>> {
+
+    std::vector<DiffRange> result;
+    // Skip the common prefix and suffix.
+    std::size_t prefix = 0;
+    while (prefix < sizeA && prefix < sizeB && isEqual(prefix, prefix)) {
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (suffix < sizeA - prefix && suffix < sizeB - prefix && isEqual(sizeA - suffix - 1, sizeB - suffix - 1)) {
+        ++suffix;
+    }
+    if (prefix > 0) {
+        result.push_back(DiffRange{.operation = DiffOperation::Equal, .indexA = 0, .indexB = 0, .count = prefix});
+    }
+    const auto n = static_cast<std::ptrdiff_t>(sizeA - prefix - suffix);
+    const auto m = static_cast<std::ptrdiff_t>(sizeB - prefix - suffix);
+    const auto maximumD = static_cast<std::ptrdiff_t>(
+        std::min(static_cast<std::size_t>(n + m), limits.maximumEdits));
+    // The positions `x` and `y` are relative to the end of the common prefix.
+    auto equalAt = [&isEqual, prefix](const std::ptrdiff_t x, const std::ptrdiff_t y) -> bool {
+        return isEqual(prefix + static_cast<std::size_t>(x), prefix + static_cast<std::size_t>(y));
+    };
+    // `v[k]` is the furthest x on diagonal k; `trace[d]` keeps the values of `v` before step `d`.
+    const auto offset = maximumD + 1;
+    std::vector<std::ptrdiff_t> v(static_cast<std::size_t>(2 * maximumD + 3), 0);
+    std::vector<std::vector<std::ptrdiff_t>> trace;
+    std::size_t comparisons = 0;
+    std::optional<std::ptrdiff_t> foundD;
+    for (std::ptrdiff_t d = 0; d <= maximumD && !foundD.has_value(); ++d) {
+        trace.emplace_back(v.begin() + (offset - d - 1), v.begin() + (offset + d + 2));
+        for (std::ptrdiff_t k = -d; k <= d; k += 2) {
+            const auto index = static_cast<std::size_t>(offset + k);
+            auto x = (k == -d || (k != d && v[index - 1] < v[index + 1])) ? v[index + 1] : v[index - 1] + 1;
+            auto y = x - k;
+            ++comparisons;
+            while (x < n && y < m && equalAt(x, y)) {
+                ++x;
+                ++y;
+                ++comparisons;
+            }
+            v[index] = x;
+            if (x >= n && y >= m) {
+                foundD = d;
+                break;
+            }
+        }
+        if (comparisons > limits.maximumComparisons) {
+            return std::nullopt;
+        }
+    }
+    if (!foundD.has_value()) {
+        return std::nullopt;
+    }
+    // Follow the trace backwards, to get the edits in reverse order.
+    std::vector<DiffRange> middle;
+    auto addReverse = [&middle, prefix](const DiffOperation operation, const std::ptrdiff_t x, const std::ptrdiff_t y) {
+        const auto indexA = prefix + static_cast<std::size_t>(x);
+        const auto indexB = prefix + static_cast<std::size_t>(y);
+        if (!middle.empty() && middle.back().operation == operation) {
+            auto &range = middle.back();
+            range.count += 1;
+            range.indexA = indexA;
+            range.indexB = indexB;
+        } else {
+            middle.push_back(DiffRange{.operation = operation, .indexA = indexA, .indexB = indexB, .count = 1});
+        }
+    };
+    auto x = n;
+    auto y = m;
+    for (auto d = *foundD; d > 0; --d) {
+        const auto &previous = trace[static_cast<std::size_t>(d)];
+        const auto k = x - y;
+        // In the trace of step `d`, diagonal `k` is at index `k + d + 1`.
+        auto at = [&previous, d](const std::ptrdiff_t diagonal) -> std::ptrdiff_t {
+            return previous[static_cast<std::size_t>(diagonal + d + 1)];
+        };
+        const bool isInsert = (k == -d || (k != d && at(k - 1) < at(k + 1)));
+        const auto previousK = isInsert ? k + 1 : k - 1;
+        const auto previousX = at(previousK);
+        const auto previousY = previousX - previousK;
+        while (x > previousX + (isInsert ? 0 : 1) && y > previousY + (isInsert ? 1 : 0)) {
+            --x;
+            --y;
+            addReverse(DiffOperation::Equal, x, y);
+        }
+        if (isInsert) {
+            --y;
+            addReverse(DiffOperation::Insert, x, y);
+        } else {
+            --x;
+            addReverse(DiffOperation::Delete, x, y);
+        }
+    }
+    while (x > 0 && y > 0) {
+        --x;
+        --y;
+        addReverse(DiffOperation::Equal, x, y);
+    }
+    for (auto it = middle.rbegin(); it != middle.rend(); ++it) {
+        if (!result.empty() && result.back().operation == it->operation) {
+            result.back().count += it->count;
+        } else {
+            result.push_back(*it);
+        }
+    }
+    if (suffix > 0) {
+        result.push_back(DiffRange{
+            .operation = DiffOperation::Equal, .indexA = sizeA - suffix, .indexB = sizeB - suffix, .count = suffix});
+    }
+    return result;
+}
+
+/// @internal
+/// Get a function, that accesses the elements of a range by index.
+/// Ranges without random access are indexed using a list of iterators.
+template <typename R>
+[[nodiscard]] auto indexedElements(const R &range) {
+    if constexpr (std::ranges::random_access_range<const R>) {
+        return [begin = std::ranges::begin(range)](const std::size_t index) -> decltype(auto) {
+            return begin[static_cast<std::ranges::range_difference_t<const R>>(index)];
+        };
+    } else {
+        std::vector<std::ranges::iterator_t<const R>> iterators;
+        iterators.reserve(static_cast<std::size_t>(std::ranges::distance(range)));
+        for (auto it = std::ranges::begin(range); it != std::ranges::end(range); ++it) {
+            iterators.push_back(it);
+        }
+        return [iterators = std::move(iterators)](const std::size_t index) -> decltype(auto) {
+            return *iterators[index];
+        };
+    }
+}
+
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "SharedFixtures.hpp"
+
+#include "Demangle.hpp"
+#include "MemoryUsage.hpp"
+
+#include <chrono>
+#include <format>
+#include <stdexcept>
+
+namespace erbsland::unittest {
+
+void SharedFixtures::setLogger(Logger logger) {
+    _logger = std::move(logger);
+}
+
+void SharedFixtures::addUser(const std::string &name, const std::string &suite) {
+    std::unique_lock lock{_mutex};
+    auto &entry = _entries[name];
+    if (entry == nullptr) {
+        entry = std::make_unique<Entry>();
+    }
+    entry->users.insert(suite);
+}
+
+auto SharedFixtures::acquire(
+    const std::string &name, const std::type_info &type, const std::string &suite, const Factory &factory) -> void * {
+
+    std::unique_lock lock{_mutex};
+    auto &entryPtr = _entries[name];
+    if (entryPtr == nullptr) {
+        entryPtr = std::make_unique<Entry>();
+    }
+    Entry *entry = entryPtr.get();
+    // Registering the user first, prevents the fixture from being destroyed while it is created.
+    entry->users.insert(suite);
+    while (entry->isCreating) {
+        if (entry->creatingThread == std::this_thread::get_id()) {
+            throw std::logic_error(
+                std::format("The shared fixture \"{}\" is requested while its factory creates it.", name));
+        }
+        _creationFinished.wait(lock);
+    }
+    if (entry->object != nullptr) {
+        if (entry->type != std::type_index{type}) {
+            throw std::logic_error(std::format(
+                "The shared fixture \"{}\" was created with the type `{}`, but is accessed with the type `{}`.",
+                name,
+                demangleTypeName(entry->type.name()),
+                demangleTypeName(type.name())));
+        }
+        return entry->object.get();
+    }
+    // Run the factory without a lock, so it can acquire other fixtures.
+    entry->isCreating = true;
+    entry->creatingThread = std::this_thread::get_id();
+    lock.unlock();
+    const auto memoryBefore = residentMemorySize();
+    const auto startTime = std::chrono::steady_clock::now();
+    std::shared_ptr<void> object;
+    try {
+        object = factory();
+    } catch (...) {
+        lock.lock();
+        entry->isCreating = false;
+        _creationFinished.notify_all();
+        throw;
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+    const auto memoryAfter = residentMemorySize();
+    void *result = object.get();
+    lock.lock();
+    entry->object = std::move(object);
+    entry->type = std::type_index{type};
+    entry->isCreating = false;
+    _creationFinished.notify_all();
+    lock.unlock();
+    if (_logger) {
+        auto text = std::format("Shared fixture \"{}\" created in {:.3f} seconds", name, duration.count());
+        if (memoryBefore > 0 && memoryAfter > 0) {
+            const auto difference = static_cast<std::int64_t>(memoryAfter) - static_cast<std::int64_t>(memoryBefore);
+            text += std::format(", memory {}{}", difference >= 0 ? "+" : "", memorySizeText(difference));
+        }
+        text += ".";
+        _logger(text);
+    }
+    return result;
+}
+
+void SharedFixtures::releaseSuite(const std::string &suite) {
+    std::map<std::string, std::shared_ptr<void>> objects;
+    {
+        std::unique_lock lock{_mutex};
+        for (auto &[name, entry] : _entries) {
+            if (entry->users.erase(suite) == 0 || !entry->users.empty()) {
+                continue;
+            }
+            if (entry->object != nullptr) {
+                objects.emplace(name, std::move(entry->object));
+                entry->object = nullptr;
+            }
+        }
+    }
+    destroy(std::move(objects));
+}
+
+void SharedFixtures::releaseAll() {
+    std::map<std::string, std::shared_ptr<void>> objects;
+    {
+        std::unique_lock lock{_mutex};
+        for (auto &[name, entry] : _entries) {
+            entry->users.clear();
+            if (entry->object != nullptr) {
+                objects.emplace(name, std::move(entry->object));
+                entry->object = nullptr;
+            }
+        }
+    }
+    destroy(std::move(objects));
+}
+
+void SharedFixtures::destroy(std::map<std::string, std::shared_ptr<void>> objects) {
+    // Destroy the objects outside the lock, as destructors of large fixtures may take some time.
+    for (auto &[name, object] : objects) {
+        const auto memoryBefore = residentMemorySize();
+        object.reset();
+        const auto memoryAfter = residentMemorySize();
+        if (_logger) {
+            auto text = std::format("Shared fixture \"{}\" destroyed", name);
+            if (memoryBefore > 0 && memoryAfter > 0) {
+                const auto difference =
+                    static_cast<std::int64_t>(memoryAfter) - static_cast<std::int64_t>(memoryBefore);
+                text += std::format(", memory {}{}", difference >= 0 ? "+" : "", memorySizeText(difference));
+            }
+            text += ".";
+            _logger(text);
+        }
+    }
+}
+
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// The registry of named global fixtures, shared by all test suites.
+///
+/// Fixtures are created on first use. Each fixture counts the suites that use it: suites that declared it
+/// with `SHARED_FIXTURES()` before the run, and suites that acquired it. When the last of these suites
+/// finished, the fixture is destroyed. All methods are thread-safe; if several threads acquire a fixture at
+/// the same time, it is created once and all threads wait for the creation.
+///
+/// No lock is held while a factory runs, so a factory can acquire other fixtures.
+///
+class SharedFixtures {
+public:
+    using Factory = std::function<std::shared_ptr<void>()>; ///< The factory to create a fixture.
+    using Logger = std::function<void(const std::string &)>; ///< A function to write verbose messages.
+
+public:
+    /// Set the function used to report the creation and destruction of fixtures.
+    void setLogger(Logger logger);
+    /// Register a suite that will use a fixture.
+    /// @param name The name of the fixture.
+    /// @param suite The name of the suite.
+    void addUser(const std::string &name, const std::string &suite);
+    /// Get a fixture, and create it if required.
+    /// @param name The name of the fixture.
+    /// @param type The type of the fixture.
+    /// @param suite The name of the suite that uses the fixture.
+    /// @param factory The factory to create the fixture.
+    /// @return A pointer to the fixture, that is valid until the suite finished.
+    /// @throws std::logic_error If the fixture was created with a different type, or if the factory of the
+    ///     fixture requests the fixture itself.
+    auto acquire(const std::string &name, const std::type_info &type, const std::string &suite, const Factory &factory)
+        -> void *;
+    /// Release all fixtures used by a suite.
+    /// Fixtures that are no longer used by any suite are destroyed.
+    void releaseSuite(const std::string &suite);
+    /// Destroy all remaining fixtures.
+    void releaseAll();
+
+private:
+    /// A single fixture.
+    struct Entry {
+        std::type_index type{typeid(void)}; ///< The type of the object.
+        std::shared_ptr<void> object;       ///< The object, or null if not created yet.
+        std::set<std::string> users;        ///< The suites using this fixture.
+        bool isCreating{false};             ///< If the factory for the object is running.
+        std::thread::id creatingThread;     ///< The thread that runs the factory.
+    };
+
+private:
+    /// Destroy the objects of the given fixtures.
+    void destroy(std::map<std::string, std::shared_ptr<void>> objects);
+
+private:
+    std::mutex _mutex;                                      ///< Synchronizes the access to the entries.
+    std::condition_variable _creationFinished;              ///< Notified when a factory returned or failed.
+    std::map<std::string, std::unique_ptr<Entry>> _entries; ///< All fixtures, by name.
+    Logger _logger;                                         ///< The logger for verbose messages.
+};
+
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "StringDiff.hpp"
+
+#include "ConsoleLine.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <format>
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// The number of characters shown before and after the differing part.
+constexpr std::size_t cContextLength = 20;
+/// The maximum number of shown characters from the differing part.
+constexpr std::size_t cMaximumDifferenceLength = 40;
+/// The marker for text that is not shown.
+constexpr std::string_view cEllipsis = "...";
+
+/// Test if the byte at the given index is a UTF-8 continuation byte.
+auto isContinuation(const std::string_view text, const std::size_t index) noexcept -> bool {
+    return index < text.size() && (static_cast<std::uint8_t>(text[index]) & 0xC0U) == 0x80U;
+}
+
+/// Move an index back by a number of characters.
+auto moveBackward(const std::string_view text, std::size_t index, std::size_t count) noexcept -> std::size_t {
+    for (; count > 0 && index > 0; --count) {
+        --index;
+        while (index > 0 && isContinuation(text, index)) {
+            --index;
+        }
+    }
+    return index;
+}
+
+/// Move an index forward by a number of characters, without passing the given end.
+auto moveForward(const std::string_view text, std::size_t index, std::size_t count, const std::size_t end) noexcept
+    -> std::size_t {
+    for (; count > 0 && index < end; --count) {
+        ++index;
+        while (index < end && isContinuation(text, index)) {
+            ++index;
+        }
+    }
+    return index;
+}
+
+/// Create the escaped window of one string.
+/// @param text The string.
+/// @param windowStart The byte index of the first shown character.
+/// @param diffStart The byte index of the first differing character.
+/// @param diffEnd The byte index after the differing part.
+auto windowText(
+    const std::string_view text, const std::size_t windowStart, const std::size_t diffStart, const std::size_t diffEnd)
+    -> std::string {
+
+    std::string result;
+    if (windowStart > 0) {
+        result += cEllipsis;
+    }
+    result += ConsoleLine::utf8EscapedString(text.substr(windowStart, diffStart - windowStart));
+    const auto shownEnd = moveForward(text, diffStart, cMaximumDifferenceLength, diffEnd);
+    result += ConsoleLine::utf8EscapedString(text.substr(diffStart, shownEnd - diffStart));
+    if (shownEnd < diffEnd) {
+        result += cEllipsis;
+        return result;
+    }
+    const auto contextEnd = moveForward(text, diffEnd, cContextLength, text.size());
+    result += ConsoleLine::utf8EscapedString(text.substr(diffEnd, contextEnd - diffEnd));
+    if (contextEnd < text.size()) {
+        result += cEllipsis;
+    }
+    return result;
+}
+
+}
+
+auto commonPrefixLength(const std::string_view a, const std::string_view b) noexcept -> std::size_t {
+    const auto size = std::min(a.size(), b.size());
+    std::size_t index = 0;
+    // Compare blocks of eight bytes first, as most of a long string is usually equal.
+    for (; index + sizeof(std::uint64_t) <= size; index += sizeof(std::uint64_t)) {
+        std::uint64_t blockA = 0;
+        std::uint64_t blockB = 0;
+        std::memcpy(&blockA, a.data() + index, sizeof(blockA));
+        std::memcpy(&blockB, b.data() + index, sizeof(blockB));
+        if (blockA != blockB) {
+            break;
+        }
+    }
+    while (index < size && a[index] == b[index]) {
+        ++index;
+    }
+    return index;
+}
+
+auto commonSuffixLength(const std::string_view a, const std::string_view b, const std::size_t maximumLength) noexcept
+    -> std::size_t {
+    const auto size = std::min({a.size(), b.size(), maximumLength});
+    std::size_t length = 0;
+    for (; length + sizeof(std::uint64_t) <= size; length += sizeof(std::uint64_t)) {
+        std::uint64_t blockA = 0;
+        std::uint64_t blockB = 0;
+        std::memcpy(&blockA, a.data() + a.size() - length - sizeof(blockA), sizeof(blockA));
+        std::memcpy(&blockB, b.data() + b.size() - length - sizeof(blockB), sizeof(blockB));
+        if (blockA != blockB) {
+            break;
+        }
+    }
+    while (length < size && a[a.size() - length - 1] == b[b.size() - length - 1]) {
+        ++length;
+    }
+    return length;
+}
+
+auto stringDiffMessage(
+    const std::string_view a, const std::string_view b, const std::string_view aExpr, const std::string_view bExpr)
+    -> std::string {
+
+    // Move the limits of the differing part to the start of a UTF-8 sequence.
+    auto prefix = commonPrefixLength(a, b);
+    while (prefix > 0 && (isContinuation(a, prefix) || isContinuation(b, prefix))) {
+        --prefix;
+    }
+    auto suffix = commonSuffixLength(a, b, std::min(a.size(), b.size()) - prefix);
+    while (suffix > 0 && isContinuation(a, a.size() - suffix)) {
+        --suffix;
+    }
+    const auto windowStart = moveBackward(a, prefix, cContextLength);
+    const auto equalText = ConsoleLine::utf8EscapedString(a.substr(windowStart, prefix - windowStart));
+    const auto caretColumn = (windowStart > 0 ? cEllipsis.size() : 0) + equalText.size();
+    return std::format(
+        "Strings differ after {} equal characters ({} bytes): A has {} bytes, B has {} bytes."
+        "\n  A: {}\n     {}\n  B: {}\n     {}\n     {}^",
+        ConsoleLine::utf8Length(a.substr(0, prefix)),
+        prefix,
+        a.size(),
+        b.size(),
+        aExpr,
+        windowText(a, windowStart, prefix, a.size() - suffix),
+        bExpr,
+        windowText(b, windowStart, prefix, b.size() - suffix),
+        std::string(caretColumn, ' '));
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace erbsland::unittest {
+
+/// @internal
+/// The minimum size of a string, to use a character diff in the error message of a failed comparison.
+/// Shorter strings are shown completely.
+constexpr std::size_t cStringDiffMinimumSize = 80;
+
+/// Get the number of equal bytes at the start of two strings.
+/// @param a The first string.
+/// @param b The second string.
+/// @return The length of the common prefix in bytes.
+[[nodiscard]] auto commonPrefixLength(std::string_view a, std::string_view b) noexcept -> std::size_t;
+
+/// Get the number of equal bytes at the end of two strings.
+/// @param a The first string.
+/// @param b The second string.
+/// @param maximumLength The maximum length of the suffix, to keep it from overlapping a common prefix.
+/// @return The length of the common suffix in bytes.
+[[nodiscard]] auto commonSuffixLength(std::string_view a, std::string_view b, std::size_t maximumLength) noexcept
+    -> std::size_t;
+
+/// Generates the error message for two UTF-8 strings that are not equal.
+/// The message shows an escaped window around the first difference, with a caret below it.
+/// @param a The first string.
+/// @param b The second string.
+/// @param aExpr The textual representation of the first string.
+/// @param bExpr The textual representation of the second string.
+/// @return A detailed error message.
+auto stringDiffMessage(std::string_view a, std::string_view b, std::string_view aExpr, std::string_view bExpr)
+    -> std::string;
+
+/// Test if a type is a UTF-8 string, that is compared with a character diff.
+/// Pointers are excluded, as they can be null.
+/// @tparam T The tested type.
+template <typename T>
+constexpr bool is_diff_string = !std::is_pointer_v<std::remove_cvref_t<T>> &&
+    (std::is_convertible_v<const T &, std::string_view> || std::is_convertible_v<const T &, std::u8string_view>);
+
+/// @internal
+/// Get the bytes of a UTF-8 string for the character diff.
+template <typename T>
+[[nodiscard]] auto diffStringView(const T &value) noexcept -> std::string_view {
+    if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        return std::string_view{value};
+    } else {
+        const auto text = std::u8string_view{value};
+        return {reinterpret_cast<const char *>(text.data()), text.size()};
+    }
+}
+
+}
@@ -4,6 +4,9 @@
 
 #include "TestBase.hpp"
 
+#include <cstddef>
+#include <span>
+
 namespace erbsland::unittest {
 
 /// @internal
@@ -12,28 +15,40 @@ namespace erbsland::unittest {
 template <class T>
 class Test : public TestBase {
 public:
-    using TestFunction = void (T::*)(); ///< The member function pointer to the test method.
+    using TestFunction = void (T::*)();                           ///< The member function pointer to the test method.
+    using FuzzFunction = void (T::*)(std::span<const std::byte>); ///< The member function pointer to a fuzz method.
 
 public:
     /// ctor
     /// @param testFunction The test function pointer.
     /// @param metaData Meta data of the test function.
     Test(TestFunction testFunction, MetaData metaData) : TestBase(std::move(metaData)), _testFunction(testFunction) {}
+    /// ctor
+    /// @param fuzzFunction The fuzz function pointer.
+    /// @param metaData Meta data of the fuzz function.
+    Test(FuzzFunction fuzzFunction, MetaData metaData) : TestBase(std::move(metaData)), _fuzzFunction(fuzzFunction) {}
 
 public:
     /// Access the test function.
     [[nodiscard]] inline auto testFunction() const -> TestFunction { return _testFunction; }
+    /// Access the fuzz function.
+    [[nodiscard]] inline auto fuzzFunction() const -> FuzzFunction { return _fuzzFunction; }
 
 public: // Implement TestBase
     void call(UnitTest *unitTest) override {
         auto ptr = static_cast<T *>(unitTest);
         ptr->setUp();
-        (ptr->*_testFunction)();
+        if (_fuzzFunction != nullptr) {
+            (ptr->*_fuzzFunction)({});
+        } else {
+            (ptr->*_testFunction)();
+        }
         ptr->tearDown();
     }
 
 private:
-    TestFunction _testFunction; ///< The test function.
+    TestFunction _testFunction{}; ///< The test function.
+    FuzzFunction _fuzzFunction{}; ///< The fuzz function, if this is a fuzz test.
 };
 
 }
@@ -26,6 +26,11 @@ public:
         _tests.emplace_back(std::make_shared<Test<T>>(fn, metaData));
     }
 
+    /// Add a fuzz test to this test class.
+    void addFuzzTest(typename Test<T>::FuzzFunction fn, const MetaData &metaData) {
+        _tests.emplace_back(std::make_shared<Test<T>>(fn, metaData));
+    }
+
     [[nodiscard]] auto testCount() const -> std::size_t override { return _tests.size(); }
 
     [[nodiscard]] auto testMetaData(std::size_t index) const -> const MetaData & override {
@@ -43,8 +48,26 @@ public:
         _unitTest->tearDown();
     }
 
+    void callFuzzTest(std::size_t index, std::span<const std::byte> input) override {
+        if (!_unitTest) {
+            createUnitTest();
+        }
+        _unitTest->setUp();
+        (_unitTest->*(_tests[index]->fuzzFunction()))(input);
+        _unitTest->tearDown();
+    }
+
     void createUnitTest() override { _unitTest = new T(); }
 
+    void destroyUnitTest() noexcept override {
+        delete _unitTest;
+        _unitTest = nullptr;
+    }
+
+    void callSetUpSuite() override { _unitTest->setUpSuite(); }
+
+    void callTearDownSuite() override { _unitTest->tearDownSuite(); }
+
     [[nodiscard]] auto isEnabled() const -> bool override {
         for (const auto &test : _tests) {
             if (test->isEnabled()) {
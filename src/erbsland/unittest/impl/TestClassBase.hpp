@@ -4,6 +4,9 @@
 
 #include "MetaData.hpp"
 
+#include <cstddef>
+#include <span>
+
 namespace erbsland::unittest {
 
 class TestBase;
@@ -32,10 +35,18 @@ public: // api
     [[nodiscard]] virtual auto testMetaData(std::size_t index) const -> const MetaData & = 0;
     /// Call the test function for a test.
     virtual void callTest(std::size_t index) = 0;
+    /// Call the fuzz function of a fuzz test, with the given input.
+    virtual void callFuzzTest(std::size_t index, std::span<const std::byte> input) = 0;
     /// Access a test.
     [[nodiscard]] virtual auto test(std::size_t index) const -> TestBase * = 0;
     /// Create the unittest instance (internally).
     virtual void createUnitTest() = 0;
+    /// Destroy the unittest instance, to release its memory after the last test.
+    virtual void destroyUnitTest() noexcept = 0;
+    /// Call the suite set-up method of the unittest instance.
+    virtual void callSetUpSuite() = 0;
+    /// Call the suite tear-down method of the unittest instance.
+    virtual void callTearDownSuite() = 0;
     /// Test if this class is enabled.
     [[nodiscard]] virtual auto isEnabled() const -> bool = 0;
     /// Enable/disable all tests in this class.
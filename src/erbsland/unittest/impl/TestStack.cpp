@@ -0,0 +1,189 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "TestStack.hpp"
+
+#include "AssertContext.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef ERBSLAND_OS_WINDOWS
+#include <climits>
+#include <csignal>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace erbsland::unittest {
+
+namespace {
+
+/// The pattern that is painted on the unused stack.
+constexpr std::uint64_t cPaintPattern = 0x5354'4143'4B50'4149ULL;
+/// The size of the alternate signal stack for the test thread, so the crash handler can report a stack overflow.
+constexpr std::size_t cAlternateStackSize = 64 * 1024;
+
+/// The measured stack of a thread.
+struct StackInfo {
+    const std::uint64_t *begin{nullptr}; ///< The lowest address of the stack.
+    const std::uint64_t *top{nullptr};   ///< The address where the thread started to use the stack.
+};
+
+thread_local StackInfo gCurrentStack{}; ///< The measured stack of the calling thread.
+std::size_t gLastUsedBytes{0};          ///< The used bytes of the last function that was run.
+
+/// Measure the used bytes of a painted stack, from the deepest word that no longer contains the pattern.
+auto measureUsedBytes(const StackInfo &stack) noexcept -> std::size_t {
+    if (stack.begin == nullptr) {
+        return 0;
+    }
+    const auto *word = stack.begin;
+    while (word < stack.top && *word == cPaintPattern) {
+        ++word;
+    }
+    return static_cast<std::size_t>(stack.top - word) * sizeof(std::uint64_t);
+}
+
+#ifndef ERBSLAND_OS_WINDOWS
+
+/// The data that is passed to the test thread.
+struct ThreadData {
+    const std::function<void()> *function{nullptr}; ///< The function to run.
+    const std::uint64_t *stackBegin{nullptr};       ///< The lowest address of the painted stack.
+    void *alternateStack{nullptr};                  ///< The alternate signal stack.
+    std::exception_ptr exception{};                 ///< An exception thrown by the function.
+    std::size_t usedBytes{0};                       ///< The measured stack usage.
+};
+
+/// The main function of the test thread.
+auto threadMain(void *argument) -> void * {
+    auto &data = *static_cast<ThreadData *>(argument);
+    // The crash handler runs on the alternate stack, because the stack of this thread is exhausted on an overflow.
+    stack_t alternateStack{};
+    alternateStack.ss_sp = data.alternateStack;
+    alternateStack.ss_size = cAlternateStackSize;
+    alternateStack.ss_flags = 0;
+    (void)::sigaltstack(&alternateStack, nullptr);
+    // The thread library keeps its own data at the top of the stack, so the measurement starts in this frame.
+    std::uint64_t frameMarker = 0;
+    gCurrentStack = StackInfo{.begin = data.stackBegin, .top = &frameMarker};
+    try {
+        (*data.function)();
+    } catch (...) {
+        data.exception = std::current_exception();
+    }
+    data.usedBytes = measureUsedBytes(gCurrentStack);
+    gCurrentStack = {};
+    alternateStack.ss_flags = SS_DISABLE;
+    (void)::sigaltstack(&alternateStack, nullptr);
+    return nullptr;
+}
+
+#endif
+
+}
+
+auto TestStack::isSupported() noexcept -> bool {
+#ifdef ERBSLAND_OS_WINDOWS
+    return false;
+#else
+    return true;
+#endif
+}
+
+auto TestStack::effectiveSize(const std::size_t requestedSize) noexcept -> std::size_t {
+#ifdef ERBSLAND_OS_WINDOWS
+    return requestedSize;
+#else
+    const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto size = std::max(requestedSize, static_cast<std::size_t>(PTHREAD_STACK_MIN));
+    return (size + pageSize - 1) / pageSize * pageSize;
+#endif
+}
+
+void TestStack::run(const std::size_t stackSize, const std::function<void()> &function) {
+    gLastUsedBytes = 0;
+#ifdef ERBSLAND_OS_WINDOWS
+    (void)stackSize;
+    (void)function;
+    throw std::logic_error("Dedicated test stacks are not supported on this platform.");
+#else
+    // The mapping contains the alternate signal stack, a guard page and the stack, that grows down to the guard page.
+    const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto size = effectiveSize(stackSize);
+    const auto mappingSize = cAlternateStackSize + pageSize + size;
+    auto *mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "Could not allocate the stack for the test");
+    }
+    auto *bytes = static_cast<char *>(mapping);
+    (void)::mprotect(bytes + cAlternateStackSize, pageSize, PROT_NONE);
+    auto *stackBegin = reinterpret_cast<std::uint64_t *>(bytes + cAlternateStackSize + pageSize);
+    std::fill_n(stackBegin, size / sizeof(std::uint64_t), cPaintPattern);
+    ThreadData data{.function = &function, .stackBegin = stackBegin, .alternateStack = mapping};
+    pthread_attr_t attributes{};
+    pthread_attr_init(&attributes);
+    auto error = pthread_attr_setstack(&attributes, stackBegin, size);
+    pthread_t thread{};
+    if (error == 0) {
+        error = pthread_create(&thread, &attributes, threadMain, &data);
+    }
+    pthread_attr_destroy(&attributes);
+    if (error != 0) {
+        ::munmap(mapping, mappingSize);
+        throw std::system_error(error, std::generic_category(), "Could not start the thread for the test");
+    }
+    pthread_join(thread, nullptr);
+    ::munmap(mapping, mappingSize);
+    gLastUsedBytes = data.usedBytes;
+    if (data.exception != nullptr) {
+        std::rethrow_exception(data.exception);
+    }
+#endif
+}
+
+auto TestStack::lastUsedBytes() noexcept -> std::size_t {
+    return gLastUsedBytes;
+}
+
+auto TestStack::isActive() noexcept -> bool {
+    return gCurrentStack.begin != nullptr;
+}
+
+auto TestStack::usedBytes() noexcept -> std::size_t {
+    return measureUsedBytes(gCurrentStack);
+}
+
+void requireMaxStack(UnitTest *test,
+    const int flags,
+    const char *macroName,
+    const char *expr,
+    const SourceLocation loc,
+    const std::size_t maximumBytes) {
+
+    AssertContext ctx{test, flags, macroName, expr, loc};
+    ctx.exceptionType = "requireComparison";
+    if (!TestStack::isActive()) {
+        ctx.exceptionMessage = TestStack::isSupported()
+            ? "The test does not run on a dedicated stack. Set a stack size with STACK_SIZE() or --stack-size."
+            : "Dedicated test stacks are not supported on this platform.";
+        ctx.unexpectedResult();
+        return;
+    }
+    const auto usedBytes = TestStack::usedBytes();
+    if (usedBytes > maximumBytes) {
+        ctx.exceptionMessage =
+            std::format("The test used {} bytes of its stack, but the maximum is {} bytes.", usedBytes, maximumBytes);
+        ctx.unexpectedResult();
+        return;
+    }
+    ctx.expectedResult();
+}
+
+}
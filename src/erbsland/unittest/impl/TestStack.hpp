@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "Definitions.hpp"
+#include "SourceLocation.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace erbsland::unittest {
+
+class UnitTest;
+
+/// @internal
+/// Runs tests on a dedicated thread with a fixed stack size, and measures the used stack.
+///
+/// The stack is painted with a pattern before the thread starts. The used size is the distance from the start of
+/// the thread to the deepest word that no longer contains the pattern. A guard page below the stack turns an
+/// overflow into a crash, that is reported by the crash handler. An alternate signal stack only applies to the
+/// thread that installs it, so the test thread installs its own while it runs.
+///
+class TestStack {
+public:
+    /// Test if dedicated test stacks are supported on this platform.
+    [[nodiscard]] static auto isSupported() noexcept -> bool;
+    /// The size of the stack, that is used for the requested size.
+    /// The size is at least the minimum size for threads, and rounded up to a full page.
+    [[nodiscard]] static auto effectiveSize(std::size_t requestedSize) noexcept -> std::size_t;
+    /// Run a function on a new thread with the given stack size, and wait until it finished.
+    /// Exceptions thrown by the function are rethrown in the calling thread.
+    /// @param stackSize The requested size of the stack.
+    /// @param function The function to run.
+    static void run(std::size_t stackSize, const std::function<void()> &function);
+    /// The number of stack bytes used by the last function that was run.
+    [[nodiscard]] static auto lastUsedBytes() noexcept -> std::size_t;
+    /// Test if the calling thread runs on a measured stack.
+    [[nodiscard]] static auto isActive() noexcept -> bool;
+    /// The number of bytes used so far on the stack of the calling thread, or zero if it is not measured.
+    [[nodiscard]] static auto usedBytes() noexcept -> std::size_t;
+};
+
+/// Verifies that the current test did not use more than the given number of bytes of its stack.
+///
+/// The test must run on a dedicated stack, that is set with `STACK_SIZE()` or the `--stack-size` option.
+///
+/// @param test The UnitTest instance in which this check is running.
+/// @param flags Flags that modify assertion behavior.
+/// @param macroName The name of the macro that invoked this check (e.g. "REQUIRE_MAX_STACK").
+/// @param expr The textual representation of the maximum size.
+/// @param loc The source location where the check was invoked.
+/// @param maximumBytes The maximum number of stack bytes, the test may have used.
+void requireMaxStack(
+    UnitTest *test, int flags, const char *macroName, const char *expr, SourceLocation loc, std::size_t maximumBytes);
+
+}
@@ -2,28 +2,21 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "TextHelperImpl.hpp"
 
+#include "Utf8Scan.hpp"
+
 #include "../TextHelper.hpp"
 
-#include <exception>
+#include <format>
 
 namespace erbsland::unittest::th::impl {
 
 constexpr auto cReplacementCharacter = char32_t{0xFFFD};
-
-class Utf8DecodeError final : public std::exception {
-public:
-    Utf8DecodeError(std::size_t byteIndex, std::string message) : _byteIndex{byteIndex}, _message{std::move(message)} {}
-
-    [[nodiscard]] auto byteIndex() const noexcept -> std::size_t { return _byteIndex; }
-
-    [[nodiscard]] auto message() const noexcept -> const std::string & { return _message; }
-
-    [[nodiscard]] auto what() const noexcept -> const char * override { return _message.c_str(); }
-
-private:
-    std::size_t _byteIndex;
-    std::string _message;
-};
+/// The number of unchanged lines shown before and after each change of a line diff.
+constexpr auto cLineDiffContext = std::size_t{3};
+/// The maximum number of lines in the hunks of a line diff.
+constexpr auto cLineDiffMaximumLines = std::size_t{200};
+/// The maximum length of a single line in a line diff.
+constexpr auto cLineDiffMaximumLineLength = std::size_t{200};
 
 auto hexDigitValue(const char digit) -> int {
     if (digit >= '0' && digit <= '9') {
@@ -59,74 +52,6 @@ auto appendUtf8FromCodePoint(std::string &result, char32_t codePoint) -> void {
     }
 }
 
-auto decodeUtf8CodePoint(const std::string_view text, std::size_t &byteIndex) -> char32_t {
-    const auto leadByte = static_cast<uint8_t>(text.at(byteIndex));
-    if (leadByte < 0x80U) {
-        ++byteIndex;
-        return leadByte;
-    }
-    if (leadByte < 0xC0U) {
-        throw Utf8DecodeError{byteIndex, "unexpected continuation byte"};
-    }
-    if (leadByte < 0xC2U) {
-        throw Utf8DecodeError{byteIndex, "overlong UTF-8 start byte"};
-    }
-    if (leadByte < 0xE0U) {
-        const auto byteCount = std::size_t{2};
-        if (byteIndex + byteCount > text.size()) {
-            throw Utf8DecodeError{byteIndex, "truncated 2-byte UTF-8 sequence"};
-        }
-        const auto byte1 = static_cast<uint8_t>(text.at(byteIndex + 1));
-        if ((byte1 & 0xC0U) != 0x80U) {
-            throw Utf8DecodeError{byteIndex, "invalid continuation byte in 2-byte UTF-8 sequence"};
-        }
-        byteIndex += byteCount;
-        return (static_cast<char32_t>(leadByte & 0x1FU) << 6) | static_cast<char32_t>(byte1 & 0x3FU);
-    }
-    if (leadByte < 0xF0U) {
-        const auto byteCount = std::size_t{3};
-        if (byteIndex + byteCount > text.size()) {
-            throw Utf8DecodeError{byteIndex, "truncated 3-byte UTF-8 sequence"};
-        }
-        const auto byte1 = static_cast<uint8_t>(text.at(byteIndex + 1));
-        const auto byte2 = static_cast<uint8_t>(text.at(byteIndex + 2));
-        if ((byte1 & 0xC0U) != 0x80U || (byte2 & 0xC0U) != 0x80U) {
-            throw Utf8DecodeError{byteIndex, "invalid continuation byte in 3-byte UTF-8 sequence"};
-        }
-        if (leadByte == 0xE0U && byte1 < 0xA0U) {
-            throw Utf8DecodeError{byteIndex, "overlong 3-byte UTF-8 sequence"};
-        }
-        if (leadByte == 0xEDU && byte1 >= 0xA0U) {
-            throw Utf8DecodeError{byteIndex, "UTF-8 sequence encodes a surrogate code point"};
-        }
-        byteIndex += byteCount;
-        return (static_cast<char32_t>(leadByte & 0x0FU) << 12) | (static_cast<char32_t>(byte1 & 0x3FU) << 6) |
-            static_cast<char32_t>(byte2 & 0x3FU);
-    }
-    if (leadByte < 0xF5U) {
-        const auto byteCount = std::size_t{4};
-        if (byteIndex + byteCount > text.size()) {
-            throw Utf8DecodeError{byteIndex, "truncated 4-byte UTF-8 sequence"};
-        }
-        const auto byte1 = static_cast<uint8_t>(text.at(byteIndex + 1));
-        const auto byte2 = static_cast<uint8_t>(text.at(byteIndex + 2));
-        const auto byte3 = static_cast<uint8_t>(text.at(byteIndex + 3));
-        if ((byte1 & 0xC0U) != 0x80U || (byte2 & 0xC0U) != 0x80U || (byte3 & 0xC0U) != 0x80U) {
-            throw Utf8DecodeError{byteIndex, "invalid continuation byte in 4-byte UTF-8 sequence"};
-        }
-        if (leadByte == 0xF0U && byte1 < 0x90U) {
-            throw Utf8DecodeError{byteIndex, "overlong 4-byte UTF-8 sequence"};
-        }
-        if (leadByte == 0xF4U && byte1 >= 0x90U) {
-            throw Utf8DecodeError{byteIndex, "UTF-8 sequence encodes a code point beyond U+10FFFF"};
-        }
-        byteIndex += byteCount;
-        return (static_cast<char32_t>(leadByte & 0x07U) << 18) | (static_cast<char32_t>(byte1 & 0x3FU) << 12) |
-            (static_cast<char32_t>(byte2 & 0x3FU) << 6) | static_cast<char32_t>(byte3 & 0x3FU);
-    }
-    throw Utf8DecodeError{byteIndex, "invalid UTF-8 start byte"};
-}
-
 auto toStdString(const std::string_view str) -> std::string {
     return std::string{str};
 }
@@ -190,9 +115,10 @@ auto toStdU32String(const std::string_view str) -> std::u32string {
     auto result = std::u32string{};
     result.reserve(str.size());
     for (std::size_t byteIndex = 0; byteIndex < str.size();) {
-        try {
-            result.push_back(decodeUtf8CodePoint(str, byteIndex));
-        } catch (const Utf8DecodeError &) {
+        char32_t codePoint = 0;
+        if (!utf8Decode(str, byteIndex, codePoint).has_value()) {
+            result.push_back(codePoint);
+        } else {
             result.push_back(cReplacementCharacter);
             ++byteIndex;
         }
@@ -245,12 +171,9 @@ auto toStdU32String(std::wstring_view str) -> std::u32string {
 }
 
 auto validateUtf8(std::string_view str) -> Utf8ValidationResult {
-    for (std::size_t byteIndex = 0; byteIndex < str.size();) {
-        try {
-            static_cast<void>(decodeUtf8CodePoint(str, byteIndex));
-        } catch (const Utf8DecodeError &error) {
-            return Utf8ValidationResult{false, error.byteIndex(), error.message()};
-        }
+    const auto result = utf8Validate(str);
+    if (result.error.has_value()) {
+        return Utf8ValidationResult{false, result.byteIndex, std::string{utf8ErrorText(*result.error)}};
     }
     return Utf8ValidationResult{true};
 }
@@ -260,11 +183,11 @@ auto validateUtf8(std::u8string_view str) -> Utf8ValidationResult {
 }
 
 auto characterCount(const std::string_view str) noexcept -> std::size_t {
-    return ConsoleLine::utf8Length(str);
+    return utf8CharacterCount(str);
 }
 
 auto characterCount(const std::u8string_view str) noexcept -> std::size_t {
-    return ConsoleLine::utf8Length({reinterpret_cast<const char *>(str.data()), str.size()});
+    return utf8CharacterCount({reinterpret_cast<const char *>(str.data()), str.size()});
 }
 
 auto characterCount(std::u16string_view str) noexcept -> std::size_t {
@@ -298,4 +221,144 @@ auto characterCount(std::wstring_view str) noexcept -> std::size_t {
     }
 }
 
+auto lineByLineDiff(
+    const std::size_t expectedSize, const std::size_t actualSize, const std::function<bool(std::size_t)> &isEqual)
+    -> std::vector<DiffRange> {
+
+    std::vector<DiffRange> result;
+    auto addRange = [&result](const DiffOperation operation, const std::size_t index, const std::size_t count) {
+        if (!result.empty() && result.back().operation == operation && operation == DiffOperation::Equal) {
+            result.back().count += count;
+        } else {
+            result.push_back(DiffRange{.operation = operation, .indexA = index, .indexB = index, .count = count});
+        }
+    };
+    const auto comparedSize = std::min(expectedSize, actualSize);
+    for (std::size_t index = 0; index < comparedSize; ++index) {
+        if (isEqual(index)) {
+            addRange(DiffOperation::Equal, index, 1);
+        } else {
+            addRange(DiffOperation::Delete, index, 1);
+            addRange(DiffOperation::Insert, index, 1);
+        }
+    }
+    if (expectedSize > comparedSize) {
+        addRange(DiffOperation::Delete, comparedSize, expectedSize - comparedSize);
+    }
+    if (actualSize > comparedSize) {
+        addRange(DiffOperation::Insert, comparedSize, actualSize - comparedSize);
+    }
+    return result;
+}
+
+auto formatLineDiff(const std::vector<DiffRange> &ranges,
+    const std::size_t expectedSize,
+    const std::size_t actualSize,
+    const bool isLineByLine,
+    const std::function<std::string(std::size_t)> &expectedLine,
+    const std::function<std::string(std::size_t)> &actualLine) -> std::string {
+
+    std::size_t removedCount = 0;
+    std::size_t addedCount = 0;
+    for (const auto &range : ranges) {
+        if (range.operation == DiffOperation::Delete) {
+            removedCount += range.count;
+        } else if (range.operation == DiffOperation::Insert) {
+            addedCount += range.count;
+        }
+    }
+    auto lineCount = [](const std::size_t count) -> std::string {
+        return std::format("{} line{}", count, count == 1 ? "" : "s");
+    };
+    std::string message = std::format("Line diff (- expected, + actual): {} removed, {} added.\n",
+        lineCount(removedCount),
+        lineCount(addedCount));
+    if (isLineByLine) {
+        message += "The lines differ too much for a line diff, they are compared line by line.\n";
+    }
+    message += std::format("--- expected ({})\n+++ actual ({})\n", lineCount(expectedSize), lineCount(actualSize));
+    std::size_t writtenLines = 0;
+    auto addLine = [&](const char marker, const std::string &line) -> bool {
+        if (writtenLines >= cLineDiffMaximumLines) {
+            return false;
+        }
+        message += marker;
+        message += ' ';
+        // Cut long lines at the start of a UTF-8 sequence.
+        std::size_t characterCount = 0;
+        std::size_t byteIndex = 0;
+        for (; byteIndex < line.size(); ++byteIndex) {
+            const auto isStartByte = (static_cast<uint8_t>(line[byteIndex]) & 0xC0U) != 0x80U;
+            if (isStartByte && ++characterCount > cLineDiffMaximumLineLength) {
+                break;
+            }
+        }
+        message += ConsoleLine::utf8RemoveControlCharacters(std::string_view{line}.substr(0, byteIndex));
+        if (byteIndex < line.size()) {
+            message += "(...)";
+        }
+        message += '\n';
+        ++writtenLines;
+        return true;
+    };
+    // Changes that are separated by up to twice the context lines are joined into one hunk.
+    std::size_t index = 0;
+    bool isTruncated = false;
+    while (index < ranges.size() && !isTruncated) {
+        if (ranges[index].operation == DiffOperation::Equal) {
+            ++index;
+            continue;
+        }
+        const auto first = index;
+        auto last = index;
+        for (auto next = index + 1; next < ranges.size(); ++next) {
+            if (ranges[next].operation != DiffOperation::Equal) {
+                last = next;
+            } else if (ranges[next].count > 2 * cLineDiffContext || next + 1 == ranges.size()) {
+                break;
+            }
+        }
+        const auto leading = first > 0 ? std::min(cLineDiffContext, ranges[first - 1].count) : std::size_t{0};
+        const auto trailing =
+            last + 1 < ranges.size() ? std::min(cLineDiffContext, ranges[last + 1].count) : std::size_t{0};
+        auto startExpected = ranges[first].indexA - leading;
+        auto startActual = ranges[first].indexB - leading;
+        std::size_t expectedCount = leading + trailing;
+        std::size_t actualCount = leading + trailing;
+        for (auto i = first; i <= last; ++i) {
+            if (ranges[i].operation != DiffOperation::Insert) {
+                expectedCount += ranges[i].count;
+            }
+            if (ranges[i].operation != DiffOperation::Delete) {
+                actualCount += ranges[i].count;
+            }
+        }
+        message += std::format(
+            "@@ -{},{} +{},{} @@\n", startExpected + 1, expectedCount, startActual + 1, actualCount);
+        for (std::size_t i = 0; i < leading && !isTruncated; ++i) {
+            isTruncated = !addLine(' ', actualLine(startActual + i));
+        }
+        for (auto i = first; i <= last && !isTruncated; ++i) {
+            const auto &range = ranges[i];
+            for (std::size_t j = 0; j < range.count && !isTruncated; ++j) {
+                if (range.operation == DiffOperation::Delete) {
+                    isTruncated = !addLine('-', expectedLine(range.indexA + j));
+                } else if (range.operation == DiffOperation::Insert) {
+                    isTruncated = !addLine('+', actualLine(range.indexB + j));
+                } else {
+                    isTruncated = !addLine(' ', actualLine(range.indexB + j));
+                }
+            }
+        }
+        for (std::size_t i = 0; i < trailing && !isTruncated; ++i) {
+            isTruncated = !addLine(' ', actualLine(ranges[last + 1].indexB + i));
+        }
+        index = last + 1;
+    }
+    if (isTruncated) {
+        message += std::format("... the diff is truncated after {}.\n", lineCount(cLineDiffMaximumLines));
+    }
+    return message;
+}
+
 }
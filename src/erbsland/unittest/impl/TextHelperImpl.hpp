@@ -3,15 +3,20 @@
 #pragma once
 
 #include "ConsoleLine.hpp"
+#include "LineRange.hpp"
+#include "SequenceDiff.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <format>
+#include <functional>
 #include <ranges>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace erbsland::unittest::th::impl {
 
@@ -134,190 +139,283 @@ auto stringFromHex(const std::string_view hexString, const std::size_t hexDigits
 /// @overload
 [[nodiscard]] auto characterCount(std::wstring_view str) noexcept -> std::size_t;
 
-/// Create a padded string with spaces to reach a given width
-/// @param text The unpadded text.
-/// @param width The desired width of the padded string.
-/// @return The padded string.
-template <typename tStringView>
-    requires std::is_convertible_v<tStringView, std::string_view>
-static auto paddedString(const tStringView &text, std::size_t width) -> std::string {
-    const auto characterCount = ConsoleLine::utf8Length(text);
-    if (characterCount >= width) {
-        return std::string{text};
+/// Test if the pattern character at the given index escapes the next character.
+/// Only `\*` and `\?` are escape sequences. Any other backslash is a literal character.
+template <typename tChar>
+[[nodiscard]] constexpr auto isWildcardEscape(
+    const std::basic_string_view<tChar> pattern, const std::size_t index) noexcept -> bool {
+    if (pattern[index] != static_cast<tChar>('\\') || index + 1 >= pattern.size()) {
+        return false;
     }
-    std::string result;
-    result.reserve(text.size() + (width - characterCount) + 1);
-    result += text;
-    result += std::string(width - characterCount, ' ');
-    return result;
+    const auto next = pattern[index + 1];
+    return next == static_cast<tChar>('*') || next == static_cast<tChar>('?');
 }
 
-/// Compares a string and a pattern in reverse order, where the pattern may
-/// contain wildcard characters represented by '?'.
-///
-/// The comparison starts from the end of both the pattern and the string and
-/// progresses backward. A '?' in the pattern matches any single character
-/// in the string.
-///
-/// @param pattern The pattern string to match, which may contain '?' as wildcards.
-/// @param str The string to compare against the pattern.
-/// @return True if the pattern matches the string in reverse order (considering
-///         wildcards); otherwise, false.
-template <AnyStringOrStringView tStringView>
-[[nodiscard]] auto reverseCompareWithQuestionMark(const tStringView pattern, const tStringView str) -> bool {
-    auto strIt = str.rbegin();
-    auto patternIt = pattern.rbegin();
-    for (; strIt != str.rend() && patternIt != pattern.rend(); ++strIt, ++patternIt) {
-        if (*patternIt == static_cast<tStringView::value_type>('?')) {
+/// Find the next `*` or `?` wildcard in a pattern, skipping escaped characters.
+/// @param pattern The pattern.
+/// @param start The index where the search starts. It must not be inside an escape sequence.
+/// @param wildcard The wildcard character to find.
+/// @return The index of the wildcard, or `npos` if there is none.
+template <typename tChar>
+[[nodiscard]] constexpr auto findWildcard(
+    const std::basic_string_view<tChar> pattern, const std::size_t start, const char wildcard) noexcept
+    -> std::size_t {
+    for (auto index = start; index < pattern.size(); ++index) {
+        if (isWildcardEscape(pattern, index)) {
+            ++index;
+        } else if (pattern[index] == static_cast<tChar>(wildcard)) {
+            return index;
+        }
+    }
+    return std::basic_string_view<tChar>::npos;
+}
+
+/// Get the number of characters, that a part of a pattern without `*` wildcards matches.
+template <typename tChar>
+[[nodiscard]] constexpr auto wildcardSegmentLength(const std::basic_string_view<tChar> segment) noexcept
+    -> std::size_t {
+    std::size_t length = 0;
+    for (std::size_t index = 0; index < segment.size(); ++index, ++length) {
+        if (isWildcardEscape(segment, index)) {
+            ++index;
+        }
+    }
+    return length;
+}
+
+/// Test if a part of a pattern without `*` wildcards matches the text at the given position.
+/// The text must contain enough characters after the position.
+template <typename tChar>
+[[nodiscard]] constexpr auto wildcardSegmentMatchesAt(const std::basic_string_view<tChar> segment,
+    const std::basic_string_view<tChar> text,
+    std::size_t position) noexcept -> bool {
+    for (std::size_t index = 0; index < segment.size(); ++index, ++position) {
+        if (isWildcardEscape(segment, index)) {
+            ++index;
+        } else if (segment[index] == static_cast<tChar>('?')) {
             continue;
         }
-        if (*strIt != *patternIt) {
+        if (text[position] != segment[index]) {
             return false;
         }
     }
-    return patternIt == pattern.rend();
+    return true;
 }
 
-/// Compares a string and a pattern where the pattern may contain wildcard characters represented by '?'.
+/// The number of literal characters in a part of a pattern, for which the search table is kept on the stack.
+constexpr std::size_t cWildcardStackTableSize = 128;
+
+/// Find the first position in a range of the text, where a part of a pattern without `*` wildcards matches.
 ///
-/// The comparison starts from the start and progresses forward. A '?' in the pattern matches any single
-/// character in the string.
+/// Leading `?` wildcards only shift the match. The literal characters up to the next `?` are searched with the
+/// Knuth-Morris-Pratt algorithm, which reads each character of the range once. Between the partial matches, the
+/// first literal character is located using `find()`. If literal characters follow after this `?`, they are
+/// compared at each found position. Only these parts can take longer than linear time, up to the length of the
+/// range times the length of the part.
 ///
-/// @param pattern The pattern string to match, which may contain '?' as wildcards.
-/// @param str The string to compare against the pattern.
-/// @param fullMatch If true, the entire string must match the pattern; otherwise, a partial match is sufficient.
-/// @return True if the pattern matches the string; otherwise, false.
-template <AnyStringOrStringView tStringView>
-[[nodiscard]] auto compareWithQuestionMark(const tStringView pattern, const tStringView str, bool fullMatch) -> bool {
-    auto strIt = str.begin();
-    auto patternIt = pattern.begin();
-    for (; strIt != str.end() && patternIt != pattern.end(); ++strIt, ++patternIt) {
-        if (*patternIt == static_cast<tStringView::value_type>('?')) {
-            continue;
+/// The search table is kept on the stack, unless the literal characters are longer than
+/// `cWildcardStackTableSize`.
+///
+/// @return The position, or `npos` if the part does not match in the range.
+template <typename tChar>
+[[nodiscard]] auto wildcardSegmentFind(const std::basic_string_view<tChar> segment,
+    const std::size_t segmentLength,
+    const std::basic_string_view<tChar> text,
+    const std::size_t start,
+    const std::size_t end) -> std::size_t {
+    constexpr auto npos = std::basic_string_view<tChar>::npos;
+    if (segmentLength > end - start) {
+        return npos;
+    }
+    std::size_t leadingLength = 0;
+    while (leadingLength < segment.size() && segment[leadingLength] == static_cast<tChar>('?')) {
+        ++leadingLength;
+    }
+    auto literalEnd = findWildcard(segment, leadingLength, '?');
+    if (literalEnd == npos) {
+        literalEnd = segment.size();
+    }
+    const auto literalLength = wildcardSegmentLength(segment.substr(leadingLength, literalEnd - leadingLength));
+    if (literalLength == 0) {
+        return start;
+    }
+    // Copy the literal characters without the escapes, and build the table with the length of the longest
+    // proper prefix of the literal, that is also a suffix of its first `i + 1` characters.
+    std::array<tChar, cWildcardStackTableSize> stackLiteral;
+    std::array<std::size_t, cWildcardStackTableSize> stackTable;
+    std::vector<tChar> heapLiteral;
+    std::vector<std::size_t> heapTable;
+    auto *literal = stackLiteral.data();
+    auto *table = stackTable.data();
+    if (literalLength > cWildcardStackTableSize) {
+        heapLiteral.resize(literalLength);
+        heapTable.resize(literalLength);
+        literal = heapLiteral.data();
+        table = heapTable.data();
+    }
+    for (std::size_t index = leadingLength, i = 0; index < literalEnd; ++index, ++i) {
+        if (isWildcardEscape(segment, index)) {
+            ++index;
         }
-        if (*strIt != *patternIt) {
-            return false;
+        literal[i] = segment[index];
+    }
+    table[0] = 0;
+    for (std::size_t i = 1, length = 0; i < literalLength; ++i) {
+        while (length > 0 && literal[i] != literal[length]) {
+            length = table[length - 1];
+        }
+        if (literal[i] == literal[length]) {
+            ++length;
+        }
+        table[i] = length;
+    }
+    const auto rest = segment.substr(literalEnd);
+    const auto restLength = segmentLength - leadingLength - literalLength;
+    const bool hasLiteralRest = rest.find_first_not_of(static_cast<tChar>('?')) != npos;
+    const auto searchText = text.substr(0, end - restLength);
+    std::size_t matchLength = 0;
+    for (auto position = start + leadingLength; position < searchText.size(); ++position) {
+        if (matchLength == 0) {
+            // Skip to the next candidate with the fast search for a single character.
+            position = searchText.find(literal[0], position);
+            if (position == npos) {
+                return npos;
+            }
+        }
+        while (matchLength > 0 && text[position] != literal[matchLength]) {
+            matchLength = table[matchLength - 1];
         }
+        if (text[position] == literal[matchLength]) {
+            ++matchLength;
+        }
+        if (matchLength == literalLength) {
+            if (!hasLiteralRest || wildcardSegmentMatchesAt(rest, text, position + 1)) {
+                return position + 1 - literalLength - leadingLength;
+            }
+            matchLength = table[matchLength - 1];
+        }
+    }
+    return npos;
+}
+
+/// Match a text against a pattern with wildcards.
+///
+/// The pattern is split at the `*` wildcards. The first part must match the start and the last part the end of
+/// the text. The parts in between are searched in order, each at the first position where it matches. This
+/// leaves the most text for the following parts, so no backtracking is required.
+///
+/// @param pattern The pattern, where `*` matches any number of characters and `?` matches one character.
+///     Use `\*` and `\?` to match these characters literally.
+/// @param text The text to match.
+/// @return True if the pattern matches the whole text.
+template <typename tChar>
+[[nodiscard]] auto matchesWildcardPattern(
+    const std::basic_string_view<tChar> pattern, const std::basic_string_view<tChar> text) -> bool {
+    constexpr auto npos = std::basic_string_view<tChar>::npos;
+    const auto firstStar = findWildcard(pattern, 0, '*');
+    const auto head = pattern.substr(0, firstStar);
+    const auto headLength = wildcardSegmentLength(head);
+    if (firstStar == npos) {
+        return headLength == text.size() && wildcardSegmentMatchesAt(head, text, 0);
     }
-    if (fullMatch && strIt != str.end()) {
+    if (headLength > text.size() || !wildcardSegmentMatchesAt(head, text, 0)) {
         return false;
     }
-    if (patternIt != pattern.end()) {
+    auto lastStar = firstStar;
+    for (auto star = firstStar; star != npos; star = findWildcard(pattern, star + 1, '*')) {
+        lastStar = star;
+    }
+    const auto tail = pattern.substr(lastStar + 1);
+    const auto tailLength = wildcardSegmentLength(tail);
+    if (headLength + tailLength > text.size() || !wildcardSegmentMatchesAt(tail, text, text.size() - tailLength)) {
         return false;
     }
+    const auto end = text.size() - tailLength;
+    auto position = headLength;
+    for (auto star = firstStar; star != lastStar;) {
+        const auto nextStar = findWildcard(pattern, star + 1, '*');
+        const auto segment = pattern.substr(star + 1, nextStar - star - 1);
+        const auto segmentLength = wildcardSegmentLength(segment);
+        const auto found = wildcardSegmentFind(segment, segmentLength, text, position, end);
+        if (found == npos) {
+            return false;
+        }
+        position = found + segmentLength;
+        star = nextStar;
+    }
     return true;
 }
 
-/// Compare a pattern that contains a wildcard '*' or '?'.
-/// The pattern may contain *one* '*' or one or more '?' wildcards.
-/// @param pattern The pattern string to match. May contain *one* '*' or one or more '?' wildcards.
+/// Compare a string with a pattern, that contains `*` and `?` wildcards.
+/// @see matchesWildcardPattern()
+/// @param pattern The pattern string to match.
 /// @param str The string to compare against the pattern.
 /// @return True if the pattern matches the string; otherwise, false.
-template <AnyStringOrStringView tStringView>
-[[nodiscard]] auto compareWithStarAndQuestionMark(const tStringView pattern, const tStringView str) -> bool {
-    const auto pos = pattern.find(static_cast<tStringView::value_type>('*'));
-    if (pos == std::string_view::npos) {
-        return compareWithQuestionMark(pattern, str, true);
-    }
-    const auto prefix = pattern.substr(0, pos);
-    if (!compareWithQuestionMark(prefix, str, false)) {
-        return false;
-    }
-    const auto suffix = pattern.substr(pos + 1);
-    if (suffix.empty()) {
-        return true;
-    }
-    return reverseCompareWithQuestionMark(suffix, str);
+template <AnyStringOrStringView tPattern, AnyStringOrStringView tString>
+    requires std::same_as<typename tPattern::value_type, typename tString::value_type>
+[[nodiscard]] auto compareWithStarAndQuestionMark(const tPattern &pattern, const tString &str) -> bool {
+    using Char = typename tString::value_type;
+    return matchesWildcardPattern(std::basic_string_view<Char>{pattern}, std::basic_string_view<Char>{str});
 }
 
-/// Create a side-by-side comparison string from two line ranges.
-template <typename tActual, typename tExpected>
-auto createSideBySideComparison(const tActual &actual, const tExpected &expected) -> std::string {
-    // display a side-by-side comparison.
-    std::string message;
-    message.reserve(2048);
-    std::size_t actualWidth = 1;
-    if (actual.size() > 0) {
-        actualWidth =
-            characterCount(*std::max_element(actual.begin(), actual.end(), [](const auto &a, const auto &b) -> bool {
-                return characterCount(a) < characterCount(b);
-            }));
-    }
-    std::size_t expectedWidth = 1;
-    if (expected.size() > 0) {
-        expectedWidth = characterCount(*std::max_element(expected.begin(),
-            expected.end(),
-            [](const auto &a, const auto &b) -> bool { return characterCount(a) < characterCount(b); }));
-    }
-    const auto actualHeader = std::format("Actual ({})", actual.size());
-    const auto expectedHeader = std::format("Expected ({})", expected.size());
-    actualWidth = std::clamp(actualWidth, actualHeader.size(), std::size_t{200U});
-    expectedWidth = std::clamp(expectedWidth, expectedHeader.size(), std::size_t{200U});
-    message += std::string{"| "};
-    message += paddedString(actualHeader, actualWidth);
-    message += " |     | ";
-    message += paddedString(expectedHeader, expectedWidth);
-    message += " |\n";
-    message += std::string{"|-"};
-    message += std::string(actualWidth, '-');
-    message += "-|-----|-";
-    message += std::string(expectedWidth, '-');
-    message += "-|\n";
-    auto itActual = actual.begin();
-    auto itExpected = expected.begin();
-    while (itActual != actual.end() || itExpected != expected.end()) {
-        message += std::string{"| "};
-        if (itActual != actual.end()) {
-            message += paddedString(toStdString(*itActual), actualWidth);
-        } else {
-            message += paddedString(std::string{}, actualWidth);
-        }
+/// The limits for the line diff of `requireEqualLines()`.
+constexpr DiffLimits cLineDiffLimits{.maximumEdits = 1'000, .maximumComparisons = 5'000'000};
 
-        const auto areEqual = itActual != actual.end() && itExpected != expected.end() && *itActual == *itExpected;
-        if (areEqual) {
-            message += " | === | ";
-        } else {
-            message += " |  X  | ";
-        }
-        if (itExpected != expected.end()) {
-            message += paddedString(toStdString(*itExpected), expectedWidth);
-        } else {
-            message += paddedString(std::string{}, expectedWidth);
-        }
-        message += " |\n";
+/// Get the difference of two line ranges, by comparing the lines with the same index.
+/// This is the fallback, if two line ranges differ too much for a line diff.
+/// @param expectedSize The number of expected lines.
+/// @param actualSize The number of actual lines.
+/// @param isEqual A function, that tests if the lines at the given index match.
+/// @return The parts of the difference.
+auto lineByLineDiff(std::size_t expectedSize, std::size_t actualSize, const std::function<bool(std::size_t)> &isEqual)
+    -> std::vector<DiffRange>;
 
-        if (itActual != actual.end()) {
-            ++itActual;
-        }
-        if (itExpected != expected.end()) {
-            ++itExpected;
-        }
+/// Format the difference of two line ranges as unified diff, with a few lines of context around each change.
+/// @param ranges The parts of the difference, where `A` are the expected and `B` the actual lines.
+/// @param expectedSize The number of expected lines.
+/// @param actualSize The number of actual lines.
+/// @param isLineByLine If the lines were compared line by line, instead of using a line diff.
+/// @param expectedLine A function, that returns the expected line at the given index.
+/// @param actualLine A function, that returns the actual line at the given index.
+/// @return The formatted difference.
+auto formatLineDiff(const std::vector<DiffRange> &ranges,
+    std::size_t expectedSize,
+    std::size_t actualSize,
+    bool isLineByLine,
+    const std::function<std::string(std::size_t)> &expectedLine,
+    const std::function<std::string(std::size_t)> &actualLine) -> std::string;
+
+/// Create a unified diff from two line ranges.
+/// The expected lines can contain the wildcards of `compareWithStarAndQuestionMark()`.
+template <typename tActual, typename tExpected>
+auto createLineDiff(const tActual &actual, const tExpected &expected) -> std::string {
+    const auto actualSize = static_cast<std::size_t>(std::ranges::distance(actual));
+    const auto expectedSize = static_cast<std::size_t>(std::ranges::distance(expected));
+    const auto actualLine = indexedElements(actual);
+    const auto expectedLine = indexedElements(expected);
+    auto isEqual = [&](const std::size_t indexExpected, const std::size_t indexActual) -> bool {
+        return compareWithStarAndQuestionMark(expectedLine(indexExpected), actualLine(indexActual));
+    };
+    auto ranges = sequenceDiff(expectedSize, actualSize, isEqual, cLineDiffLimits);
+    const bool isLineByLine = !ranges.has_value();
+    if (isLineByLine) {
+        ranges = lineByLineDiff(
+            expectedSize, actualSize, [&](const std::size_t index) -> bool { return isEqual(index, index); });
     }
-    message += std::string{"|-"};
-    message += std::string(actualWidth, '-');
-    message += "-|-----|-";
-    message += std::string(expectedWidth, '-');
-    message += "-|\n";
-    return message;
+    return formatLineDiff(
+        *ranges,
+        expectedSize,
+        actualSize,
+        isLineByLine,
+        [&](const std::size_t index) -> std::string { return toStdString(expectedLine(index)); },
+        [&](const std::size_t index) -> std::string { return toStdString(actualLine(index)); });
 }
 
 template <AnyStringView tStringView>
 auto splitLineViews(const tStringView text) -> std::vector<tStringView> {
     auto result = std::vector<tStringView>{};
-    if (text.empty()) {
-        return result;
-    }
-    auto lineStart = std::size_t{0};
-    while (true) {
-        const auto nextLineBreak = text.find(static_cast<typename tStringView::value_type>('\n'), lineStart);
-        if (nextLineBreak == tStringView::npos) {
-            break;
-        }
-        result.push_back(text.substr(lineStart, nextLineBreak - lineStart));
-        lineStart = nextLineBreak + 1;
-    }
-    if (lineStart < text.size()) {
-        result.push_back(text.substr(lineStart));
+    for (const auto line : LineRange<typename tStringView::value_type>{text}) {
+        result.push_back(line);
     }
     return result;
 }
@@ -0,0 +1,452 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#include "Utf8Scan.hpp"
+
+#include "Definitions.hpp"
+
+#include "../TextHelper.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+// SSE2 is part of every x86-64 processor. AVX2 is detected at runtime, which needs the `target` attribute of
+// GCC and Clang. With MSVC, only the SSE2 implementation is used.
+#if defined(__x86_64__) && (defined(ERBSLAND_COMPILER_GCC) || defined(ERBSLAND_COMPILER_CLANG))
+#define ERBSLAND_UTF8_SSE2
+#define ERBSLAND_UTF8_AVX2
+#define ERBSLAND_UTF8_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(ERBSLAND_COMPILER_MSVC) && defined(_M_X64)
+#define ERBSLAND_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace erbsland::unittest::th::impl {
+
+namespace {
+
+/// Test if a byte is a UTF-8 continuation byte.
+constexpr auto isContinuation(const std::uint8_t byte) noexcept -> bool {
+    return (byte & 0xC0U) == 0x80U;
+}
+
+/// Get a byte of the text, without a bounds check.
+auto byteAt(const std::string_view text, const std::size_t index) noexcept -> std::uint8_t {
+    return static_cast<std::uint8_t>(text[index]);
+}
+
+/// Validate the text one code point at a time, starting at a character boundary.
+/// @tparam SkipAscii A callable `(text, index) -> std::size_t`, that returns the number of ASCII characters,
+///     that can be skipped at the given index.
+template <typename SkipAscii>
+auto validateFrom(const std::string_view text, std::size_t index, SkipAscii skipAscii) noexcept -> Utf8ScanResult {
+    char32_t codePoint = 0;
+    while (index < text.size()) {
+        index += skipAscii(text, index);
+        if (index >= text.size()) {
+            break;
+        }
+        if (const auto error = utf8Decode(text, index, codePoint); error.has_value()) {
+            return Utf8ScanResult{.error = error, .byteIndex = index};
+        }
+    }
+    return {};
+}
+
+/// Count the characters one byte at a time.
+auto countFrom(const std::string_view text, std::size_t index) noexcept -> std::size_t {
+    std::size_t count = 0;
+    for (; index < text.size(); ++index) {
+        count += isContinuation(byteAt(text, index)) ? 0U : 1U;
+    }
+    return count;
+}
+
+/// The mask for the highest bit of each byte in a 64-bit block.
+constexpr std::uint64_t cHighBits = 0x8080'8080'8080'8080ULL;
+
+/// Load eight bytes of the text.
+auto loadBlock64(const std::string_view text, const std::size_t index) noexcept -> std::uint64_t {
+    std::uint64_t block = 0;
+    std::memcpy(&block, text.data() + index, sizeof(block));
+    return block;
+}
+
+/// Skip blocks of eight ASCII characters.
+auto skipAsciiPortable(const std::string_view text, const std::size_t index) noexcept -> std::size_t {
+    std::size_t skipped = 0;
+    while (index + skipped + sizeof(std::uint64_t) <= text.size() &&
+           (loadBlock64(text, index + skipped) & cHighBits) == 0) {
+        skipped += sizeof(std::uint64_t);
+    }
+    return skipped;
+}
+
+/// Count the characters, eight bytes at a time.
+auto countPortable(const std::string_view text) noexcept -> std::size_t {
+    std::size_t count = 0;
+    std::size_t index = 0;
+    for (; index + sizeof(std::uint64_t) <= text.size(); index += sizeof(std::uint64_t)) {
+        const auto block = loadBlock64(text, index);
+        // A continuation byte has the highest bit set and the second-highest bit cleared.
+        const auto continuationBits = block & ~(block << 1U) & cHighBits;
+        count += sizeof(std::uint64_t) - static_cast<std::size_t>(std::popcount(continuationBits));
+    }
+    return count + countFrom(text, index);
+}
+
+#ifdef ERBSLAND_UTF8_SSE2
+
+/// Skip blocks of 16 ASCII characters.
+auto skipAsciiSse2(const std::string_view text, const std::size_t index) noexcept -> std::size_t {
+    std::size_t skipped = 0;
+    while (index + skipped + sizeof(__m128i) <= text.size()) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text.data() + index + skipped));
+        if (_mm_movemask_epi8(block) != 0) {
+            break;
+        }
+        skipped += sizeof(__m128i);
+    }
+    return skipped;
+}
+
+/// Count the characters, 16 bytes at a time.
+auto countSse2(const std::string_view text) noexcept -> std::size_t {
+    std::size_t count = 0;
+    std::size_t index = 0;
+    // As signed bytes, the continuation bytes 0x80-0xBF are the values below -64.
+    const auto limit = _mm_set1_epi8(-64);
+    for (; index + sizeof(__m128i) <= text.size(); index += sizeof(__m128i)) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text.data() + index));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(limit, block)));
+        count += sizeof(__m128i) - static_cast<std::size_t>(std::popcount(mask));
+    }
+    return count + countFrom(text, index);
+}
+
+#endif
+
+#ifdef ERBSLAND_UTF8_AVX2
+
+// The AVX2 validation uses the lookup algorithm by John Keiser and Daniel Lemire, from the paper
+// "Validating UTF-8 In Less Than One Instruction Per Byte". Each byte is classified by three table lookups, using
+// the high and low nibble of the previous byte and the high nibble of the current byte. The bits in the tables
+// stand for the error cases; an error is found if one bit is set in all three results.
+constexpr std::uint8_t cTooShort = 1U << 0U;         // 11______ 0_______ or 11______ 11______
+constexpr std::uint8_t cTooLong = 1U << 1U;          // 0_______ 10______
+constexpr std::uint8_t cOverlong3 = 1U << 2U;        // 11100000 100_____
+constexpr std::uint8_t cTooLarge = 1U << 3U;         // 11110100 1001____ and above
+constexpr std::uint8_t cSurrogate = 1U << 4U;        // 11101101 101_____
+constexpr std::uint8_t cOverlong2 = 1U << 5U;        // 1100000_ 10______
+constexpr std::uint8_t cTooLarge1000 = 1U << 6U;     // 11110101 1000____ and above
+constexpr std::uint8_t cOverlong4 = 1U << 6U;        // 11110000 1000____
+constexpr std::uint8_t cTwoContinuations = 1U << 7U; // 10______ 10______
+constexpr std::uint8_t cCarry = cTooShort | cTooLong | cTwoContinuations;
+
+constexpr std::array<std::uint8_t, 16> cByte1High{
+    cTooLong, cTooLong, cTooLong, cTooLong, cTooLong, cTooLong, cTooLong, cTooLong,
+    cTwoContinuations, cTwoContinuations, cTwoContinuations, cTwoContinuations,
+    cTooShort | cOverlong2,
+    cTooShort,
+    cTooShort | cOverlong3 | cSurrogate,
+    cTooShort | cTooLarge | cTooLarge1000 | cOverlong4};
+constexpr std::array<std::uint8_t, 16> cByte1Low{
+    cCarry | cOverlong3 | cOverlong2 | cOverlong4,
+    cCarry | cOverlong2,
+    cCarry,
+    cCarry,
+    cCarry | cTooLarge,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000 | cSurrogate,
+    cCarry | cTooLarge | cTooLarge1000,
+    cCarry | cTooLarge | cTooLarge1000};
+constexpr std::array<std::uint8_t, 16> cByte2High{
+    cTooShort, cTooShort, cTooShort, cTooShort, cTooShort, cTooShort, cTooShort, cTooShort,
+    cTooLong | cOverlong2 | cTwoContinuations | cOverlong3 | cTooLarge1000 | cOverlong4,
+    cTooLong | cOverlong2 | cTwoContinuations | cOverlong3 | cTooLarge,
+    cTooLong | cOverlong2 | cTwoContinuations | cSurrogate | cTooLarge,
+    cTooLong | cOverlong2 | cTwoContinuations | cSurrogate | cTooLarge,
+    cTooShort, cTooShort, cTooShort, cTooShort};
+/// The highest values of the last three bytes of a block, that do not start an incomplete sequence.
+constexpr auto cIncompleteLimits = [] {
+    std::array<std::uint8_t, 32> limits{};
+    limits.fill(0xFFU);
+    limits[29] = 0xF0U - 1U;
+    limits[30] = 0xE0U - 1U;
+    limits[31] = 0xC0U - 1U;
+    return limits;
+}();
+
+/// Load a table with 16 entries into both lanes of a register.
+ERBSLAND_UTF8_TARGET_AVX2 auto avx2Table(const std::array<std::uint8_t, 16> &table) noexcept -> __m256i {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table.data())));
+}
+
+/// Get the high nibble of each byte.
+ERBSLAND_UTF8_TARGET_AVX2 auto avx2HighNibbles(const __m256i value) noexcept -> __m256i {
+    return _mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F));
+}
+
+/// Get the bytes of the input, shifted by `count` bytes, with the end of the previous block in front.
+template <int count>
+ERBSLAND_UTF8_TARGET_AVX2 auto avx2Previous(const __m256i input, const __m256i previous) noexcept -> __m256i {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - count);
+}
+
+/// Get the error bits for a block with non-ASCII bytes.
+ERBSLAND_UTF8_TARGET_AVX2 auto avx2BlockErrors(const __m256i input, const __m256i previous) noexcept -> __m256i {
+    const auto previous1 = avx2Previous<1>(input, previous);
+    const auto byte1High = _mm256_shuffle_epi8(avx2Table(cByte1High), avx2HighNibbles(previous1));
+    const auto byte1Low =
+        _mm256_shuffle_epi8(avx2Table(cByte1Low), _mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)));
+    const auto byte2High = _mm256_shuffle_epi8(avx2Table(cByte2High), avx2HighNibbles(input));
+    const auto specialCases = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+    // The third and fourth bytes of a sequence must be continuation bytes, and only these.
+    const auto isThirdByte = _mm256_subs_epu8(avx2Previous<2>(input, previous), _mm256_set1_epi8(0xE0 - 0x80));
+    const auto isFourthByte =
+        _mm256_subs_epu8(avx2Previous<3>(input, previous), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const auto mustBeContinuation =
+        _mm256_and_si256(_mm256_or_si256(isThirdByte, isFourthByte), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(mustBeContinuation, specialCases);
+}
+
+/// Get the index of the last character boundary before a block, where the scalar validation can continue.
+auto restartIndex(const std::string_view text, const std::size_t blockStart) noexcept -> std::size_t {
+    auto index = blockStart;
+    for (int steps = 0; steps < 4 && index > 0; ++steps) {
+        --index;
+        if (!isContinuation(byteAt(text, index))) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+/// Validate the text, 32 bytes at a time.
+/// If a block contains an error, the scalar validation continues at the last character boundary before this
+/// block, to get the same error and location as the scalar implementation.
+ERBSLAND_UTF8_TARGET_AVX2 auto validateAvx2(const std::string_view text) noexcept -> Utf8ScanResult {
+    const auto incompleteLimits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cIncompleteLimits.data()));
+    auto previous = _mm256_setzero_si256();
+    std::size_t index = 0;
+    for (; index + sizeof(__m256i) <= text.size(); index += sizeof(__m256i)) {
+        const auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text.data() + index));
+        __m256i errors;
+        if (_mm256_movemask_epi8(input) == 0) {
+            // An ASCII block is only an error, if the previous block ends in an incomplete sequence.
+            errors = _mm256_subs_epu8(previous, incompleteLimits);
+        } else {
+            errors = avx2BlockErrors(input, previous);
+        }
+        if (_mm256_testz_si256(errors, errors) == 0) {
+            break;
+        }
+        previous = input;
+    }
+    return validateFrom(text, restartIndex(text, index), skipAsciiSse2);
+}
+
+/// Count the characters, 32 bytes at a time.
+ERBSLAND_UTF8_TARGET_AVX2 auto countAvx2(const std::string_view text) noexcept -> std::size_t {
+    std::size_t count = 0;
+    std::size_t index = 0;
+    const auto limit = _mm256_set1_epi8(-64);
+    for (; index + sizeof(__m256i) <= text.size(); index += sizeof(__m256i)) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text.data() + index));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, block)));
+        count += sizeof(__m256i) - static_cast<std::size_t>(std::popcount(mask));
+    }
+    return count + countFrom(text, index);
+}
+
+#endif
+
+/// Get the mode that is used for a requested mode.
+auto effectiveMode(const Utf8ScanMode mode) noexcept -> Utf8ScanMode {
+    return utf8IsScanModeSupported(mode) ? mode : Utf8ScanMode::Portable;
+}
+
+}
+
+auto utf8ErrorText(const Utf8Error error) noexcept -> std::string_view {
+    switch (error) {
+    case Utf8Error::UnexpectedContinuationByte:
+        return "unexpected continuation byte";
+    case Utf8Error::Overlong2ByteSequence:
+        return "overlong UTF-8 start byte";
+    case Utf8Error::InvalidStartByte:
+        return "invalid UTF-8 start byte";
+    case Utf8Error::Truncated2ByteSequence:
+        return "truncated 2-byte UTF-8 sequence";
+    case Utf8Error::Truncated3ByteSequence:
+        return "truncated 3-byte UTF-8 sequence";
+    case Utf8Error::Truncated4ByteSequence:
+        return "truncated 4-byte UTF-8 sequence";
+    case Utf8Error::InvalidContinuationByteIn2ByteSequence:
+        return "invalid continuation byte in 2-byte UTF-8 sequence";
+    case Utf8Error::InvalidContinuationByteIn3ByteSequence:
+        return "invalid continuation byte in 3-byte UTF-8 sequence";
+    case Utf8Error::InvalidContinuationByteIn4ByteSequence:
+        return "invalid continuation byte in 4-byte UTF-8 sequence";
+    case Utf8Error::Overlong3ByteSequence:
+        return "overlong 3-byte UTF-8 sequence";
+    case Utf8Error::Overlong4ByteSequence:
+        return "overlong 4-byte UTF-8 sequence";
+    case Utf8Error::SurrogateCodePoint:
+        return "UTF-8 sequence encodes a surrogate code point";
+    case Utf8Error::CodePointBeyondUnicodeRange:
+        return "UTF-8 sequence encodes a code point beyond U+10FFFF";
+    default:
+        return {};
+    }
+}
+
+auto utf8Decode(const std::string_view text, std::size_t &byteIndex, char32_t &codePoint) noexcept
+    -> std::optional<Utf8Error> {
+    const auto leadByte = byteAt(text, byteIndex);
+    if (leadByte < 0x80U) {
+        ++byteIndex;
+        codePoint = leadByte;
+        return std::nullopt;
+    }
+    if (leadByte < 0xC0U) {
+        return Utf8Error::UnexpectedContinuationByte;
+    }
+    if (leadByte < 0xC2U) {
+        return Utf8Error::Overlong2ByteSequence;
+    }
+    if (leadByte < 0xE0U) {
+        if (byteIndex + 2 > text.size()) {
+            return Utf8Error::Truncated2ByteSequence;
+        }
+        const auto byte1 = byteAt(text, byteIndex + 1);
+        if (!isContinuation(byte1)) {
+            return Utf8Error::InvalidContinuationByteIn2ByteSequence;
+        }
+        byteIndex += 2;
+        codePoint = (static_cast<char32_t>(leadByte & 0x1FU) << 6) | static_cast<char32_t>(byte1 & 0x3FU);
+        return std::nullopt;
+    }
+    if (leadByte < 0xF0U) {
+        if (byteIndex + 3 > text.size()) {
+            return Utf8Error::Truncated3ByteSequence;
+        }
+        const auto byte1 = byteAt(text, byteIndex + 1);
+        const auto byte2 = byteAt(text, byteIndex + 2);
+        if (!isContinuation(byte1) || !isContinuation(byte2)) {
+            return Utf8Error::InvalidContinuationByteIn3ByteSequence;
+        }
+        if (leadByte == 0xE0U && byte1 < 0xA0U) {
+            return Utf8Error::Overlong3ByteSequence;
+        }
+        if (leadByte == 0xEDU && byte1 >= 0xA0U) {
+            return Utf8Error::SurrogateCodePoint;
+        }
+        byteIndex += 3;
+        codePoint = (static_cast<char32_t>(leadByte & 0x0FU) << 12) | (static_cast<char32_t>(byte1 & 0x3FU) << 6) |
+            static_cast<char32_t>(byte2 & 0x3FU);
+        return std::nullopt;
+    }
+    if (leadByte < 0xF5U) {
+        if (byteIndex + 4 > text.size()) {
+            return Utf8Error::Truncated4ByteSequence;
+        }
+        const auto byte1 = byteAt(text, byteIndex + 1);
+        const auto byte2 = byteAt(text, byteIndex + 2);
+        const auto byte3 = byteAt(text, byteIndex + 3);
+        if (!isContinuation(byte1) || !isContinuation(byte2) || !isContinuation(byte3)) {
+            return Utf8Error::InvalidContinuationByteIn4ByteSequence;
+        }
+        if (leadByte == 0xF0U && byte1 < 0x90U) {
+            return Utf8Error::Overlong4ByteSequence;
+        }
+        if (leadByte == 0xF4U && byte1 >= 0x90U) {
+            return Utf8Error::CodePointBeyondUnicodeRange;
+        }
+        byteIndex += 4;
+        codePoint = (static_cast<char32_t>(leadByte & 0x07U) << 18) | (static_cast<char32_t>(byte1 & 0x3FU) << 12) |
+            (static_cast<char32_t>(byte2 & 0x3FU) << 6) | static_cast<char32_t>(byte3 & 0x3FU);
+        return std::nullopt;
+    }
+    return Utf8Error::InvalidStartByte;
+}
+
+auto utf8BestScanMode() noexcept -> Utf8ScanMode {
+    static const auto bestMode = [] {
+        if (utf8IsScanModeSupported(Utf8ScanMode::Avx2)) {
+            return Utf8ScanMode::Avx2;
+        }
+        if (utf8IsScanModeSupported(Utf8ScanMode::Sse2)) {
+            return Utf8ScanMode::Sse2;
+        }
+        return Utf8ScanMode::Portable;
+    }();
+    return bestMode;
+}
+
+auto utf8IsScanModeSupported(const Utf8ScanMode mode) noexcept -> bool {
+    switch (mode) {
+    case Utf8ScanMode::Scalar:
+    case Utf8ScanMode::Portable:
+        return true;
+    case Utf8ScanMode::Sse2:
+#ifdef ERBSLAND_UTF8_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case Utf8ScanMode::Avx2:
+#ifdef ERBSLAND_UTF8_AVX2
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+auto utf8Validate(const std::string_view text, const Utf8ScanMode mode) noexcept -> Utf8ScanResult {
+    switch (effectiveMode(mode)) {
+    case Utf8ScanMode::Scalar:
+        return validateFrom(text, 0, [](std::string_view, std::size_t) -> std::size_t { return 0; });
+#ifdef ERBSLAND_UTF8_SSE2
+    case Utf8ScanMode::Sse2:
+        return validateFrom(text, 0, skipAsciiSse2);
+#endif
+#ifdef ERBSLAND_UTF8_AVX2
+    case Utf8ScanMode::Avx2:
+        return validateAvx2(text);
+#endif
+    default:
+        return validateFrom(text, 0, skipAsciiPortable);
+    }
+}
+
+auto utf8CharacterCount(const std::string_view text, const Utf8ScanMode mode) noexcept -> std::size_t {
+    switch (effectiveMode(mode)) {
+    case Utf8ScanMode::Scalar:
+        return countFrom(text, 0);
+#ifdef ERBSLAND_UTF8_SSE2
+    case Utf8ScanMode::Sse2:
+        return countSse2(text);
+#endif
+#ifdef ERBSLAND_UTF8_AVX2
+    case Utf8ScanMode::Avx2:
+        return countAvx2(text);
+#endif
+    default:
+        return countPortable(text);
+    }
+}
+
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace erbsland::unittest::th {
+enum class Utf8Error : uint8_t; // Declared in `TextHelper.hpp`.
+}
+
+namespace erbsland::unittest::th::impl {
+
+/// @internal
+/// The implementation that is used to scan UTF-8 text.
+enum class Utf8ScanMode : std::uint8_t {
+    Scalar,   ///< Decode one code point at a time. This is the reference for all other modes.
+    Portable, ///< Skip blocks of 8 ASCII characters, using 64-bit integers.
+    Sse2,     ///< Skip blocks of 16 ASCII characters, using SSE2.
+    Avx2,     ///< Validate blocks of 32 bytes, using AVX2.
+};
+
+/// @internal
+/// The result of a UTF-8 validation.
+struct Utf8ScanResult {
+    std::optional<Utf8Error> error;  ///< The reason for the first invalid sequence, or no value for valid text.
+    std::size_t byteIndex{0};        ///< The index of the start byte of the first invalid sequence.
+};
+
+/// Get the error message for a UTF-8 error.
+/// @param error The error.
+/// @return The message.
+[[nodiscard]] auto utf8ErrorText(Utf8Error error) noexcept -> std::string_view;
+
+/// Decode one code point from UTF-8 text.
+/// @param text The text.
+/// @param byteIndex The index of the first byte of the code point. It is moved after the decoded code point, and
+///     kept unchanged if the sequence is invalid.
+/// @param codePoint Receives the decoded code point.
+/// @return The reason if the sequence is invalid, or no value if a code point was decoded.
+[[nodiscard]] auto utf8Decode(std::string_view text, std::size_t &byteIndex, char32_t &codePoint) noexcept
+    -> std::optional<Utf8Error>;
+
+/// Get the fastest scan mode that is supported by this processor.
+[[nodiscard]] auto utf8BestScanMode() noexcept -> Utf8ScanMode;
+
+/// Test if a scan mode is supported by this processor.
+[[nodiscard]] auto utf8IsScanModeSupported(Utf8ScanMode mode) noexcept -> bool;
+
+/// Validate UTF-8 text.
+/// All modes return the same result. Unsupported modes fall back to `Utf8ScanMode::Portable`.
+/// @param text The text to validate.
+/// @param mode The implementation to use.
+/// @return The first error and its location.
+[[nodiscard]] auto utf8Validate(std::string_view text, Utf8ScanMode mode = utf8BestScanMode()) noexcept
+    -> Utf8ScanResult;
+
+/// Count the characters in UTF-8 text, by counting all bytes that are not continuation bytes.
+/// All modes return the same result. Unsupported modes fall back to `Utf8ScanMode::Portable`.
+/// @param text The text.
+/// @param mode The implementation to use.
+/// @return The number of characters.
+[[nodiscard]] auto utf8CharacterCount(std::string_view text, Utf8ScanMode mode = utf8BestScanMode()) noexcept
+    -> std::size_t;
+
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "ConsoleLine.hpp"
+
+#include <cstddef>
+#include <format>
+#include <string>
+#include <type_traits>
+
+namespace erbsland::unittest {
+
+/// Test if a type can be formatted using `std::format`.
+/// @tparam T The tested type.
+template <typename T>
+constexpr bool is_formattable = std::is_default_constructible_v<std::formatter<std::remove_cvref_t<T>, char>>;
+
+/// @internal
+/// Get the text for a value in an error message, or `?` if it cannot be formatted.
+/// @param value The value.
+/// @param maximumLength The maximum length of the text.
+template <typename T>
+[[nodiscard]] auto valueText(const T &value, const std::size_t maximumLength) -> std::string {
+    if constexpr (is_formattable<T>) {
+        return ConsoleLine::utf8SafeString(std::format("{}", value), maximumLength);
+    } else {
+        return "?";
+    }
+}
+
+}
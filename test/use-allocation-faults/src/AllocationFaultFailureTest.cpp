@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/// Three tests with a typical bug for a failed allocation: a leak, a missing null check and a broken invariant.
+/// With `--alloc-faults`, each bug is found and reported with the command line that replays the fault.
+SKIP_BY_DEFAULT()
+class AllocationFaultFailureTest final : public el::UnitTest {
+public:
+    void testLeak() {
+        auto *values = new std::vector<int>(100, 1);
+        values->push_back(2); // Leaks `values` if this allocation fails.
+        REQUIRE_EQUAL(values->size(), std::size_t{101});
+        delete values;
+    }
+
+    void testCrash() {
+        auto *buffer = new (std::nothrow) char[100];
+        buffer[0] = 'x'; // Crashes if the allocation failed.
+        REQUIRE_EQUAL(buffer[0], 'x');
+        delete[] buffer;
+    }
+
+    void testInvariant() {
+        std::size_t count = 0;
+        std::vector<std::string> names;
+        try {
+            ++count;
+            names.emplace_back("a name that is too long for the small string buffer");
+        } catch (const std::bad_alloc &) {
+            // The count is not restored.
+        }
+        REQUIRE_EQUAL(count, names.size());
+    }
+};
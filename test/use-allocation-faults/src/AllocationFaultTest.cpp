@@ -0,0 +1,65 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/// A registry that keeps its invariant if an allocation fails.
+class Registry {
+public:
+    void add(const std::string &name) {
+        auto entry = std::make_unique<std::string>(name);
+        _names.push_back(name);
+        _entries.emplace(name, std::move(entry));
+        ++_count;
+    }
+
+    [[nodiscard]] auto count() const noexcept -> std::size_t { return _count; }
+    [[nodiscard]] auto names() const noexcept -> const std::vector<std::string> & { return _names; }
+
+private:
+    std::vector<std::string> _names;
+    std::map<std::string, std::unique_ptr<std::string>> _entries;
+    std::size_t _count{0};
+};
+
+class AllocationFaultTest final : public el::UnitTest {
+public:
+    void testNoAllocations() {
+        const auto value = 6 * 7;
+        REQUIRE_EQUAL(value, 42);
+    }
+
+    void testStrongGuarantee() {
+        std::vector<std::string> names{"alpha", "beta"};
+        try {
+            names.emplace_back("a name that is too long for the small string buffer");
+        } catch (const std::bad_alloc &) {
+            // The vector is unchanged after a failed insert.
+            REQUIRE_EQUAL(names.size(), std::size_t{2});
+            return;
+        }
+        REQUIRE_EQUAL(names.size(), std::size_t{3});
+    }
+
+    void testExceptionInAssertion() {
+        Registry registry;
+        REQUIRE_NOTHROW(registry.add("a name that is too long for the small string buffer"));
+        REQUIRE_EQUAL(registry.count(), std::size_t{1});
+    }
+
+    void testExceptionInExpression() {
+        REQUIRE(std::string{"a name that is too long for the small string buffer"}.size() > 10);
+    }
+
+    void testExceptionLeavesTest() {
+        auto values = std::make_unique<std::vector<int>>(100, 1);
+        values->push_back(2);
+        REQUIRE_EQUAL(values->size(), std::size_t{101});
+    }
+};
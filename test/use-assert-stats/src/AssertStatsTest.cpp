@@ -0,0 +1,33 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+class AssertStatsTest final : public el::UnitTest {
+public:
+    void testElementWise() {
+        std::vector<int> values(10'000);
+        std::iota(values.begin(), values.end(), 0);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            REQUIRE_EQUAL(values[i], static_cast<int>(i));
+        }
+    }
+
+    void testBulk() {
+        std::vector<int> values(10'000);
+        std::iota(values.begin(), values.end(), 0);
+        REQUIRE(std::is_sorted(values.begin(), values.end()));
+    }
+
+    void requireEmpty(const std::vector<int> &values) {
+        REQUIRE(values.empty());
+    }
+
+    void testNested() {
+        WITH_CONTEXT(requireEmpty({}));
+    }
+};
@@ -0,0 +1,56 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cmath>
+#include <limits>
+#include <list>
+#include <vector>
+
+class ApproxComparisonTest final : public el::UnitTest {
+public:
+    static constexpr auto cNaN = std::numeric_limits<double>::quiet_NaN();
+    static constexpr auto cInfinity = std::numeric_limits<double>::infinity();
+
+    void testScalars() {
+        REQUIRE_APPROX(0.1 + 0.2, 0.3, {.ulps = 1});
+        REQUIRE_APPROX(1.0001, 1.0, {.relative = 1e-3});
+        REQUIRE_APPROX(1e-12, 0.0, {.absolute = 1e-9});
+        REQUIRE_APPROX(1.0F, 1.0F + std::numeric_limits<float>::epsilon(), {.ulps = 1});
+        REQUIRE_APPROX(-0.0, 0.0, {});
+        const el::unittest::Tolerance tolerance{.relative = 1e-6, .ulps = 4};
+        REQUIRE_APPROX(std::sqrt(2.0) * std::sqrt(2.0), 2, tolerance);
+    }
+
+    void testSpecialValues() {
+        REQUIRE_APPROX(cInfinity, cInfinity, {});
+        REQUIRE_FALSE(el::unittest::approxEqual(cInfinity, -cInfinity, {.relative = 1.0}));
+        REQUIRE_FALSE(el::unittest::approxEqual(cInfinity, cInfinity, {.matchInfinity = false}));
+        REQUIRE_FALSE(el::unittest::approxEqual(cNaN, cNaN, {.ulps = 100}));
+        REQUIRE_APPROX(cNaN, cNaN, {.matchNaN = true});
+        REQUIRE_FALSE(el::unittest::approxEqual(cNaN, 1.0, {.matchNaN = true}));
+    }
+
+    void testUlpDistance() {
+        REQUIRE_EQUAL(el::unittest::ulpDistance(1.0, std::nextafter(1.0, 2.0)), 1U);
+        REQUIRE_EQUAL(el::unittest::ulpDistance(-0.0F, 0.0F), 0U);
+        const auto smallest = std::numeric_limits<float>::denorm_min();
+        REQUIRE_EQUAL(el::unittest::ulpDistance(-smallest, smallest), 2U);
+        constexpr auto lowest = std::numeric_limits<double>::lowest();
+        constexpr auto highest = std::numeric_limits<double>::max();
+        REQUIRE_EQUAL(el::unittest::ulpDistance(lowest, highest), 0xffdf'ffff'ffff'fffeULL);
+    }
+
+    void testRanges() {
+        std::vector<float> actual(1'000'000);
+        std::vector<float> expected(actual.size());
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            expected[i] = static_cast<float>(i) * 0.1F;
+            actual[i] = std::nextafter(expected[i], 1e9F);
+        }
+        REQUIRE_RANGES_APPROX(actual, expected, {.ulps = 1});
+        const std::list<double> list{1.0, 2.0, 3.0};
+        REQUIRE_RANGES_APPROX(list, (std::vector<double>{1.0, 2.0, 3.0 + 1e-12}), {.absolute = 1e-9});
+    }
+};
@@ -0,0 +1,26 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/// A value outside its relative tolerance, and a range with errors of different sizes. The output proves that
+/// the NaN is reported as the worst element, and that the histogram also counts the element that is one ULP
+/// off, but inside the tolerance.
+SKIP_BY_DEFAULT()
+class ApproxFailureTest final : public el::UnitTest {
+public:
+    void testFailures() {
+        CHECK_APPROX(1.5, 1.0, {.relative = 1e-6, .ulps = 4});
+        std::vector<double> actual(100, 1.0);
+        const std::vector<double> expected(100, 1.0);
+        actual[10] = std::nextafter(1.0, 2.0);
+        actual[20] = 1.5;
+        actual[30] = std::numeric_limits<double>::quiet_NaN();
+        actual[40] = 1.0 + 1e-12;
+        CHECK_RANGES_APPROX(actual, expected, {.ulps = 4});
+    }
+};
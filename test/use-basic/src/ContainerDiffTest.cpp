@@ -0,0 +1,174 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ContainerDiffTest final : public el::UnitTest {
+public:
+    using DiffOperation = el::unittest::DiffOperation;
+
+    auto diffText(const std::string &a, const std::string &b) -> std::string {
+        const auto ranges = el::unittest::sequenceDiff(a.size(), b.size(), [&](std::size_t indexA, std::size_t indexB) {
+            return a[indexA] == b[indexB];
+        });
+        REQUIRE(ranges.has_value());
+        std::string result;
+        for (const auto &range : *ranges) {
+            switch (range.operation) {
+            case DiffOperation::Equal:
+                REQUIRE_EQUAL(a.substr(range.indexA, range.count), b.substr(range.indexB, range.count));
+                result += a.substr(range.indexA, range.count);
+                break;
+            case DiffOperation::Delete:
+                result += "-" + a.substr(range.indexA, range.count);
+                break;
+            case DiffOperation::Insert:
+                result += "+" + b.substr(range.indexB, range.count);
+                break;
+            }
+        }
+        return result;
+    }
+
+    void testSequenceDiff() {
+        REQUIRE_EQUAL(diffText("", ""), "");
+        REQUIRE_EQUAL(diffText("abc", "abc"), "abc");
+        REQUIRE_EQUAL(diffText("", "abc"), "+abc");
+        REQUIRE_EQUAL(diffText("abc", ""), "-abc");
+        REQUIRE_EQUAL(diffText("abcdef", "abXdef"), "ab-c+Xdef");
+        REQUIRE_EQUAL(diffText("xaaay", "xaay"), "xaa-ay");
+    }
+
+    void testShortestDiff() {
+        // The example from the paper of Eugene W. Myers has 5 edits.
+        const std::string a{"abcabba"};
+        const std::string b{"cbabac"};
+        const auto ranges = el::unittest::sequenceDiff(a.size(), b.size(), [&](std::size_t indexA, std::size_t indexB) {
+            return a[indexA] == b[indexB];
+        });
+        REQUIRE(ranges.has_value());
+        std::size_t editCount = 0;
+        std::string rebuilt;
+        for (const auto &range : *ranges) {
+            if (range.operation != DiffOperation::Equal) {
+                editCount += range.count;
+            }
+            if (range.operation != DiffOperation::Delete) {
+                rebuilt += b.substr(range.indexB, range.count);
+            }
+        }
+        REQUIRE_EQUAL(editCount, 5U);
+        REQUIRE_EQUAL(rebuilt, b);
+    }
+
+    void testSequenceDiffLimits() {
+        std::vector<int> a(10'000);
+        std::iota(a.begin(), a.end(), 0);
+        std::vector<int> b(10'000, -1);
+        const auto ranges = el::unittest::sequenceDiff(a.size(), b.size(), [&](std::size_t indexA, std::size_t indexB) {
+            return a[indexA] == b[indexB];
+        });
+        REQUIRE_FALSE(ranges.has_value());
+    }
+
+    void testLargeVectors() {
+        std::vector<int> a(2'000'000);
+        std::iota(a.begin(), a.end(), 0);
+        auto b = a;
+        b.erase(b.begin() + 1'000'000);
+        b[1'500'000] = -1;
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE_EQUAL(diff.onlyInA, 2U);
+        REQUIRE_EQUAL(diff.onlyInB, 1U);
+        REQUIRE_FALSE(diff.isIndexWise);
+        REQUIRE_EQUAL(diff.lines.size(), 3U);
+        REQUIRE_EQUAL(diff.lines[0], "- A[1000000]: 1000000");
+        REQUIRE_EQUAL(diff.lines[1], "- A[1500001]: 1500001");
+        REQUIRE_EQUAL(diff.lines[2], "+ B[1500000]: -1");
+    }
+
+    void testIndexWiseFallback() {
+        std::vector<int> a(5'000);
+        std::iota(a.begin(), a.end(), 0);
+        std::vector<int> b(5'001, -1);
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE(diff.isIndexWise);
+        REQUIRE_EQUAL(diff.changed, 5'000U);
+        REQUIRE_EQUAL(diff.onlyInB, 1U);
+        REQUIRE_EQUAL(diff.lines.size(), el::unittest::cContainerDiffMaximumLines);
+        REQUIRE_EQUAL(diff.lines[0], "~ [0]: 0 != -1");
+    }
+
+    void testLists() {
+        const std::list<std::string> a{"one", "two", "three"};
+        const std::list<std::string> b{"one", "three", "four"};
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE_EQUAL(diff.lines.size(), 2U);
+        REQUIRE_EQUAL(diff.lines[0], "- A[1]: two");
+        REQUIRE_EQUAL(diff.lines[1], "+ B[2]: four");
+    }
+
+    void testMaps() {
+        const std::map<std::string, int> a{{"one", 1}, {"two", 2}, {"three", 3}};
+        const std::map<std::string, int> b{{"one", 1}, {"two", 20}, {"four", 4}};
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE(diff.kind == el::unittest::ContainerKind::Map);
+        REQUIRE_EQUAL(diff.onlyInA, 1U);
+        REQUIRE_EQUAL(diff.onlyInB, 1U);
+        REQUIRE_EQUAL(diff.changed, 1U);
+        REQUIRE_EQUAL(diff.lines.size(), 3U);
+        REQUIRE_EQUAL(diff.lines[0], "- A[three]: 3");
+        REQUIRE_EQUAL(diff.lines[1], "+ B[four]: 4");
+        REQUIRE_EQUAL(diff.lines[2], "~ [two]: 2 != 20");
+    }
+
+    void testUnorderedMaps() {
+        std::unordered_map<int, int> a;
+        std::unordered_map<int, int> b;
+        for (int i = 0; i < 100'000; ++i) {
+            a.emplace(i, i);
+            b.emplace(i, i);
+        }
+        b.erase(500);
+        b[70'000] = 0;
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE_EQUAL(diff.onlyInA, 1U);
+        REQUIRE_EQUAL(diff.onlyInB, 0U);
+        REQUIRE_EQUAL(diff.changed, 1U);
+    }
+
+    void testSets() {
+        const std::set<int> a{1, 2, 3, 4};
+        const std::set<int> b{2, 3, 4, 5, 6};
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE(diff.kind == el::unittest::ContainerKind::Set);
+        REQUIRE_EQUAL(diff.onlyInA, 1U);
+        REQUIRE_EQUAL(diff.onlyInB, 2U);
+        REQUIRE_EQUAL(diff.lines[0], "- A: 1");
+        REQUIRE_EQUAL(diff.lines[1], "+ B: 5");
+    }
+
+    void testMultisets() {
+        const std::multiset<int> a{1, 2, 2, 3};
+        const std::multiset<int> b{1, 2, 3};
+        const auto diff = el::unittest::containerDiff(a, b);
+        REQUIRE(diff.kind == el::unittest::ContainerKind::Sequence);
+        REQUIRE_EQUAL(diff.onlyInA, 1U);
+        REQUIRE_EQUAL(diff.onlyInB, 0U);
+    }
+
+    void testStringsAreNoContainers() {
+        REQUIRE_FALSE(el::unittest::can_diff_containers<std::string, std::string>);
+        REQUIRE_FALSE((el::unittest::can_diff_containers<std::vector<char>, std::vector<char>>));
+        REQUIRE((el::unittest::can_diff_containers<std::vector<std::string>, std::vector<std::string>>));
+    }
+};
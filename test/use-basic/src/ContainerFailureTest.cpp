@@ -0,0 +1,27 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/// A vector with a million elements, where one element is removed and one is inserted, and two maps. The
+/// output proves that the diff lists only the two edits instead of every shifted index, and that maps are
+/// compared by their keys.
+SKIP_BY_DEFAULT()
+class ContainerFailureTest final : public el::UnitTest {
+public:
+    void testFailures() {
+        std::vector<int> actual(1'000'000);
+        std::iota(actual.begin(), actual.end(), 0);
+        auto expected = actual;
+        expected.erase(expected.begin() + 500);
+        expected.insert(expected.begin() + 700, -1);
+        CHECK_EQUAL(actual, expected);
+        const std::map<std::string, int> scores{{"alice", 3}, {"bob", 5}};
+        CHECK_EQUAL(scores, (std::map<std::string, int>{{"alice", 4}, {"carol", 5}}));
+    }
+};
@@ -0,0 +1,45 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+class RangeComparisonTest final : public el::UnitTest {
+public:
+    void testLargeBuffers() {
+        std::vector<std::uint32_t> actual(10'000'000);
+        std::iota(actual.begin(), actual.end(), 0U);
+        const auto expected = actual;
+        REQUIRE_RANGES_EQUAL(actual, expected);
+    }
+
+    void testMixedContainers() {
+        const std::array<int, 4> array{1, 2, 3, 4};
+        const std::vector<int> vector{1, 2, 3, 4};
+        const std::list<int> list{1, 2, 3, 4};
+        REQUIRE_RANGES_EQUAL(array, vector);
+        REQUIRE_RANGES_EQUAL(std::span{vector}, list);
+        REQUIRE_RANGES_EQUAL(std::vector<int>{}, std::list<int>{});
+    }
+
+    void testElementWise() {
+        const std::vector<std::string> actual{"one", "two"};
+        const std::vector<std::string> expected{"one", "two"};
+        REQUIRE_RANGES_EQUAL(actual, expected);
+        const std::vector<double> values{0.0, 1.5};
+        REQUIRE_RANGES_EQUAL(values, (std::vector<double>{-0.0, 1.5}));
+    }
+
+    void testNotEqual() {
+        REQUIRE_FALSE(el::unittest::rangesEqual(std::vector<int>{1, 2}, std::vector<int>{1, 3}));
+        REQUIRE_FALSE(el::unittest::rangesEqual(std::vector<int>{1, 2}, std::vector<int>{1, 2, 3}));
+        REQUIRE_FALSE(el::unittest::rangesEqual(std::list<int>{1, 2}, std::vector<int>{1}));
+    }
+};
@@ -0,0 +1,26 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+/// Two changed elements in a thousand, and two ranges of different size. The output proves that all
+/// differences are counted, while only the elements around the first one are shown, and that a missing
+/// element is shown as `<none>`.
+SKIP_BY_DEFAULT()
+class RangeFailureTest final : public el::UnitTest {
+public:
+    void testFailures() {
+        std::vector<int> actual(1000);
+        std::iota(actual.begin(), actual.end(), 0);
+        auto expected = actual;
+        expected[500] = -1;
+        expected[700] = -1;
+        CHECK_RANGES_EQUAL(actual, expected);
+        const std::vector<std::string> words{"alpha", "beta"};
+        CHECK_RANGES_EQUAL(words, (std::vector<std::string>{"alpha", "beta", "gamma"}));
+    }
+};
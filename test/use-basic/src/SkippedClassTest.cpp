@@ -0,0 +1,11 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+/// A test class that only runs if it is selected explicitly.
+SKIP_BY_DEFAULT()
+class SkippedClassTest final : public el::UnitTest {
+public:
+    void testRunsOnlyIfSelected() { REQUIRE(true); }
+};
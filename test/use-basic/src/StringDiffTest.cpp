@@ -0,0 +1,68 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <string>
+#include <string_view>
+
+class StringDiffTest final : public el::UnitTest {
+public:
+    void testCommonPrefix() {
+        REQUIRE_EQUAL(el::unittest::commonPrefixLength("", ""), 0U);
+        REQUIRE_EQUAL(el::unittest::commonPrefixLength("abc", "abd"), 2U);
+        REQUIRE_EQUAL(el::unittest::commonPrefixLength("abc", "abcdef"), 3U);
+        const std::string a(10'000, 'x');
+        auto b = a;
+        b[9'001] = 'y';
+        REQUIRE_EQUAL(el::unittest::commonPrefixLength(a, b), 9'001U);
+        REQUIRE_EQUAL(el::unittest::commonPrefixLength(a, a), 10'000U);
+    }
+
+    void testCommonSuffix() {
+        REQUIRE_EQUAL(el::unittest::commonSuffixLength("abc", "xbc", 3), 2U);
+        REQUIRE_EQUAL(el::unittest::commonSuffixLength("abc", "abc", 1), 1U);
+        const std::string a(10'000, 'x');
+        auto b = a + "x";
+        b[17] = 'y';
+        REQUIRE_EQUAL(el::unittest::commonSuffixLength(a, b, 10'000), 9'983U);
+    }
+
+    void testMessage() {
+        std::string a = "{\"name\": \"alice\", \"values\": [";
+        for (int i = 0; i < 200; ++i) {
+            a += std::to_string(i) + ", ";
+        }
+        a += "200]}";
+        auto b = a;
+        b[a.find("123")] = '7';
+        const auto message = el::unittest::stringDiffMessage(a, b, "a", "b");
+        REQUIRE_EQUAL(
+            message,
+            std::string{"Strings differ after 534 equal characters (534 bytes): A has 924 bytes, B has 924 bytes.\n"
+                        "  A: a\n"
+                        "     ...119, 120, 121, 122, 123, 124, 125, 126, 1...\n"
+                        "  B: b\n"
+                        "     ...119, 120, 121, 122, 723, 124, 125, 126, 1...\n"
+                        "                            ^"});
+    }
+
+    void testUtf8Boundaries() {
+        // The strings differ in the last byte of a two byte sequence, the window starts at its first byte.
+        const std::string a = std::string(100, '-') + "\xC3\xA4" + "end";
+        const std::string b = std::string(100, '-') + "\xC3\xB6" + "end";
+        const auto message = el::unittest::stringDiffMessage(a, b, "a", "b");
+        REQUIRE(message.starts_with("Strings differ after 100 equal characters (100 bytes)"));
+        REQUIRE(message.find("     ...--------------------\\u{00E4}end\n") != std::string::npos);
+        REQUIRE(message.find("     ...--------------------\\u{00F6}end\n") != std::string::npos);
+        REQUIRE(message.ends_with("\n" + std::string(5 + 23, ' ') + "^"));
+    }
+
+    void testShortStrings() {
+        const auto message = el::unittest::comparisonErrorMessage("==", "a", "b", std::string{"one"}, std::string{"two"});
+        REQUIRE(message.starts_with("Comparison failed: one == two"));
+        const auto u8Message =
+            el::unittest::comparisonErrorMessage("==", "a", "b", std::u8string{u8"one"}, std::u8string{u8"two"});
+        REQUIRE(u8Message.starts_with("Strings differ after 0 equal characters (0 bytes)"));
+    }
+};
@@ -0,0 +1,24 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <string>
+
+/// A JSON document of more than 8000 bytes, with one changed digit in the middle. The output proves that the
+/// message skips the equal start and shows the change with a caret, instead of cutting the text after 80
+/// characters.
+SKIP_BY_DEFAULT()
+class StringFailureTest final : public el::UnitTest {
+public:
+    void testFailures() {
+        std::string actual = "{\"items\": [";
+        for (int i = 0; i < 300; ++i) {
+            actual += "{\"id\": " + std::to_string(i) + ", \"name\": \"item\"}, ";
+        }
+        actual += "{}]}";
+        auto expected = actual;
+        expected.replace(expected.find("\"id\": 150"), 9, "\"id\": 151");
+        CHECK_EQUAL(actual, expected);
+    }
+};
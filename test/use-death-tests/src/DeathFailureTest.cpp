@@ -0,0 +1,21 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstdlib>
+#include <stdexcept>
+
+/// One failing check for each way a death test can fail: the expression returns, exits with the wrong code,
+/// writes output that does not match, throws, or exits with code zero. Each one has its own message.
+SKIP_BY_DEFAULT()
+class DeathFailureTest final : public el::UnitTest {
+public:
+    void testFailures() {
+        CHECK_DEATH(static_cast<void>(0));
+        CHECK_EXIT(std::exit(1), 2);
+        CHECK_DEATH_MATCHES(std::abort(), "no such output");
+        CHECK_DEATH(throw std::runtime_error("not a death"));
+        CHECK_DEATH(std::exit(0));
+    }
+};
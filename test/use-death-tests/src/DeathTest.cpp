@@ -0,0 +1,57 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+/// Simulate an invariant check of a library, that aborts the process.
+void checkInvariant(const bool condition, const char *name) {
+    if (!condition) {
+        std::fprintf(stderr, "Invariant violated: %s\n", name);
+        std::abort();
+    }
+}
+
+/// Simulate a command line tool that exits on a usage error.
+void exitWithUsage() {
+    std::fputs("Error: missing argument.\nUsage: tool <file>\n", stderr);
+    std::exit(2);
+}
+
+}
+
+class DeathTest final : public el::UnitTest {
+public:
+    int value{0}; ///< A value that is changed in the child process.
+
+    void testAbort() { REQUIRE_DEATH(std::abort()); }
+
+    void testInvariant() {
+        REQUIRE_DEATH_MATCHES(checkInvariant(false, "count"), "Invariant violated: *");
+        REQUIRE_DEATH_MATCHES(checkInvariant(1 + 1 == 3, "sum"), "*: sum");
+    }
+
+    void testExitCode() {
+        REQUIRE_EXIT(std::exit(0), 0);
+        REQUIRE_EXIT(std::exit(3), 3);
+        REQUIRE_EXIT_MATCHES(exitWithUsage(), 2, "Usage: *");
+    }
+
+    void testChildDoesNotChangeParent() {
+        REQUIRE_DEATH([this]() -> void {
+            value = 42;
+            std::abort();
+        }());
+        REQUIRE_EQUAL(value, 0);
+    }
+
+    void testManyDeathChecks() {
+        for (int i = 0; i < 200; ++i) {
+            CHECK_EXIT(std::_Exit(i % 100), i % 100);
+        }
+    }
+};
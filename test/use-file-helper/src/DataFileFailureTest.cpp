@@ -0,0 +1,22 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/FileHelper.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <string>
+
+/// A changed character and a missing line. The output proves that the difference is located by line, column
+/// and byte, and shown with the escaped lines of both sides.
+SKIP_BY_DEFAULT()
+class DataFileFailureTest final : public el::UnitTest {
+public:
+    void testDifferentLine() {
+        REQUIRE_MATCHES_DATA_FILE(
+            "Export started\nid;name;value\n1;Ärger;42\n2;Euro $;17\nExport finished\n", "data/expected-output.txt");
+    }
+
+    void testMissingLine() {
+        REQUIRE_MATCHES_DATA_FILE(std::string{"Export started\nid;name;value\n"}, "data/expected-output.txt");
+    }
+};
@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/FileHelper.hpp>
+#include <erbsland/unittest/TextHelper.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fh = erbsland::unittest::fh;
+namespace th = erbsland::unittest::th;
+namespace fs = std::filesystem;
+
+class DataFileTest final : public el::UnitTest {
+public:
+    static constexpr std::string_view cExpectedOutput =
+        "Export started\nid;name;value\n1;Ärger;42\n2;Euro €;17\nExport finished\n";
+
+    fs::path largeFilePath; ///< A generated data file, that is larger than the chunks that are read.
+    std::string largeText;  ///< The contents of the generated data file.
+
+    void setUpSuite() override {
+        for (std::size_t i = 0; i < 20'000; ++i) {
+            largeText += std::format("{};Ärger mit € und \U0001F600;{}\n", i, i * 7);
+        }
+        // A random name, so test runs in parallel don't share the file.
+        std::random_device randomDevice;
+        largeFilePath = fs::temp_directory_path() /
+            std::format("erbsland-unittest-large-data-file-{:08x}{:08x}.txt", randomDevice(), randomDevice());
+        std::ofstream file{largeFilePath, std::ios::out | std::ios::binary | std::ios::trunc};
+        file << largeText;
+    }
+
+    void tearDownSuite() override {
+        std::error_code error;
+        fs::remove(largeFilePath, error);
+    }
+
+    /// Get a producer, that returns the text in chunks with the given size.
+    static auto chunkProducer(const std::string_view text, const std::size_t chunkSize) -> fh::ChunkProducer {
+        return [text, chunkSize, position = std::size_t{0}]() mutable -> std::string_view {
+            const auto chunk = text.substr(position, chunkSize);
+            position += chunk.size();
+            return chunk;
+        };
+    }
+
+    void testMatchesDataFile() {
+        REQUIRE_MATCHES_DATA_FILE(cExpectedOutput, "data/expected-output.txt");
+        REQUIRE_MATCHES_DATA_FILE(std::string{cExpectedOutput}, "data/expected-output.txt");
+        for (const auto chunkSize : {std::size_t{1}, std::size_t{3}, std::size_t{1000}}) {
+            WITH_CONTEXT(chunkSize);
+            REQUIRE_MATCHES_DATA_FILE(chunkProducer(cExpectedOutput, chunkSize), "data/expected-output.txt");
+        }
+    }
+
+    void testDifferenceLocation() {
+        auto text = std::string{cExpectedOutput};
+        text.replace(text.find("42"), 2, "43");
+        const auto difference = fh::findDataFileDifference(text, "data/expected-output.txt");
+        REQUIRE(difference.has_value());
+        REQUIRE_EQUAL(difference->line, 3U);
+        REQUIRE_EQUAL(difference->column, 10U);
+        REQUIRE_EQUAL(difference->byteIndex, 39U);
+        REQUIRE(difference->message.starts_with("Text differs from the data file at line 3, column 10 (byte 39): "));
+        REQUIRE(difference->message.ends_with(
+            "\n    id;name;value\n  - 1;\\u{00C4}rger;42\n  + 1;\\u{00C4}rger;43\n                    ^"));
+    }
+
+    void testDifferenceInCharacter() {
+        // Both characters start with the same byte; the difference is reported at the start of the character.
+        auto text = std::string{cExpectedOutput};
+        text.replace(text.find("Ä"), 2, "Ö");
+        for (const auto chunkSize : {std::size_t{1}, std::size_t{31}, std::size_t{1000}}) {
+            WITH_CONTEXT(chunkSize);
+            const auto difference =
+                fh::findDataFileDifference(chunkProducer(text, chunkSize), "data/expected-output.txt");
+            REQUIRE(difference.has_value());
+            REQUIRE_EQUAL(difference->line, 3U);
+            REQUIRE_EQUAL(difference->column, 3U);
+            REQUIRE_EQUAL(difference->byteIndex, 31U);
+            REQUIRE(difference->message.ends_with("\n  - 1;\\u{00C4}rger;42\n  + 1;\\u{00D6}rger;42\n      ^"));
+        }
+    }
+
+    void testDifferentLength() {
+        const auto shortText = cExpectedOutput.substr(0, cExpectedOutput.size() - 16);
+        auto difference = fh::findDataFileDifference(shortText, "data/expected-output.txt");
+        REQUIRE(difference.has_value());
+        REQUIRE(difference->message.starts_with("Text ends before the data file at line 5, column 1"));
+        REQUIRE(difference->message.ends_with("\n    2;Euro \\u{20AC};17\n  - Export finished\n  + \n    ^"));
+
+        const auto longText = std::string{cExpectedOutput} + "extra line\n";
+        difference = fh::findDataFileDifference(longText, "data/expected-output.txt");
+        REQUIRE(difference.has_value());
+        REQUIRE(difference->message.starts_with("Text continues after the end of the data file at line 6, column 1"));
+        REQUIRE(difference->message.ends_with("\n    Export finished\n  - \n  + extra line\n    ^"));
+
+        difference = fh::findDataFileDifference(std::string_view{}, "data/expected-output.txt");
+        REQUIRE(difference.has_value());
+        REQUIRE_EQUAL(difference->line, 1U);
+        REQUIRE_EQUAL(difference->column, 1U);
+        REQUIRE_EQUAL(difference->byteIndex, 0U);
+    }
+
+    void testLargeDataFile() {
+        const auto path = largeFilePath.string();
+        REQUIRE_MATCHES_DATA_FILE(largeText, path);
+        for (int i = 0; i < 5; ++i) {
+            const auto chunkSize = static_cast<std::size_t>(random().nextInRange(1, 100'000));
+            WITH_CONTEXT(chunkSize);
+            REQUIRE_MATCHES_DATA_FILE(chunkProducer(largeText, chunkSize), path);
+        }
+    }
+
+    void testDifferenceInLargeDataFile() {
+        const auto path = largeFilePath.string();
+        const auto lines = th::splitLineViews(largeText);
+        const auto lineCount = static_cast<int>(lines.size());
+        for (int i = 0; i < 20; ++i) {
+            // Change one byte of a random line, and check the reported location.
+            const auto lineIndex = static_cast<std::size_t>(random().nextInRange(1, lineCount - 1));
+            const auto line = lines[lineIndex];
+            const auto lineOffset = static_cast<std::size_t>(line.data() - largeText.data());
+            const auto lineSize = static_cast<int>(line.size());
+            const auto columnIndex = static_cast<std::size_t>(random().nextInRange(0, lineSize - 1));
+            if (th::characterCount(line.substr(columnIndex, 1)) == 0) {
+                continue; // Skip the continuation bytes of the multi-byte characters.
+            }
+            auto text = largeText;
+            text[lineOffset + columnIndex] = '#';
+            const auto chunkSize = static_cast<std::size_t>(random().nextInRange(1, 100'000));
+            runWithContext(SOURCE_LOCATION(), [&]() -> void {
+                const auto difference = fh::findDataFileDifference(chunkProducer(text, chunkSize), path);
+                REQUIRE(difference.has_value());
+                REQUIRE_EQUAL(difference->line, lineIndex + 1);
+                REQUIRE_EQUAL(difference->column, th::characterCount(line.substr(0, columnIndex)) + 1);
+                REQUIRE_EQUAL(difference->byteIndex, lineOffset + columnIndex);
+                // The previous line is shown as context.
+                REQUIRE(difference->message.find(std::format("\n    {};", lineIndex - 1)) != std::string::npos);
+            }, [&]() -> std::string {
+                return std::format(
+                    "line index = {}, column index = {}, chunk size = {}", lineIndex, columnIndex, chunkSize);
+            });
+        }
+    }
+};
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <span>
+
+/// Crashes with every input. The fuzzer must save the input and then pass the signal to the crash report.
+SKIP_BY_DEFAULT()
+class FuzzCrashTest final : public el::UnitTest {
+public:
+    void fuzzAbort(std::span<const std::byte> data) {
+        if (data.size() < 1'000'000) {
+            std::abort();
+        }
+    }
+};
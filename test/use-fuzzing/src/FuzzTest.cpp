@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/// Parse a comma separated list of integers, like `1,-2,3`.
+auto parseList(const std::string_view text) -> std::vector<int> {
+    std::vector<int> result;
+    if (text.empty()) {
+        return result;
+    }
+    std::size_t position = 0;
+    while (true) {
+        bool isNegative = false;
+        if (position < text.size() && text[position] == '-') {
+            isNegative = true;
+            ++position;
+        }
+        if (position >= text.size() || text[position] < '0' || text[position] > '9') {
+            throw std::invalid_argument("Expected a digit.");
+        }
+        int value = 0;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+            if (value > 100'000'000) {
+                throw std::out_of_range("Value too large.");
+            }
+            value = value * 10 + (text[position] - '0');
+            ++position;
+        }
+        result.push_back(isNegative ? -value : value);
+        if (position == text.size()) {
+            break;
+        }
+        if (text[position] != ',') {
+            throw std::invalid_argument("Expected a comma.");
+        }
+        ++position;
+    }
+    return result;
+}
+
+/// Convert a list of integers into its text form.
+auto formatList(const std::vector<int> &values) -> std::string {
+    std::string result;
+    for (const auto value : values) {
+        if (!result.empty()) {
+            result += ",";
+        }
+        result += std::to_string(value);
+    }
+    return result;
+}
+
+}
+
+class FuzzTest final : public el::UnitTest {
+public:
+    void testParseListExamples() {
+        REQUIRE_EQUAL(parseList("1,2,3"), (std::vector<int>{1, 2, 3}));
+        REQUIRE_EQUAL(formatList(parseList("-5,17,0")), std::string{"-5,17,0"});
+        REQUIRE_THROWS(parseList("1,,2"));
+    }
+
+    void fuzzParseList(std::span<const std::byte> data) {
+        const auto text = std::string_view{reinterpret_cast<const char *>(data.data()), data.size()};
+        std::vector<int> values;
+        try {
+            values = parseList(text);
+        } catch (const std::invalid_argument &) {
+            return; // Rejecting invalid input is expected.
+        } catch (const std::out_of_range &) {
+            return;
+        }
+        // Every accepted list must survive a round trip.
+        REQUIRE_EQUAL(parseList(formatList(values)), values);
+    }
+
+    void fuzzEmptyCorpus(std::span<const std::byte> data) {
+        // There is no corpus for this test, so it is called once with an empty input.
+        REQUIRE(data.empty());
+    }
+};
@@ -0,0 +1,16 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstdlib>
+
+/// Aborts in `testAbort()`. With `--isolate`, the signal only ends the forked process of this test, so the
+/// output still reports `testAfterAbort()` as passed.
+SKIP_BY_DEFAULT()
+class IsolationCrashTest final : public el::UnitTest {
+public:
+    void testAbort() { std::abort(); }
+
+    void testAfterAbort() { REQUIRE(true); }
+};
@@ -0,0 +1,36 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <vector>
+
+// This suite must be run with `--isolate`: every test modifies the fixture and expects the original state.
+class IsolationTest final : public el::UnitTest {
+public:
+    std::vector<int> fixture;  ///< The fixture that is modified by every test.
+    int setUpSuiteCount{0};    ///< The number of calls to `setUpSuite()`.
+
+    void setUpSuite() override {
+        ++setUpSuiteCount;
+        fixture = {1, 2, 3};
+    }
+
+    void testAppendToFixture() {
+        REQUIRE_EQUAL(setUpSuiteCount, 1);
+        REQUIRE_EQUAL(fixture, (std::vector<int>{1, 2, 3}));
+        fixture.push_back(4);
+    }
+
+    void testClearFixture() {
+        REQUIRE_EQUAL(setUpSuiteCount, 1);
+        REQUIRE_EQUAL(fixture, (std::vector<int>{1, 2, 3}));
+        fixture.clear();
+    }
+
+    void testModifyFixture() {
+        REQUIRE_EQUAL(setUpSuiteCount, 1);
+        REQUIRE_EQUAL(fixture, (std::vector<int>{1, 2, 3}));
+        fixture[0] = 100;
+    }
+};
@@ -0,0 +1,35 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <csignal>
+
+namespace {
+
+/// Simulate a crash in the tested code.
+auto crashWithSegfault() -> bool {
+    std::raise(SIGSEGV);
+    return true;
+}
+
+}
+
+/// Raises `SIGSEGV` in `testCrash()`. The output proves that the supervisor reports the crashed test, resumes
+/// the suite in a new process, and runs `testAfterCrash()` with its own call of `setUpSuite()`.
+SKIP_BY_DEFAULT()
+class SupervisionCrashTest final : public el::UnitTest {
+public:
+    int setUpSuiteCount{0}; ///< The number of calls to `setUpSuite()`.
+
+    void setUpSuite() override { ++setUpSuiteCount; }
+
+    void testBeforeCrash() { REQUIRE_EQUAL(setUpSuiteCount, 1); }
+
+    void testCrash() { REQUIRE(crashWithSegfault()); }
+
+    void testAfterCrash() {
+        // The suite was resumed in a new process, from a fresh snapshot.
+        REQUIRE_EQUAL(setUpSuiteCount, 1);
+    }
+};
@@ -0,0 +1,29 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/// Leaks memory, a file descriptor and a running thread. Each leak is reported with the test that caused it;
+/// only with `--strict-leaks` are they counted as errors.
+SKIP_BY_DEFAULT()
+class LeakCheckFailureTest final : public el::UnitTest {
+public:
+    void testLeakedMemory() {
+        auto *values = new std::vector<int>(100, 1);
+        REQUIRE_EQUAL(values->size(), std::size_t{100});
+    }
+
+    void testLeakedFile() {
+        auto *file = std::fopen(unitTestExecutablePath().string().c_str(), "rb");
+        REQUIRE(file != nullptr);
+    }
+
+    void testLeakedThread() {
+        std::thread{[]() -> void { std::this_thread::sleep_for(std::chrono::hours{1}); }}.detach();
+    }
+};
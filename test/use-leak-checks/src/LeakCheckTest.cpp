@@ -0,0 +1,38 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class LeakCheckTest final : public el::UnitTest {
+public:
+    std::unique_ptr<std::vector<int>> values;
+
+    void setUp() override { values = std::make_unique<std::vector<int>>(1000, 1); }
+
+    void tearDown() override { values.reset(); }
+
+    void testReleasedMemory() {
+        auto buffer = std::make_unique<char[]>(4096);
+        buffer[0] = 'x';
+        REQUIRE_EQUAL(buffer[0], 'x');
+        REQUIRE_EQUAL(values->size(), std::size_t{1000});
+    }
+
+    void testClosedFile() {
+        auto *file = std::fopen(unitTestExecutablePath().string().c_str(), "rb");
+        REQUIRE(file != nullptr);
+        std::fclose(file);
+    }
+
+    void testJoinedThread() {
+        int result = 0;
+        std::thread thread{[&result]() -> void { result = 42; }};
+        thread.join();
+        REQUIRE_EQUAL(result, 42);
+    }
+};
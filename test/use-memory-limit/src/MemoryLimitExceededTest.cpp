@@ -0,0 +1,33 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+/// Allocates ten megabytes under a limit of one megabyte. The output proves that a caught `std::bad_alloc`
+/// still fails the test, and that the next test starts with a fresh allocation count.
+SKIP_BY_DEFAULT()
+MEMORY_LIMIT(1M)
+class MemoryLimitExceededTest final : public el::UnitTest {
+public:
+    void testExceedLimit() {
+        std::vector<char> buffer(10'000'000, 'x');
+        REQUIRE_EQUAL(buffer.back(), 'x');
+    }
+
+    void testCatchBadAlloc() {
+        try {
+            std::vector<char> buffer(10'000'000, 'x');
+        } catch (const std::bad_alloc &) {
+            // Catching the exception does not hide the exceeded limit.
+        }
+    }
+
+    void testAfterLimit() {
+        std::vector<char> buffer(100'000, 'x');
+        REQUIRE_EQUAL(buffer.back(), 'x');
+    }
+};
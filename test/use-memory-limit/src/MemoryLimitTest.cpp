@@ -0,0 +1,35 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+MEMORY_LIMIT(1M)
+class MemoryLimitTest final : public el::UnitTest {
+public:
+    void testSmallAllocations() {
+        std::vector<std::string> lines;
+        for (int i = 0; i < 1000; ++i) {
+            lines.emplace_back(std::string(100, 'x'));
+        }
+        REQUIRE_EQUAL(lines.size(), std::size_t{1000});
+    }
+
+    void testMemoryIsReleased() {
+        // Each block is below the limit, and freed before the next one is allocated.
+        for (int i = 0; i < 10; ++i) {
+            auto block = std::make_unique<char[]>(500'000);
+            block[0] = 'x';
+            REQUIRE_EQUAL(block[0], 'x');
+        }
+    }
+
+    MEMORY_LIMIT(100M)
+    void testLargerLimitForTest() {
+        std::vector<char> buffer(10'000'000, 'x');
+        REQUIRE_EQUAL(buffer.back(), 'x');
+    }
+};
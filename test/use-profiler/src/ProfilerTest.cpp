@@ -0,0 +1,27 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+/// Use the CPU for the given time, in a function that shall appear in the profile.
+[[gnu::noinline]] inline auto burnCpu(const std::chrono::milliseconds duration) -> std::uint64_t {
+    std::uint64_t value = 1;
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1000; ++i) {
+            value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+    }
+    return value;
+}
+
+class ProfilerTest final : public el::UnitTest {
+public:
+    void testBurnCpu() {
+        const auto value = burnCpu(std::chrono::milliseconds{200});
+        REQUIRE(value != 0);
+    }
+};
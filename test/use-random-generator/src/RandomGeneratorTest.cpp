@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/RandomGenerator.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using erbsland::unittest::RandomGenerator;
+
+class RandomGeneratorTest final : public el::UnitTest {
+public:
+    void testReferenceSequence() {
+        // Reference values for xoshiro256**, seeded with SplitMix64.
+        RandomGenerator rng{0};
+        REQUIRE_EQUAL(rng(), 0x99ec5f36cb75f2b4ULL);
+        REQUIRE_EQUAL(rng(), 0xbf6e1f784956452aULL);
+        REQUIRE_EQUAL(rng(), 0x1a5f849d4933e6e0ULL);
+        rng = RandomGenerator{12345};
+        REQUIRE_EQUAL(rng(), 0xbe6a36374160d49bULL);
+        REQUIRE_EQUAL(rng(), 0x214aaa0637a688c6ULL);
+        REQUIRE_EQUAL(rng(), 0xf69d16de9954d388ULL);
+        REQUIRE_EQUAL(rng.seed(), 12345U);
+    }
+
+    void testDerive() {
+        RandomGenerator rng{0x1234};
+        auto derived1 = rng.derive(1);
+        auto derived2 = rng.derive(2);
+        // Deriving does not depend on the state of the generator.
+        for (int i = 0; i < 10; ++i) {
+            static_cast<void>(rng());
+        }
+        auto derived1Again = rng.derive(1);
+        REQUIRE_EQUAL(derived1.seed(), derived1Again.seed());
+        REQUIRE_NOT_EQUAL(derived1.seed(), derived2.seed());
+        REQUIRE_NOT_EQUAL(derived1(), derived2());
+        REQUIRE_EQUAL(rng.derive("worker").seed(), rng.derive("worker").seed());
+        REQUIRE_NOT_EQUAL(rng.derive("worker").seed(), rng.derive("reader").seed());
+        // Splitting consumes values, so every split is different.
+        auto split1 = rng.split();
+        auto split2 = rng.split();
+        REQUIRE_NOT_EQUAL(split1.seed(), split2.seed());
+    }
+
+    void testNextInRange() {
+        RandomGenerator rng{42};
+        std::array<int, 6> counts{};
+        for (int i = 0; i < 6000; ++i) {
+            const auto value = rng.nextInRange(1, 6);
+            REQUIRE_GREATER_EQUAL(value, 1);
+            REQUIRE_LESS_EQUAL(value, 6);
+            counts[static_cast<std::size_t>(value - 1)] += 1;
+        }
+        for (const auto count : counts) {
+            REQUIRE_GREATER(count, 800);
+        }
+        for (int i = 0; i < 100; ++i) {
+            const auto value = rng.nextInRange<std::int8_t>(-3, 3);
+            REQUIRE_GREATER_EQUAL(value, -3);
+            REQUIRE_LESS_EQUAL(value, 3);
+        }
+        REQUIRE_EQUAL(rng.nextInRange(7, 7), 7);
+        constexpr auto maximum = std::numeric_limits<std::uint64_t>::max();
+        static_cast<void>(rng.nextInRange<std::uint64_t>(0, maximum));
+    }
+
+    void testNextDouble() {
+        RandomGenerator rng{42};
+        double sum = 0.0;
+        for (int i = 0; i < 10000; ++i) {
+            const auto value = rng.nextDouble();
+            REQUIRE_GREATER_EQUAL(value, 0.0);
+            REQUIRE_LESS(value, 1.0);
+            sum += value;
+        }
+        REQUIRE_GREATER(sum, 4800.0);
+        REQUIRE_LESS(sum, 5200.0);
+    }
+
+    void testStandardDistribution() {
+        RandomGenerator rng{7};
+        std::uniform_int_distribution<int> distribution{10, 20};
+        for (int i = 0; i < 100; ++i) {
+            const auto value = distribution(rng);
+            REQUIRE_GREATER_EQUAL(value, 10);
+            REQUIRE_LESS_EQUAL(value, 20);
+        }
+    }
+
+    void testFill() {
+        for (const auto size : {0U, 1U, 7U, 31U, 32U, 33U, 1000U}) {
+            WITH_CONTEXT(size);
+            RandomGenerator rng1{99};
+            RandomGenerator rng2{99};
+            auto small = rng1.randomBytes(size);
+            auto large = rng2.randomBytes(size + 100);
+            REQUIRE_EQUAL(small.size(), size);
+            REQUIRE_EQUAL(large.substr(0, size), small);
+            // Filling consumes exactly one value, regardless of the size.
+            REQUIRE_EQUAL(rng1(), rng2());
+        }
+        RandomGenerator rng{99};
+        std::vector<std::byte> buffer(4096);
+        rng.fill(buffer);
+        std::array<int, 256> counts{};
+        for (const auto value : buffer) {
+            counts[static_cast<std::size_t>(value)] += 1;
+        }
+        REQUIRE(std::ranges::all_of(counts, [](const int count) -> bool { return count > 0; }));
+    }
+
+    void testRandomText() {
+        RandomGenerator rng{1};
+        const auto text = rng.randomText(200, "ab");
+        REQUIRE_EQUAL(text.size(), 200U);
+        REQUIRE(text.find_first_not_of("ab") == std::string::npos);
+        REQUIRE(text.find('a') != std::string::npos);
+        REQUIRE(text.find('b') != std::string::npos);
+        REQUIRE(rng.randomText(10, {}).empty());
+    }
+
+    void testHashText() {
+        // FNV-1a reference values.
+        REQUIRE_EQUAL(RandomGenerator::hashText(""), 0xcbf29ce484222325ULL);
+        REQUIRE_EQUAL(RandomGenerator::hashText("a"), 0xaf63dc4c8601ec8cULL);
+    }
+
+    void testPerTestGenerator() {
+        auto &rng = random();
+        REQUIRE(&rng == &random());
+        // The per-test generator is reset before each test, so it starts from its seed.
+        RandomGenerator copy{rng.seed()};
+        REQUIRE_EQUAL(rng(), copy());
+        // Independent generators for threads.
+        std::array<std::uint64_t, 4> results{};
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            threads.emplace_back([&results, i, threadRng = rng.derive(i)]() mutable -> void {
+                results[i] = threadRng();
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            WITH_CONTEXT(i);
+            REQUIRE_EQUAL(results[i], rng.derive(i)());
+        }
+    }
+};
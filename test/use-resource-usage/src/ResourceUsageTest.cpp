@@ -0,0 +1,48 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class ResourceUsageTest final : public el::UnitTest {
+public:
+    void testSleep() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        REQUIRE(true);
+    }
+
+    void testComputation() {
+        std::uint64_t value = 1;
+        const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+        while (std::chrono::steady_clock::now() < end) {
+            for (int i = 0; i < 1000; ++i) {
+                value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+            }
+        }
+        REQUIRE(value != 0);
+    }
+
+    void testWorkerThread() {
+        // The work of this thread is not part of the usage of the test.
+        std::uint64_t value = 1;
+        auto worker = std::thread{[&value]() -> void {
+            const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds{20};
+            while (std::chrono::steady_clock::now() < end) {
+                for (int i = 0; i < 1000; ++i) {
+                    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+                }
+            }
+        }};
+        worker.join();
+        REQUIRE(value != 0);
+    }
+
+    void testPageFaults() {
+        std::vector<char> buffer(8'000'000, 'x');
+        REQUIRE_EQUAL(buffer.back(), 'x');
+    }
+};
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// An expensive fixture, that counts how often it was created and destroyed.
+class Corpus {
+public:
+    Corpus() : entries(10000, std::string(64, 'x')) { ++createdCount; }
+    Corpus(const Corpus &) = delete;
+    Corpus(Corpus &&other) noexcept : entries{std::move(other.entries)} {}
+    ~Corpus() {
+        if (!entries.empty()) {
+            ++destroyedCount;
+        }
+    }
+    auto operator=(const Corpus &) -> Corpus & = delete;
+    auto operator=(Corpus &&) -> Corpus & = delete;
+
+public:
+    /// Load the corpus.
+    static auto load() -> Corpus { return Corpus{}; }
+
+public:
+    std::vector<std::string> entries; ///< The entries in the corpus.
+
+public:
+    inline static int createdCount = 0;   ///< The number of created corpus objects.
+    inline static int destroyedCount = 0; ///< The number of destroyed corpus objects.
+};
@@ -0,0 +1,23 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Corpus.hpp"
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+SHARED_FIXTURES(corpus)
+class SharedFixtureBTest final : public el::UnitTest {
+public:
+    void testCorpusIsCreatedOnce() {
+        const auto &corpus = sharedFixture("corpus", &Corpus::load);
+        REQUIRE_EQUAL(corpus.entries.size(), 10000U);
+        REQUIRE_EQUAL(Corpus::createdCount, 1);
+        REQUIRE_EQUAL(Corpus::destroyedCount, 0);
+    }
+
+    void testSameInstance() {
+        const auto &first = sharedFixture("corpus", &Corpus::load);
+        const auto &second = sharedFixture("corpus", &Corpus::load);
+        REQUIRE_EQUAL(&first, &second);
+    }
+};
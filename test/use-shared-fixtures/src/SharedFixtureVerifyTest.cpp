@@ -0,0 +1,40 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Corpus.hpp"
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <stdexcept>
+
+// Suites are sorted by name, so this suite runs after the suites that use the corpus.
+class SharedFixtureVerifyTest final : public el::UnitTest {
+public:
+    void testDestroyedAfterLastSuite() {
+        REQUIRE_EQUAL(Corpus::createdCount, 1);
+        REQUIRE_EQUAL(Corpus::destroyedCount, 1);
+    }
+
+    void testUndeclaredFixtureIsCreated() {
+        auto &value = sharedFixture("counter", []() -> int { return 42; });
+        REQUIRE_EQUAL(value, 42);
+    }
+
+    void testFactoryUsesOtherFixture() {
+        auto &sum = sharedFixture("sum", [this]() -> int {
+            return sharedFixture("part", []() -> int { return 20; }) + 1;
+        });
+        REQUIRE_EQUAL(sum, 21);
+    }
+
+    /// A factory, that requests the fixture it creates.
+    auto createSelf() -> int {
+        return sharedFixture("self", [this]() -> int { return createSelf(); });
+    }
+
+    void testFactoryRequestsItself() {
+        REQUIRE_THROWS_AS(std::logic_error, createSelf());
+        // The failed creation does not block the fixture.
+        REQUIRE_EQUAL(sharedFixture("self", []() -> int { return 7; }), 7);
+    }
+};
@@ -0,0 +1,43 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <array>
+
+/// Uses more stack than `REQUIRE_MAX_STACK()` allows, checks the stack outside of a dedicated stack, and
+/// overflows a 64 KiB stack. The overflow is reported as a crash of this test only, and the next test on a
+/// dedicated stack passes.
+SKIP_BY_DEFAULT()
+class StackSizeFailureTest final : public el::UnitTest {
+public:
+    /// Recurse with about one kilobyte of stack per call, and return the depth.
+    static auto recurse(const int depth) -> int {
+        std::array<volatile char, 1000> buffer{};
+        buffer[0] = 1;
+        if (depth == 0) {
+            return 0;
+        }
+        return recurse(depth - 1) + buffer[0];
+    }
+
+    STACK_SIZE(64k)
+    void testExceedMaximum() {
+        REQUIRE_EQUAL(recurse(20), 20);
+        REQUIRE_MAX_STACK(4'000);
+    }
+
+    void testNotOnDedicatedStack() {
+        REQUIRE_MAX_STACK(4'000);
+    }
+
+    STACK_SIZE(64k)
+    void testOverflow() {
+        REQUIRE_EQUAL(recurse(1'000), 1'000);
+    }
+
+    STACK_SIZE(64k)
+    void testAfterOverflow() {
+        REQUIRE_EQUAL(recurse(10), 10);
+    }
+};
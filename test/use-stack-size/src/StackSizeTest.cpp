@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <array>
+#include <stdexcept>
+
+STACK_SIZE(256k)
+class StackSizeTest final : public el::UnitTest {
+public:
+    /// Recurse with about one kilobyte of stack per call, and return the depth.
+    static auto recurse(const int depth) -> int {
+        std::array<volatile char, 1000> buffer{};
+        buffer[0] = 1;
+        if (depth == 0) {
+            return 0;
+        }
+        return recurse(depth - 1) + buffer[0];
+    }
+
+    void testShallowRecursion() {
+        REQUIRE_EQUAL(recurse(10), 10);
+        REQUIRE_MAX_STACK(64'000);
+    }
+
+    void testDeepRecursion() {
+        REQUIRE_EQUAL(recurse(100), 100);
+        REQUIRE_MAX_STACK(256'000);
+    }
+
+    void testExceptionsArePassedToTheTest() {
+        REQUIRE_THROWS_AS(std::runtime_error, throw std::runtime_error("error"));
+    }
+
+    STACK_SIZE(2M)
+    void testLargerStackForTest() {
+        REQUIRE_EQUAL(recurse(1'000), 1'000);
+        REQUIRE_MAX_STACK(2'000'000);
+    }
+};
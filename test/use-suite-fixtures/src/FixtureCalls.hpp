@@ -0,0 +1,20 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+/// The calls to the suite fixtures, recorded by the test classes.
+struct FixtureCalls {
+    inline static int setUpSuiteCount = 0;        ///< How often `SuiteFixtureTest::setUpSuite()` was called.
+    inline static int tearDownSuiteCount = 0;     ///< How often `SuiteFixtureTest::tearDownSuite()` was called.
+    inline static int setUpCount = 0;             ///< How often `SuiteFixtureTest::setUp()` was called.
+    inline static bool skippedSuiteSetUp = false; ///< If the set-up of the skipped suite was called.
+    inline static int destroyedCount = 0;         ///< How often a `SuiteFixtureTest` instance was destroyed.
+};
+
+/// A member that counts the destruction of the suite instance.
+struct DestructionCounter {
+    DestructionCounter() = default;
+    DestructionCounter(const DestructionCounter &) = delete;
+    ~DestructionCounter() { ++FixtureCalls::destroyedCount; }
+    auto operator=(const DestructionCounter &) -> DestructionCounter & = delete;
+};
@@ -0,0 +1,16 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <thread>
+
+/// A slow suite fixture with a failing test, to verify that the fixture time is reported after a failed run.
+SKIP_BY_DEFAULT()
+class SuiteFixtureFailureTest final : public el::UnitTest {
+public:
+    void setUpSuite() override { std::this_thread::sleep_for(std::chrono::milliseconds{5}); }
+
+    void testFails() { REQUIRE(false); }
+};
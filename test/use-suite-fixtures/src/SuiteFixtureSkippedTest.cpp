@@ -0,0 +1,14 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FixtureCalls.hpp"
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+SKIP_BY_DEFAULT()
+class SuiteFixtureSkippedTest final : public el::UnitTest {
+public:
+    void setUpSuite() override { FixtureCalls::skippedSuiteSetUp = true; }
+
+    void testNotRunByDefault() { REQUIRE(false); }
+};
@@ -0,0 +1,52 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FixtureCalls.hpp"
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <memory>
+#include <vector>
+
+class SuiteFixtureTest final : public el::UnitTest {
+public:
+    std::shared_ptr<std::vector<int>> expensiveIndex; ///< The fixture shared by all tests.
+    int testsRun{0};                                   ///< The number of tests that used this instance.
+    DestructionCounter destructionCounter;             ///< Counts the destruction of this instance.
+
+    void setUpSuite() override {
+        ++FixtureCalls::setUpSuiteCount;
+        REQUIRE_EQUAL(FixtureCalls::setUpCount, 0);
+        expensiveIndex = std::make_shared<std::vector<int>>(1000, 7);
+    }
+
+    void tearDownSuite() override {
+        ++FixtureCalls::tearDownSuiteCount;
+        REQUIRE(expensiveIndex != nullptr);
+        expensiveIndex.reset();
+    }
+
+    void setUp() override { ++FixtureCalls::setUpCount; }
+
+    void testFirstUse() {
+        REQUIRE_EQUAL(FixtureCalls::setUpSuiteCount, 1);
+        REQUIRE(expensiveIndex != nullptr);
+        REQUIRE_EQUAL(expensiveIndex->size(), 1000U);
+        ++testsRun;
+    }
+
+    void testSecondUse() {
+        REQUIRE_EQUAL(FixtureCalls::setUpSuiteCount, 1);
+        REQUIRE(expensiveIndex != nullptr);
+        REQUIRE_EQUAL(testsRun, 1);
+        ++testsRun;
+    }
+
+    void testNoTearDownBetweenTests() {
+        REQUIRE_EQUAL(FixtureCalls::setUpSuiteCount, 1);
+        REQUIRE_EQUAL(FixtureCalls::tearDownSuiteCount, 0);
+        REQUIRE_EQUAL(FixtureCalls::destroyedCount, 0);
+        REQUIRE_EQUAL(FixtureCalls::setUpCount, 3);
+        ++testsRun;
+    }
+};
@@ -0,0 +1,19 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FixtureCalls.hpp"
+
+#include <erbsland/unittest/UnitTest.hpp>
+
+// Suites are sorted by name, so this suite runs after `SuiteFixtureTest` and `SuiteFixtureSkippedTest`.
+class SuiteFixtureVerifyTest final : public el::UnitTest {
+public:
+    void testFixturesCalledOnce() {
+        REQUIRE_EQUAL(FixtureCalls::setUpSuiteCount, 1);
+        REQUIRE_EQUAL(FixtureCalls::tearDownSuiteCount, 1);
+    }
+
+    void testInstanceReleasedAfterLastTest() { REQUIRE_EQUAL(FixtureCalls::destroyedCount, 1); }
+
+    void testSkippedSuiteHasNoFixture() { REQUIRE_FALSE(FixtureCalls::skippedSuiteSetUp); }
+};
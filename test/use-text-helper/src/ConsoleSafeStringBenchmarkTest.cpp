@@ -0,0 +1,53 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/TextHelper.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace th = erbsland::unittest::th;
+
+/// Measures the speed of the console safe escaping.
+/// Run it explicitly with `unittest-text-helper name:ConsoleSafeStringBenchmarkTest`.
+SKIP_BY_DEFAULT()
+class ConsoleSafeStringBenchmarkTest final : public el::UnitTest {
+public:
+    static constexpr std::size_t cTextSize = 4 * 1024 * 1024;
+    static constexpr int cRepetitions = 3;
+
+    void measure(const std::string_view name, const std::string &text) {
+        std::size_t checksum = 0;
+        const auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < cRepetitions; ++i) {
+            checksum += th::toConsoleSafeString(text, text.size()).size();
+        }
+        const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime);
+        const auto megabytes = static_cast<double>(text.size() * cRepetitions) / (1024.0 * 1024.0);
+        consoleWriteLine(std::format(
+            "Escape benchmark: {}: {:.1f} MB/s (checksum {})", name, megabytes / duration.count(), checksum));
+    }
+
+    void testBenchmark() {
+        std::string asciiText;
+        std::string mixedText;
+        std::string binaryText;
+        asciiText.reserve(cTextSize);
+        mixedText.reserve(cTextSize);
+        binaryText.reserve(cTextSize);
+        while (asciiText.size() < cTextSize) {
+            asciiText += "a simple line of ASCII text, as it is found in most logs.\n";
+            mixedText += "\xC3\xA4rger mit \xE2\x82\xAC und \xF0\x9F\x98\x80 in a mixed text.\n";
+        }
+        for (std::size_t i = 0; i < cTextSize; ++i) {
+            binaryText.push_back(static_cast<char>((i * 7U) & 0xFFU));
+        }
+        measure("ascii", asciiText);
+        measure("mixed", mixedText);
+        measure("binary", binaryText);
+    }
+};
@@ -4,6 +4,13 @@
 #include <erbsland/unittest/TextHelper.hpp>
 #include <erbsland/unittest/UnitTest.hpp>
 
+#include <format>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace th = erbsland::unittest::th;
 
 class TextHelperTest final : public el::UnitTest {
@@ -56,6 +63,25 @@ public:
         REQUIRE_LESS_EQUAL(croppedString.size(), 40U);
     }
 
+    void testToConsoleSafeStringEscapes() {
+        REQUIRE_EQUAL(th::toConsoleSafeString("a b", 100U), "\"a b\"");
+        REQUIRE_EQUAL(th::toConsoleSafeString("\x7F\xF0\x9F\x98\x84", 100U), R"("\x7F\u{1F604}")");
+        // Invalid UTF-8 is escaped byte by byte.
+        REQUIRE_EQUAL(th::toConsoleSafeString("\xC0\x80\xE2\x82\xFF", 100U), R"("\xC0\x80\xE2\x82\xFF")");
+        REQUIRE_EQUAL(th::toConsoleSafeString("\xF0\x9F\x98", 100U), R"("\xF0\x9F\x98")");
+        // A character that starts before the limit is kept completely.
+        REQUIRE_EQUAL(th::toConsoleSafeString("ab\xC3\xA4" "cd", 3U), R"x("ab\u{00E4}(... +3 more)")x");
+        REQUIRE_EQUAL(th::toConsoleSafeString("abcd", 4U), "abcd");
+        // Large texts are escaped completely.
+        std::string largeText;
+        for (int i = 0; i < 100'000; ++i) {
+            largeText += "a\x01\xC3\xA4 ";
+        }
+        const auto largeSafeText = th::toConsoleSafeString(largeText, largeText.size());
+        REQUIRE_EQUAL(largeSafeText.size(), 100'000U * 14U + 2U);
+        REQUIRE_EQUAL(largeSafeText.substr(0, 16), R"("a\x01\u{00E4} a)");
+    }
+
     void testToStdString() {
         const auto expected = std::string("abc😄×↑");
         auto str = th::toStdString("abc😄×↑");
@@ -170,6 +196,117 @@ public:
         REQUIRE_EQUAL(u32Lines[1], U"beta");
     }
 
+    void testLineRange() {
+        auto lines = std::vector<std::string_view>{};
+        for (const auto line : th::lineRange("\nalpha\r\n\r\nbeta\rgamma\n")) {
+            lines.push_back(line);
+        }
+        REQUIRE_EQUAL(lines.size(), std::size_t{4});
+        REQUIRE(lines[0].empty());
+        REQUIRE_EQUAL(lines[1], "alpha");
+        REQUIRE(lines[2].empty());
+        REQUIRE_EQUAL(lines[3], "beta\rgamma");
+
+        REQUIRE(th::lineRange("").empty());
+        REQUIRE_EQUAL(std::ranges::distance(th::lineRange("")), 0);
+        REQUIRE_EQUAL(std::ranges::distance(th::lineRange("\n")), 1);
+        REQUIRE_EQUAL(std::ranges::distance(th::lineRange("\n\n")), 2);
+        REQUIRE_EQUAL(std::ranges::distance(th::lineRange("end\r")), 1);
+        REQUIRE_EQUAL(th::lineRange("end\r").front(), "end\r");
+        REQUIRE_EQUAL(th::lineRange(u"first\r\nsecond").front(), u"first");
+
+        // The views point into the original text.
+        const auto text = std::u32string{U"one\ntwo"};
+        const auto range = th::lineRange(text);
+        auto it = std::ranges::next(range.begin());
+        REQUIRE_EQUAL(*it, U"two");
+        REQUIRE_EQUAL((*it).data(), text.data() + 4);
+        REQUIRE(std::ranges::next(it) == range.end());
+
+        // The split functions use the same rules.
+        REQUIRE_EQUAL(th::splitLines("a\r\nb\r\n"), (std::vector<std::string>{"a", "b"}));
+    }
+
+    /// A simple recursive matcher, as reference for the wildcard patterns.
+    static auto referenceMatch(const std::string_view pattern, const std::string_view text) -> bool {
+        if (pattern.empty()) {
+            return text.empty();
+        }
+        if (pattern.size() >= 2 && pattern[0] == '\\' && (pattern[1] == '*' || pattern[1] == '?')) {
+            return !text.empty() && text.front() == pattern[1] && referenceMatch(pattern.substr(2), text.substr(1));
+        }
+        if (pattern.front() == '*') {
+            for (std::size_t i = 0; i <= text.size(); ++i) {
+                if (referenceMatch(pattern.substr(1), text.substr(i))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (text.empty() || (pattern.front() != '?' && pattern.front() != text.front())) {
+            return false;
+        }
+        return referenceMatch(pattern.substr(1), text.substr(1));
+    }
+
+    void testWildcardPattern() {
+        REQUIRE(th::matchesWildcardPattern("", ""));
+        REQUIRE(th::matchesWildcardPattern("*", ""));
+        REQUIRE(th::matchesWildcardPattern("**", "abc"));
+        REQUIRE_FALSE(th::matchesWildcardPattern("?", ""));
+        REQUIRE(th::matchesWildcardPattern("*id=*, ts=*", "event: id=42, ts=1700000000, ok"));
+        REQUIRE_FALSE(th::matchesWildcardPattern("*id=*, ts=*", "event: id=42; ts=1700000000"));
+        REQUIRE(th::matchesWildcardPattern("a*b?d*e", "axxbcdyye"));
+        REQUIRE_FALSE(th::matchesWildcardPattern("a*b?d*e", "axxbcdyy"));
+        // The first and last part must not overlap.
+        REQUIRE_FALSE(th::matchesWildcardPattern("ab*ba", "aba"));
+        REQUIRE(th::matchesWildcardPattern("ab*ba", "abba"));
+        // Escaped wildcards and backslashes.
+        REQUIRE(th::matchesWildcardPattern(R"(\*\?*)", "*?rest"));
+        REQUIRE_FALSE(th::matchesWildcardPattern(R"(\*\?*)", "ab-rest"));
+        REQUIRE(th::matchesWildcardPattern(R"(*\*?)", "a*b"));
+        REQUIRE_FALSE(th::matchesWildcardPattern(R"(*\*?)", "abc"));
+        REQUIRE(th::matchesWildcardPattern(R"(C:\dir\file-?.txt)", R"(C:\dir\file-1.txt)"));
+        REQUIRE(th::matchesWildcardPattern(R"(\\server\share\file-*.txt)", R"(\\server\share\file-1.txt)"));
+        REQUIRE_FALSE(th::matchesWildcardPattern(R"(\\server\share\file-*.txt)", R"(\server\share\file-1.txt)"));
+        REQUIRE(th::matchesWildcardPattern(R"(a\)", R"(a\)"));
+        // Parts, where the search must continue inside a partial match.
+        REQUIRE(th::matchesWildcardPattern("*aab*", "aaab"));
+        REQUIRE(th::matchesWildcardPattern("*abab?c*", "ababababxc"));
+        REQUIRE_FALSE(th::matchesWildcardPattern("*abab?c*", "abababab-d"));
+        REQUIRE(th::matchesWildcardPattern("*" + std::string(200, 'a') + "b*", std::string(300, 'a') + "b"));
+        // All string types.
+        REQUIRE(th::matchesWildcardPattern(u8"*→?*", u8"x→yz"));
+        REQUIRE(th::matchesWildcardPattern(u"*→?*", u"x→yz"));
+        REQUIRE(th::matchesWildcardPattern(U"*😀?*", U"x😀yz"));
+        REQUIRE(th::matchesWildcardPattern(L"*id=*", L"the id=5"));
+        REQUIRE_FALSE(th::matchesWildcardPattern(U"?", U"😀😀"));
+    }
+
+    void testWildcardPatternAgainstReference() {
+        constexpr std::string_view patternCharacters = "ab*?\\";
+        constexpr std::string_view textCharacters = "ab*\\";
+        auto &rng = random();
+        for (int i = 0; i < 20'000; ++i) {
+            std::string pattern;
+            std::string text;
+            const auto patternLength = rng.nextInRange(0, 10);
+            for (int j = 0; j < patternLength; ++j) {
+                pattern += patternCharacters[static_cast<std::size_t>(rng.nextInRange(0, 4))];
+            }
+            const auto textLength = rng.nextInRange(0, 12);
+            for (int j = 0; j < textLength; ++j) {
+                text += textCharacters[static_cast<std::size_t>(rng.nextInRange(0, 3))];
+            }
+            runWithContext(
+                SOURCE_LOCATION(),
+                [&]() -> void {
+                    REQUIRE_EQUAL(th::matchesWildcardPattern(pattern, text), referenceMatch(pattern, text));
+                },
+                [&]() -> std::string { return std::format("pattern = \"{}\", text = \"{}\"", pattern, text); });
+        }
+    }
+
     void testRequireEqualLines() {
         const auto expected = std::vector<std::string_view>{
             "hello one two three",
@@ -214,7 +351,15 @@ public:
         REQUIRE_EQUAL_LINES(actualStr, expectedStr);
     }
 
-    void testSideBySideComparison() {
+    void testEqualLinesWithLineRange() {
+        const auto actual = std::string{"first line\r\nsecond line: 42\r\nlast line\r\n"};
+        const auto expected = std::string_view{"first line\nsecond line: *\nlast line"};
+        REQUIRE_EQUAL_LINES(th::lineRange(actual), th::lineRange(expected));
+        REQUIRE_EQUAL_LINES(th::lineRange(actual), th::splitLines(expected));
+        REQUIRE_EQUAL_LINES(th::splitLineViews(actual), th::lineRange(expected));
+    }
+
+    void testLineDiff() {
         const auto expected = std::vector<std::string>{
             "one two three four five six",
             "another line",
@@ -224,14 +369,16 @@ public:
             "one two three four five six",
             "different",
         };
-        auto comparisonStr = th::impl::createSideBySideComparison(actual, expected);
+        auto comparisonStr = th::impl::createLineDiff(actual, expected);
         const auto expectedComparisonStr =
-            th::splitLines("| Actual (2)                  |     | Expected (3)                |\n"
-                           "|-----------------------------|-----|-----------------------------|\n"
-                           "| one two three four five six | === | one two three four five six |\n"
-                           "| different                   |  X  | another line                |\n"
-                           "|                             |  X  | last line                   |\n"
-                           "|-----------------------------|-----|-----------------------------|");
+            th::splitLines("Line diff (- expected, + actual): 2 lines removed, 1 line added.\n"
+                           "--- expected (3 lines)\n"
+                           "+++ actual (2 lines)\n"
+                           "@@ -1,3 +1,2 @@\n"
+                           "  one two three four five six\n"
+                           "- another line\n"
+                           "- last line\n"
+                           "+ different");
         const auto comparisonLines = th::splitLines(comparisonStr);
         REQUIRE_EQUAL(comparisonLines.size(), expectedComparisonStr.size());
         for (auto index = std::size_t{0}; index < comparisonLines.size(); ++index) {
@@ -239,4 +386,71 @@ public:
             REQUIRE_EQUAL(comparisonLines[index], expectedComparisonStr[index]);
         }
     }
+
+    void testLineDiffWithLineRange() {
+        const auto comparisonLines = th::splitLines(
+            th::impl::createLineDiff(th::lineRange("one\ntwo\nthree\n"), th::lineRange("one\nthree\n")));
+        const auto expectedComparisonLines = th::splitLines(
+            "Line diff (- expected, + actual): 0 lines removed, 1 line added.\n"
+            "--- expected (2 lines)\n"
+            "+++ actual (3 lines)\n"
+            "@@ -1,2 +1,3 @@\n"
+            "  one\n"
+            "+ two\n"
+            "  three\n");
+        REQUIRE_EQUAL(comparisonLines, expectedComparisonLines);
+    }
+
+    void testLineDiffWithInsertedLine() {
+        auto expected = std::vector<std::string>{};
+        for (std::size_t i = 0; i < 5'000; ++i) {
+            expected.push_back(std::format("line {}", i));
+        }
+        expected[4'000] = "line 4???";
+        auto actual = expected;
+        actual[4'000] = "line 4000";
+        actual.insert(actual.begin() + 10, "inserted line");
+        actual.erase(actual.begin() + 2'001);
+        const auto comparisonLines = th::splitLines(th::impl::createLineDiff(actual, expected));
+        const auto expectedComparisonStr =
+            th::splitLines("Line diff (- expected, + actual): 1 line removed, 1 line added.\n"
+                           "--- expected (5000 lines)\n"
+                           "+++ actual (5000 lines)\n"
+                           "@@ -8,6 +8,7 @@\n"
+                           "  line 7\n"
+                           "  line 8\n"
+                           "  line 9\n"
+                           "+ inserted line\n"
+                           "  line 10\n"
+                           "  line 11\n"
+                           "  line 12\n"
+                           "@@ -1998,7 +1999,6 @@\n"
+                           "  line 1997\n"
+                           "  line 1998\n"
+                           "  line 1999\n"
+                           "- line 2000\n"
+                           "  line 2001\n"
+                           "  line 2002\n"
+                           "  line 2003");
+        REQUIRE_EQUAL(comparisonLines.size(), expectedComparisonStr.size());
+        for (auto index = std::size_t{0}; index < comparisonLines.size(); ++index) {
+            WITH_CONTEXT(index);
+            REQUIRE_EQUAL(comparisonLines[index], expectedComparisonStr[index]);
+        }
+    }
+
+    void testLineDiffLimits() {
+        auto expected = std::vector<std::string>{};
+        auto actual = std::vector<std::string>{};
+        for (std::size_t i = 0; i < 5'000; ++i) {
+            expected.push_back(std::format("expected {}", i));
+            actual.push_back(std::format("actual {}", i));
+        }
+        const auto comparisonLines = th::splitLines(th::impl::createLineDiff(actual, expected));
+        REQUIRE_EQUAL(comparisonLines[1], "The lines differ too much for a line diff, they are compared line by line.");
+        REQUIRE_EQUAL(comparisonLines[5], "- expected 0");
+        REQUIRE_EQUAL(comparisonLines[6], "+ actual 0");
+        REQUIRE_EQUAL(comparisonLines.back(), "... the diff is truncated after 200 lines.");
+        REQUIRE_LESS(comparisonLines.size(), 210U);
+    }
 };
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/TextHelper.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <regex>
+#include <string>
+#include <string_view>
+
+namespace th = erbsland::unittest::th;
+
+/// Compares the wildcard patterns with regular expressions.
+/// Run it explicitly with `unittest-text-helper name:WildcardBenchmarkTest`.
+SKIP_BY_DEFAULT()
+class WildcardBenchmarkTest final : public el::UnitTest {
+public:
+    static constexpr int cRepetitions = 20;
+
+    template <typename Fn>
+    void measure(const std::string_view name, const std::string &line, Fn fn) {
+        std::size_t matches = 0;
+        const auto startTime = std::chrono::steady_clock::now();
+        for (int i = 0; i < cRepetitions; ++i) {
+            matches += fn(line) ? 1U : 0U;
+        }
+        const auto duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime);
+        consoleWriteLine(std::format("Wildcard benchmark: {} on {} characters: {:.1f} us per line ({} matches)",
+            name,
+            line.size(),
+            duration.count() / cRepetitions,
+            matches));
+    }
+
+    void testBenchmark() {
+        const std::string pattern = "*id=*, ts=*";
+        const std::regex expression{".*id=.*, ts=.*"};
+        for (const std::size_t size : {1'000U, 10'000U, 1'000'000U}) {
+            std::string line = "event: ";
+            while (line.size() < size) {
+                line += "key=value, ";
+            }
+            line += "id=42, ts=1700000000";
+            measure("wildcard", line, [&](const std::string &text) -> bool {
+                return th::matchesWildcardPattern(pattern, text);
+            });
+            if (size > 10'000U) {
+                continue; // The recursive matcher of `std::regex` overflows the stack on longer lines.
+            }
+            measure("std::regex", line, [&](const std::string &text) -> bool {
+                return std::regex_match(text, expression);
+            });
+        }
+    }
+
+    void testRepetitiveText() {
+        // Each position of the text starts a partial match of the part, that fails at its last character.
+        const auto pattern = std::format("*{}b*", std::string(1'000, 'a'));
+        for (const std::size_t size : {10'000U, 1'000'000U}) {
+            const auto line = std::string(size, 'a');
+            measure("repetitive", line, [&](const std::string &text) -> bool {
+                return th::matchesWildcardPattern(pattern, text);
+            });
+        }
+    }
+};
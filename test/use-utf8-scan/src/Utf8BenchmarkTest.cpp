@@ -0,0 +1,81 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/TextHelper.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <string_view>
+
+using el::unittest::th::impl::Utf8ScanMode;
+
+/// Compares the speed of the UTF-8 scan modes. Run it explicitly with `unittest-utf8-scan name:Utf8BenchmarkTest`.
+SKIP_BY_DEFAULT()
+class Utf8BenchmarkTest final : public el::UnitTest {
+public:
+    static constexpr std::size_t cTextSize = 16 * 1024 * 1024;
+    static constexpr int cRepetitions = 5;
+
+    static auto modeName(const Utf8ScanMode mode) -> std::string_view {
+        switch (mode) {
+        case Utf8ScanMode::Scalar:
+            return "scalar";
+        case Utf8ScanMode::Portable:
+            return "portable";
+        case Utf8ScanMode::Sse2:
+            return "sse2";
+        case Utf8ScanMode::Avx2:
+            return "avx2";
+        default:
+            return "unknown";
+        }
+    }
+
+    static auto createText(const std::string_view pattern) -> std::string {
+        std::string text;
+        text.reserve(cTextSize + pattern.size());
+        while (text.size() < cTextSize) {
+            text += pattern;
+        }
+        return text;
+    }
+
+    template <typename Fn>
+    void measure(const std::string_view name, const std::string_view textName, const std::string &text, Fn fn) {
+        for (const auto mode : {Utf8ScanMode::Scalar, Utf8ScanMode::Portable, Utf8ScanMode::Sse2, Utf8ScanMode::Avx2}) {
+            if (!el::unittest::th::impl::utf8IsScanModeSupported(mode)) {
+                continue;
+            }
+            std::size_t checksum = 0;
+            const auto startTime = std::chrono::steady_clock::now();
+            for (int i = 0; i < cRepetitions; ++i) {
+                checksum += fn(text, mode);
+            }
+            const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime);
+            const auto megabytes = static_cast<double>(text.size() * cRepetitions) / (1024.0 * 1024.0);
+            consoleWriteLine(std::format("Utf8 benchmark: {} {} {}: {:.1f} MB/s (checksum {})",
+                name,
+                textName,
+                modeName(mode),
+                megabytes / duration.count(),
+                checksum));
+        }
+    }
+
+    void measureText(const std::string_view textName, const std::string &text) {
+        measure("validate", textName, text, [](const std::string &input, const Utf8ScanMode mode) -> std::size_t {
+            return el::unittest::th::impl::utf8Validate(input, mode).byteIndex;
+        });
+        measure("count", textName, text, [](const std::string &input, const Utf8ScanMode mode) -> std::size_t {
+            return el::unittest::th::impl::utf8CharacterCount(input, mode);
+        });
+    }
+
+    void testBenchmark() {
+        measureText("ascii", createText("a simple line of ASCII text, as it is found in most logs.\n"));
+        measureText("mixed", createText("\xC3\xA4rger mit \xE2\x82\xAC und \xF0\x9F\x98\x80 in a mixed text.\n"));
+    }
+};
@@ -0,0 +1,205 @@
+// Copyright (c) 2026 Tobias Erbsland - https://erbsland.dev
+// SPDX-License-Identifier: Apache-2.0
+
+#include <erbsland/unittest/RandomGenerator.hpp>
+#include <erbsland/unittest/TextHelper.hpp>
+#include <erbsland/unittest/UnitTest.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using el::unittest::th::Utf8Error;
+using el::unittest::th::impl::Utf8ScanMode;
+
+class Utf8ScanTest final : public el::UnitTest {
+public:
+    std::vector<Utf8ScanMode> modes;
+
+    void setUp() override {
+        modes.clear();
+        for (const auto mode : {Utf8ScanMode::Portable, Utf8ScanMode::Sse2, Utf8ScanMode::Avx2}) {
+            if (el::unittest::th::impl::utf8IsScanModeSupported(mode)) {
+                modes.push_back(mode);
+            }
+        }
+    }
+
+    /// Test if all modes return the same results as the scalar implementation.
+    auto isEquivalent(const std::string &text) const -> bool {
+        const auto expected = el::unittest::th::impl::utf8Validate(text, Utf8ScanMode::Scalar);
+        const auto expectedCount = el::unittest::th::impl::utf8CharacterCount(text, Utf8ScanMode::Scalar);
+        for (const auto mode : modes) {
+            const auto result = el::unittest::th::impl::utf8Validate(text, mode);
+            if (result.error != expected.error || result.byteIndex != expected.byteIndex ||
+                el::unittest::th::impl::utf8CharacterCount(text, mode) != expectedCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void requireEquivalent(const std::string &text) {
+        runWithContext(SOURCE_LOCATION(), [&]() { REQUIRE(isEquivalent(text)); }, [&]() -> std::string {
+            std::string bytes;
+            for (const auto byte : text) {
+                bytes += std::format("{:02x} ", static_cast<std::uint8_t>(byte));
+            }
+            return std::format("text size = {}, bytes = {}", text.size(), bytes);
+        });
+    }
+
+    void requireError(const std::string &text, const std::optional<Utf8Error> error, const std::size_t byteIndex) {
+        const auto result = el::unittest::th::impl::utf8Validate(text, Utf8ScanMode::Scalar);
+        REQUIRE(result.error == error);
+        REQUIRE_EQUAL(result.byteIndex, byteIndex);
+        requireEquivalent(text);
+    }
+
+    void testBestMode() {
+        const auto bestMode = el::unittest::th::impl::utf8BestScanMode();
+        REQUIRE(el::unittest::th::impl::utf8IsScanModeSupported(bestMode));
+        REQUIRE(bestMode != Utf8ScanMode::Scalar);
+        REQUIRE(el::unittest::th::impl::utf8IsScanModeSupported(Utf8ScanMode::Scalar));
+        REQUIRE(el::unittest::th::impl::utf8IsScanModeSupported(Utf8ScanMode::Portable));
+    }
+
+    void testErrorClassification() {
+        const std::string padding(40, 'a');
+        requireError("", std::nullopt, 0);
+        requireError(padding + "\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80", std::nullopt, 0);
+        requireError(padding + "\x80", Utf8Error::UnexpectedContinuationByte, 40);
+        requireError(padding + "\xC1\x81", Utf8Error::Overlong2ByteSequence, 40);
+        requireError(padding + "\xF5\x80\x80\x80", Utf8Error::InvalidStartByte, 40);
+        requireError(padding + "\xC3", Utf8Error::Truncated2ByteSequence, 40);
+        requireError(padding + "\xE2\x82", Utf8Error::Truncated3ByteSequence, 40);
+        requireError(padding + "\xF0\x9F\x98", Utf8Error::Truncated4ByteSequence, 40);
+        requireError(padding + "\xC3" + padding, Utf8Error::InvalidContinuationByteIn2ByteSequence, 40);
+        requireError(padding + "\xE2\x82" + padding, Utf8Error::InvalidContinuationByteIn3ByteSequence, 40);
+        requireError(padding + "\xF0\x9F\x98" + padding, Utf8Error::InvalidContinuationByteIn4ByteSequence, 40);
+        requireError(padding + "\xE0\x80\x80", Utf8Error::Overlong3ByteSequence, 40);
+        requireError(padding + "\xF0\x80\x80\x80", Utf8Error::Overlong4ByteSequence, 40);
+        requireError(padding + "\xED\xA0\x80", Utf8Error::SurrogateCodePoint, 40);
+        requireError(padding + "\xF4\x90\x80\x80", Utf8Error::CodePointBeyondUnicodeRange, 40);
+        REQUIRE_EQUAL(el::unittest::th::impl::utf8ErrorText(Utf8Error::SurrogateCodePoint),
+            "UTF-8 sequence encodes a surrogate code point");
+    }
+
+    void testInvalidUtf8Generator() {
+        // The scanner reports the same classification that was used to generate the invalid sequence.
+        for (const auto error : el::unittest::th::allUtf8Errors) {
+            requireError(el::unittest::th::invalidUtf8(error, std::string(40, 'a'), std::nullopt), error, 40);
+        }
+    }
+
+    void testSequencesAcrossBlocks() {
+        // Valid and invalid sequences at every position around the block boundaries of all modes.
+        for (const std::string sequence : {"\xC3\xA4", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xC3", "\xE2\x82",
+                 "\xF0\x9F\x98", "\xED\xA0\x80", "\x80\x80"}) {
+            for (std::size_t position = 0; position < 70; ++position) {
+                auto text = std::string(position, 'x') + sequence + std::string(70, 'y');
+                requireEquivalent(text);
+                text.resize(position + sequence.size());
+                requireEquivalent(text);
+            }
+        }
+    }
+
+    void testAllTwoByteSequences() {
+        // Every combination of two bytes, in front, across and after the boundary at byte 32, which is a block
+        // boundary for all modes.
+        std::string text(64, 'a');
+        for (std::size_t position = 28; position < 36; ++position) {
+            for (unsigned first = 0; first < 0x100U; ++first) {
+                for (unsigned second = 0; second < 0x100U; ++second) {
+                    text[position] = static_cast<char>(first);
+                    text[position + 1] = static_cast<char>(second);
+                    if (!isEquivalent(text)) {
+                        requireEquivalent(text);
+                    }
+                }
+            }
+            text[position] = 'a';
+            text[position + 1] = 'a';
+        }
+    }
+
+    void testAllThreeByteSequences() {
+        // Every combination of three bytes that starts with the start byte of a 3-byte sequence, across a block
+        // boundary. All other start bytes are covered by the tests for two and four bytes.
+        std::string text(64, 'a');
+        constexpr std::size_t position = 30;
+        for (unsigned first = 0xE0U; first < 0xF0U; ++first) {
+            for (unsigned second = 0; second < 0x100U; ++second) {
+                for (unsigned third = 0; third < 0x100U; ++third) {
+                    text[position] = static_cast<char>(first);
+                    text[position + 1] = static_cast<char>(second);
+                    text[position + 2] = static_cast<char>(third);
+                    if (!isEquivalent(text)) {
+                        requireEquivalent(text);
+                    }
+                }
+            }
+        }
+    }
+
+    void testFourByteSequences() {
+        // Every start byte of a 4-byte sequence, with all second bytes and a selection of continuation bytes.
+        constexpr std::array<std::uint8_t, 7> tailBytes{0x00, 0x41, 0x7F, 0x80, 0x9F, 0xBF, 0xC0};
+        std::string text(64, 'a');
+        constexpr std::size_t position = 29;
+        for (unsigned first = 0xF0U; first < 0x100U; ++first) {
+            for (unsigned second = 0; second < 0x100U; ++second) {
+                for (const auto third : tailBytes) {
+                    for (const auto fourth : tailBytes) {
+                        text[position] = static_cast<char>(first);
+                        text[position + 1] = static_cast<char>(second);
+                        text[position + 2] = static_cast<char>(third);
+                        text[position + 3] = static_cast<char>(fourth);
+                        if (!isEquivalent(text)) {
+                            requireEquivalent(text);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testRandomTexts() {
+        // Random mixes of valid characters, with a few random bytes.
+        constexpr std::array<std::string_view, 6> pieces{"a", "text ", "\xC3\xA4", "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+            "\xEF\xBF\xBD"};
+        el::unittest::RandomGenerator rng{0x5574'6638};
+        for (int i = 0; i < 20'000; ++i) {
+            std::string text;
+            const auto length = static_cast<std::size_t>(rng.nextInRange(0, 300));
+            while (text.size() < length) {
+                text += pieces[static_cast<std::size_t>(rng.nextInRange(0, 5))];
+            }
+            const auto mutations = rng.nextInRange(0, 2);
+            for (int mutation = 0; mutation < mutations && !text.empty(); ++mutation) {
+                const auto index = static_cast<std::size_t>(rng.nextInRange(0, static_cast<int>(text.size()) - 1));
+                text[index] = static_cast<char>(rng.nextInRange(0, 255));
+            }
+            if (!isEquivalent(text)) {
+                requireEquivalent(text);
+            }
+        }
+    }
+
+    void testCharacterCount() {
+        std::string text;
+        for (int i = 0; i < 100; ++i) {
+            text += "a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80";
+        }
+        for (const auto mode : modes) {
+            REQUIRE_EQUAL(el::unittest::th::impl::utf8CharacterCount(text, mode), 400U);
+            REQUIRE_EQUAL(el::unittest::th::impl::utf8CharacterCount(text.substr(0, 37), mode), 16U);
+        }
+    }
+};